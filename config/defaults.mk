@@ -267,6 +267,9 @@ OPENMP_LIB =
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
+# Threads library, needed for std::thread
+THREADS_LIB = -lpthread
+
 # SUNDIALS library configuration
 # For sundials_nvecmpiplusx and nvecparallel remember to build with MPI_ENABLE=ON
 # and modify cmake variables for hypre for sundials
@@ -0,0 +1,546 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "amg.hpp"
+#include "gridfunc.hpp"
+#include "../linalg/solvers.hpp"
+
+#include <cmath>
+
+namespace mfem
+{
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A)
+{
+   SetOperator(A);
+}
+
+SmoothedAggregationAMG::~SmoothedAggregationAMG()
+{
+   Reset();
+   if (own_near_null)
+   {
+      for (int i = 0; i < near_null.Size(); i++) { delete near_null[i]; }
+   }
+}
+
+void SmoothedAggregationAMG::Reset()
+{
+   for (int i = 0; i < operators.Size(); i++)
+   {
+      if (ownedOperators[i]) { delete operators[i]; }
+      if (ownedSmoothers[i]) { delete smoothers[i]; }
+   }
+   for (int i = 0; i < prolongations.Size(); i++)
+   {
+      if (ownedProlongations[i]) { delete prolongations[i]; }
+   }
+   for (int i = 0; i < diags.Size(); i++) { delete diags[i]; }
+   operators.SetSize(0);
+   smoothers.SetSize(0);
+   ownedOperators.SetSize(0);
+   ownedSmoothers.SetSize(0);
+   prolongations.SetSize(0);
+   ownedProlongations.SetSize(0);
+   diags.SetSize(0);
+
+   // The work vectors depend on the level sizes, they are reallocated in the
+   // next call to Mult()
+   for (int i = 0; i < X.NumRows(); i++)
+   {
+      for (int j = 0; j < X.NumCols(); j++)
+      {
+         delete X(i, j);
+         delete Y(i, j);
+         delete R(i, j);
+         delete Z(i, j);
+      }
+   }
+   X.SetSize(0, 0);
+   Y.SetSize(0, 0);
+   R.SetSize(0, 0);
+   Z.SetSize(0, 0);
+}
+
+void SmoothedAggregationAMG::SetSystemsOptions(int dim, bool order_bynodes)
+{
+   MFEM_VERIFY(dim >= 1, "invalid number of functions: " << dim);
+   num_functions = dim;
+   ordering = order_bynodes ? Ordering::byNODES : Ordering::byVDIM;
+}
+
+void SmoothedAggregationAMG::SetNearNullSpace(const Array<Vector*> &vectors)
+{
+   if (own_near_null)
+   {
+      for (int i = 0; i < near_null.Size(); i++) { delete near_null[i]; }
+   }
+   vectors.Copy(near_null);
+   own_near_null = false;
+   elast_fes = nullptr;
+}
+
+// Rigid-body mode functions, used in SetElasticityOptions()
+static void func_rxy(const Vector &x, Vector &y)
+{
+   y = 0.0; y(0) = x(1); y(1) = -x(0);
+}
+static void func_ryz(const Vector &x, Vector &y)
+{
+   y = 0.0; y(1) = x(2); y(2) = -x(1);
+}
+static void func_rzx(const Vector &x, Vector &y)
+{
+   y = 0.0; y(2) = x(0); y(0) = -x(2);
+}
+
+void SmoothedAggregationAMG::RecomputeRBMs()
+{
+   const int dim = elast_fes->GetMesh()->Dimension();
+   MFEM_VERIFY(elast_fes->GetVDim() == dim, "the vector dimension of the "
+               "finite element space must be equal to the mesh dimension");
+
+   if (own_near_null)
+   {
+      for (int i = 0; i < near_null.Size(); i++) { delete near_null[i]; }
+   }
+   near_null.SetSize(0);
+   own_near_null = true;
+
+   GridFunction rbm(elast_fes);
+   auto append = [&](VectorCoefficient &coeff)
+   {
+      rbm.ProjectCoefficient(coeff);
+      Vector *v = new Vector(elast_fes->GetTrueVSize());
+      rbm.GetTrueDofs(*v);
+      near_null.Append(v);
+   };
+
+   // Translations
+   for (int d = 0; d < dim; d++)
+   {
+      Vector e(dim);
+      e = 0.0;
+      e(d) = 1.0;
+      VectorConstantCoefficient coeff(e);
+      append(coeff);
+   }
+   // Rotations
+   VectorFunctionCoefficient coeff_rxy(dim, func_rxy);
+   append(coeff_rxy);
+   if (dim == 3)
+   {
+      VectorFunctionCoefficient coeff_ryz(dim, func_ryz);
+      VectorFunctionCoefficient coeff_rzx(dim, func_rzx);
+      append(coeff_ryz);
+      append(coeff_rzx);
+   }
+}
+
+void SmoothedAggregationAMG::SetElasticityOptions(FiniteElementSpace *fespace)
+{
+   elast_fes = fespace;
+   SetSystemsOptions(fespace->GetMesh()->Dimension(),
+                     fespace->GetOrdering() == Ordering::byNODES);
+}
+
+int SmoothedAggregationAMG::Aggregate(const SparseMatrix &S,
+                                      Array<int> &aggregates) const
+{
+   // Greedy aggregation in three passes, see e.g. Vaněk, Mandel, Brezina,
+   // "Algebraic multigrid by smoothed aggregation for second and fourth order
+   // elliptic problems", Computing 56 (1996).
+   const int n = S.Height();
+   const int *I = S.GetI(), *J = S.GetJ();
+   aggregates.SetSize(n);
+   aggregates = -1;
+   int num_agg = 0;
+
+   // Pass 1: form aggregates from nodes whose strong neighborhood is not
+   // aggregated yet; isolated nodes are left out.
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] >= 0 || I[i] == I[i+1]) { continue; }
+      bool free = true;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (aggregates[J[k]] >= 0) { free = false; break; }
+      }
+      if (!free) { continue; }
+      aggregates[i] = num_agg;
+      for (int k = I[i]; k < I[i+1]; k++) { aggregates[J[k]] = num_agg; }
+      num_agg++;
+   }
+
+   // Pass 2: add the remaining nodes to a neighboring aggregate from pass 1.
+   Array<int> pass1(aggregates);
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] >= 0) { continue; }
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (pass1[J[k]] >= 0) { aggregates[i] = pass1[J[k]]; break; }
+      }
+   }
+
+   // Pass 3: aggregate the nodes that are still left together with their
+   // unaggregated neighbors.
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] >= 0 || I[i] == I[i+1]) { continue; }
+      aggregates[i] = num_agg;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (aggregates[J[k]] < 0) { aggregates[J[k]] = num_agg; }
+      }
+      num_agg++;
+   }
+   return num_agg;
+}
+
+SparseMatrix *SmoothedAggregationAMG::Coarsen(const SparseMatrix &A,
+                                              const Vector &diag, real_t rho,
+                                              const Array<int> &node,
+                                              int nnodes, const DenseMatrix &B,
+                                              Array<int> &cnode,
+                                              DenseMatrix &cB) const
+{
+   const int n = A.Height();
+   const int nb = B.Width();
+
+   // Strength of connection graph between the nodes, based on the Frobenius
+   // norms of the nodal blocks of A in the case of systems.
+   SparseMatrix *N = nullptr;
+   if (nnodes != n)
+   {
+      SparseMatrix A2(A);
+      real_t *a2 = A2.GetData();
+      for (int k = 0; k < A2.NumNonZeroElems(); k++) { a2[k] *= a2[k]; }
+      int *QI = Memory<int>(n + 1), *QJ = Memory<int>(n);
+      real_t *QV = Memory<real_t>(n);
+      for (int i = 0; i <= n; i++) { QI[i] = i; }
+      for (int i = 0; i < n; i++) { QJ[i] = node[i]; QV[i] = 1.0; }
+      SparseMatrix Q(QI, QJ, QV, n, nnodes);
+      N = RAP(Q, A2, Q);
+      real_t *nv = N->GetData();
+      for (int k = 0; k < N->NumNonZeroElems(); k++) { nv[k] = sqrt(nv[k]); }
+   }
+   const SparseMatrix &An = N ? *N : A;
+   const int *AI = An.GetI(), *AJ = An.GetJ();
+   const real_t *AV = An.GetData();
+   Vector ndiag;
+   An.GetDiag(ndiag);
+
+   Array<bool> strong(An.NumNonZeroElems());
+   const real_t theta = strength_threshold;
+   bool *s = strong.GetData();
+   const real_t *nd = ndiag.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nnodes; i++)
+   {
+      for (int k = AI[i]; k < AI[i+1]; k++)
+      {
+         const int j = AJ[k];
+         const real_t a = fabs(AV[k]);
+         s[k] = (j != i) && (a > 0.0) &&
+                (a >= theta*sqrt(fabs(nd[i]*nd[j])));
+      }
+   }
+   int *SI = Memory<int>(nnodes + 1);
+   SI[0] = 0;
+   for (int i = 0; i < nnodes; i++)
+   {
+      SI[i+1] = SI[i];
+      for (int k = AI[i]; k < AI[i+1]; k++) { SI[i+1] += s[k]; }
+   }
+   int *SJ = Memory<int>(SI[nnodes]);
+   real_t *SV = Memory<real_t>(SI[nnodes]);
+   for (int i = 0, l = 0; i < nnodes; i++)
+   {
+      for (int k = AI[i]; k < AI[i+1]; k++)
+      {
+         if (s[k]) { SJ[l] = AJ[k]; SV[l] = 1.0; l++; }
+      }
+   }
+   SparseMatrix S(SI, SJ, SV, nnodes, nnodes);
+   delete N;
+
+   Array<int> aggregates;
+   const int num_agg = Aggregate(S, aggregates);
+   if (num_agg == 0) { return nullptr; }
+
+   // Group the unknowns by aggregate
+   Array<int> agg_offsets(num_agg + 1), agg_dofs, local(n);
+   agg_offsets = 0;
+   for (int i = 0; i < n; i++)
+   {
+      const int a = aggregates[node[i]];
+      if (a >= 0) { agg_offsets[a+1]++; }
+   }
+   agg_offsets.PartialSum();
+   agg_dofs.SetSize(agg_offsets[num_agg]);
+   {
+      Array<int> fill(num_agg);
+      for (int a = 0; a < num_agg; a++) { fill[a] = agg_offsets[a]; }
+      for (int i = 0; i < n; i++)
+      {
+         const int a = aggregates[node[i]];
+         if (a < 0) { local[i] = -1; continue; }
+         local[i] = fill[a] - agg_offsets[a];
+         agg_dofs[fill[a]++] = i;
+      }
+   }
+
+   // Tentative prolongation: orthonormalize the near null-space restricted to
+   // each aggregate (modified Gram-Schmidt QR, dropping dependent columns).
+   Vector Qval(agg_offsets[num_agg]*nb), Rval(num_agg*nb*nb);
+   Array<int> rank(num_agg + 1);
+   real_t *qv = Qval.GetData(), *rv = Rval.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int a = 0; a < num_agg; a++)
+   {
+      const int off = agg_offsets[a], nd_a = agg_offsets[a+1] - off;
+      real_t *q = qv + off*nb;
+      DenseMatrix Ra(rv + a*nb*nb, nb, nb);
+      Ra = 0.0;
+      int r = 0;
+      for (int c = 0; c < nb; c++)
+      {
+         real_t *qc = q + r*nd_a;
+         real_t nrm0 = 0.0;
+         for (int l = 0; l < nd_a; l++)
+         {
+            qc[l] = B(agg_dofs[off + l], c);
+            nrm0 += qc[l]*qc[l];
+         }
+         for (int p = 0; p < r; p++)
+         {
+            const real_t *qp = q + p*nd_a;
+            real_t dot = 0.0;
+            for (int l = 0; l < nd_a; l++) { dot += qp[l]*qc[l]; }
+            for (int l = 0; l < nd_a; l++) { qc[l] -= dot*qp[l]; }
+            Ra(p, c) = dot;
+         }
+         real_t nrm = 0.0;
+         for (int l = 0; l < nd_a; l++) { nrm += qc[l]*qc[l]; }
+         nrm = sqrt(nrm);
+         if (nrm <= 1e-10*sqrt(nrm0) || nrm == 0.0) { continue; }
+         for (int l = 0; l < nd_a; l++) { qc[l] /= nrm; }
+         Ra(r, c) = nrm;
+         r++;
+      }
+      rank[a] = r;
+   }
+   {
+      // Exclusive prefix sum of the ranks: coarse unknown offsets
+      int sum = 0;
+      for (int a = 0; a < num_agg; a++)
+      {
+         const int r = rank[a];
+         rank[a] = sum;
+         sum += r;
+      }
+      rank[num_agg] = sum;
+   }
+   const int nc = rank[num_agg];
+   if (nc == 0) { return nullptr; }
+
+   cnode.SetSize(nc);
+   cB.SetSize(nc, nb);
+   for (int a = 0; a < num_agg; a++)
+   {
+      for (int p = rank[a]; p < rank[a+1]; p++)
+      {
+         cnode[p] = a;
+         for (int c = 0; c < nb; c++)
+         {
+            cB(p, c) = rv[a*nb*nb + (p - rank[a]) + c*nb];
+         }
+      }
+   }
+
+   int *PI = Memory<int>(n + 1);
+   PI[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      const int a = aggregates[node[i]];
+      PI[i+1] = PI[i] + ((a >= 0) ? rank[a+1] - rank[a] : 0);
+   }
+   int *PJ = Memory<int>(PI[n]);
+   real_t *PV = Memory<real_t>(PI[n]);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < n; i++)
+   {
+      const int a = aggregates[node[i]];
+      if (a < 0) { continue; }
+      const int nd_a = agg_offsets[a+1] - agg_offsets[a];
+      const real_t *q = qv + agg_offsets[a]*nb;
+      for (int p = 0; p < rank[a+1] - rank[a]; p++)
+      {
+         PJ[PI[i] + p] = rank[a] + p;
+         PV[PI[i] + p] = q[p*nd_a + local[i]];
+      }
+   }
+   SparseMatrix *P_tent = new SparseMatrix(PI, PJ, PV, n, nc);
+
+   if (jacobi_weight == 0.0) { return P_tent; }
+
+   // Smoothed prolongation: P = (I - omega D^{-1} A) P_tent
+   SparseMatrix DinvA(A);
+   Vector dinv(diag.Size());
+   for (int i = 0; i < n; i++) { dinv(i) = 1.0/diag(i); }
+   DinvA.ScaleRows(dinv);
+   SparseMatrix *DinvAP = mfem::Mult(DinvA, *P_tent);
+   SparseMatrix *P = Add(1.0, *P_tent, -jacobi_weight/rho, *DinvAP);
+   delete DinvAP;
+   delete P_tent;
+   return P;
+}
+
+Solver *SmoothedAggregationAMG::MakeSmoother(const SparseMatrix &A,
+                                             const Vector &diag, real_t rho)
+{
+   return new OperatorChebyshevSmoother(A, diag, no_ess_dofs, smoother_order,
+                                        rho);
+}
+
+// Estimate the spectral radius of D^{-1} A with a few power iterations
+static real_t EstimateDinvARadius(const SparseMatrix &A, const Vector &diag)
+{
+   SparseMatrix DinvA(A);
+   Vector dinv(diag.Size());
+   for (int i = 0; i < diag.Size(); i++) { dinv(i) = 1.0/diag(i); }
+   DinvA.ScaleRows(dinv);
+   PowerMethod power_method;
+   Vector ev(A.Width());
+   return power_method.EstimateLargestEigenvalue(DinvA, ev, 20, 1e-3);
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix*>(&op);
+   MFEM_VERIFY(A != NULL, "SmoothedAggregationAMG requires a SparseMatrix");
+   MFEM_VERIFY(A->Finalized(), "the SparseMatrix must be finalized");
+
+   Reset();
+   height = width = A->Height();
+   if (elast_fes) { RecomputeRBMs(); }
+
+   // Nodes and near null-space of the finest level
+   const int n = A->Height();
+   const int nf = num_functions;
+   MFEM_VERIFY(n % nf == 0, "the size of the matrix is not a multiple of the "
+               "number of functions");
+   int nnodes = n/nf;
+   Array<int> node(n);
+   for (int i = 0; i < n; i++)
+   {
+      node[i] = (ordering == Ordering::byVDIM) ? i/nf : i%nnodes;
+   }
+   DenseMatrix B;
+   if (near_null.Size() == 0)
+   {
+      B.SetSize(n, nf);
+      B = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         B(i, (ordering == Ordering::byVDIM) ? i%nf : i/nnodes) = 1.0;
+      }
+   }
+   else
+   {
+      B.SetSize(n, near_null.Size());
+      for (int c = 0; c < near_null.Size(); c++)
+      {
+         MFEM_VERIFY(near_null[c]->Size() == n, "invalid near null-space");
+         near_null[c]->HostRead();
+         for (int i = 0; i < n; i++) { B(i, c) = (*near_null[c])(i); }
+      }
+   }
+
+   // Coarsening, from the finest to the coarsest level
+   Array<SparseMatrix*> level_ops, level_P;
+   Array<Vector*> level_diags;
+   Array<real_t> level_rho;
+   level_ops.Append(const_cast<SparseMatrix*>(A));
+   while (level_ops.Size() < max_levels &&
+          level_ops.Last()->Height() > max_coarse_size)
+   {
+      const SparseMatrix &Af = *level_ops.Last();
+      Vector *diag = new Vector;
+      Af.GetDiag(*diag);
+      const real_t rho = EstimateDinvARadius(Af, *diag);
+
+      Array<int> cnode;
+      DenseMatrix cB;
+      SparseMatrix *P = Coarsen(Af, *diag, rho, node, nnodes, B, cnode, cB);
+      if (!P || P->Width() >= Af.Height())
+      {
+         delete P;
+         delete diag;
+         break;
+      }
+      level_diags.Append(diag);
+      level_rho.Append(rho);
+      level_P.Append(P);
+      level_ops.Append(RAP(*P, Af, *P));
+      nnodes = cnode.Size() ? cnode.Max() + 1 : 0;
+      cnode.Copy(node);
+      B = cB;
+   }
+
+   // Coarsest level: dense direct solver
+   const int num_levels = level_ops.Size();
+   level_ops.Last()->ToDenseMatrix(coarse_matrix);
+   AddLevel(level_ops.Last(), new DenseMatrixInverse(coarse_matrix),
+            num_levels > 1, true);
+   for (int l = num_levels - 2; l >= 0; l--)
+   {
+      diags.Append(level_diags[l]);
+      AddLevel(level_ops[l],
+               MakeSmoother(*level_ops[l], *level_diags[l], level_rho[l]),
+               l > 0, true);
+      prolongations.Append(level_P[l]);
+      ownedProlongations.Append(true);
+   }
+
+   if (print_level > 0)
+   {
+      mfem::out << "SmoothedAggregationAMG: " << num_levels << " levels\n";
+      for (int l = 0; l < num_levels; l++)
+      {
+         mfem::out << "   level " << l << ": size = " << level_ops[l]->Height()
+                   << ", nnz = " << level_ops[l]->NumNonZeroElems() << '\n';
+      }
+      mfem::out << "   operator complexity = " << GetOperatorComplexity()
+                << '\n';
+   }
+}
+
+real_t SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+   if (NumLevels() == 0) { return 0.0; }
+   real_t nnz = 0.0;
+   for (int l = 0; l < NumLevels(); l++)
+   {
+      nnz += static_cast<const SparseMatrix*>(operators[l])->NumNonZeroElems();
+   }
+   return nnz / static_cast<const SparseMatrix*>(operators.Last())
+          ->NumNonZeroElems();
+}
+
+} // namespace mfem
@@ -0,0 +1,165 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "multigrid.hpp"
+#include "../linalg/sparsemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Native smoothed aggregation algebraic multigrid (AMG) for serial
+    SparseMatrix operators.
+
+    The hierarchy is built from the given SparseMatrix with the classical
+    smoothed aggregation method of Vaněk, Mandel and Brezina: the nodes of the
+    strength-of-connection graph are grouped into aggregates, the near
+    null-space vectors are restricted to each aggregate and orthonormalized to
+    form the tentative prolongation, which is then improved by one step of
+    damped Jacobi smoothing. Coarse operators are computed as Galerkin products
+    P^t A P.
+
+    The multigrid cycle is provided by the Multigrid base class. By default, a
+    V-cycle with one pre- and post-smoothing step of a second order Chebyshev
+    smoother (based on the diagonal of each level) is used, and the coarsest
+    level is solved directly with a dense LU factorization. When OpenMP is
+    enabled, the strength of connection, the QR factorizations of the
+    aggregates and the tentative prolongation are computed in parallel; the
+    greedy aggregation itself is sequential.
+
+    By default, the constant vector is used as the near null-space. For systems
+    of PDEs, SetSystemsOptions() aggregates the unknowns of each node together,
+    and SetElasticityOptions() additionally uses the rigid body modes as near
+    null-space, which is necessary for good convergence in linear elasticity.
+    The operator is assumed to be symmetric positive definite, with essential
+    boundary conditions eliminated, e.g. by BilinearForm::FormLinearSystem(). */
+class SmoothedAggregationAMG : public Multigrid
+{
+protected:
+   /// Level data, level 0 is the coarsest level
+   Array<Vector*> diags;
+   Array<int> no_ess_dofs;
+   DenseMatrix coarse_matrix;
+
+   /// Near null-space on the finest level
+   Array<Vector*> near_null;
+   bool own_near_null = false;
+
+   /// Number of unknowns per node and their ordering on the finest level
+   int num_functions = 1;
+   Ordering::Type ordering = Ordering::byVDIM;
+
+   /// Finite element space for elasticity problems, see SetElasticityOptions()
+   FiniteElementSpace *elast_fes = nullptr;
+
+   real_t strength_threshold = 0.0;
+   real_t jacobi_weight = 4.0/3.0;
+   int max_levels = 10;
+   int max_coarse_size = 200;
+   int smoother_order = 2;
+   int print_level = 0;
+
+   /// Delete all levels of the hierarchy.
+   void Reset();
+
+   /// Recompute the rigid body modes, see SetElasticityOptions()
+   void RecomputeRBMs();
+
+   /** @brief Build the next coarser level.
+
+       @param[in] A       The fine level operator.
+       @param[in] diag    The diagonal of @a A.
+       @param[in] rho     Estimate of the spectral radius of D^{-1} A.
+       @param[in] node    Node index of each unknown of @a A.
+       @param[in] nnodes  Number of nodes.
+       @param[in] B       Near null-space on the fine level, stored as columns
+                          of a dense matrix.
+       @param[out] cnode  Node (aggregate) index of each coarse unknown.
+       @param[out] cB     Near null-space on the coarse level.
+       @return The smoothed prolongation, or NULL if no aggregates could be
+               formed. */
+   SparseMatrix *Coarsen(const SparseMatrix &A, const Vector &diag,
+                         real_t rho, const Array<int> &node, int nnodes,
+                         const DenseMatrix &B, Array<int> &cnode,
+                         DenseMatrix &cB) const;
+
+   /// Aggregate the nodes of the given strength graph, returns the number of
+   /// aggregates. Nodes without strong connections are not aggregated and get
+   /// aggregate index -1.
+   int Aggregate(const SparseMatrix &S, Array<int> &aggregates) const;
+
+   /// Construct the Chebyshev smoother for the level operator @a A with
+   /// diagonal @a diag and spectral radius estimate @a rho of D^{-1} A.
+   Solver *MakeSmoother(const SparseMatrix &A, const Vector &diag, real_t rho);
+
+public:
+   /// Construct an empty solver, the hierarchy is built in SetOperator().
+   SmoothedAggregationAMG() = default;
+
+   /// Construct the AMG hierarchy for the SparseMatrix @a A.
+   SmoothedAggregationAMG(const SparseMatrix &A);
+
+   /** @brief Build the AMG hierarchy for @a op, which must be a SparseMatrix.
+
+       The options of the solver (near null-space, thresholds, etc.) must be set
+       before calling this method. */
+   void SetOperator(const Operator &op) override;
+
+   /** @brief Aggregate the @a dim unknowns of each node together. The unknowns
+       are ordered according to @a order_bynodes, similar to
+       HypreBoomerAMG::SetSystemsOptions(). */
+   void SetSystemsOptions(int dim, bool order_bynodes = false);
+
+   /** @brief Use the rigid body modes of the vector finite element space
+       @a fespace as near null-space, see also SetSystemsOptions().
+
+       The finite element space must be a nodal vector space (e.g. H1) with
+       vector dimension equal to the mesh dimension. */
+   void SetElasticityOptions(FiniteElementSpace *fespace);
+
+   /** @brief Set the near null-space vectors on the finest level. The vectors
+       are not copied and must remain valid until the next call to
+       SetOperator(). */
+   void SetNearNullSpace(const Array<Vector*> &vectors);
+
+   /** @brief Set the threshold theta in the strength of connection criterion
+       |a_ij| >= theta sqrt(|a_ii a_jj|), default is 0. */
+   void SetStrengthThreshold(real_t theta) { strength_threshold = theta; }
+
+   /** @brief Set the weight (relative to the inverse spectral radius of
+       D^{-1} A) of the Jacobi smoothing of the prolongation, default is 4/3. If
+       set to zero, unsmoothed (plain) aggregation is used. */
+   void SetProlongationSmoothingWeight(real_t w) { jacobi_weight = w; }
+
+   /// Set the maximum number of levels, default is 10.
+   void SetMaxLevels(int levels) { max_levels = levels; }
+
+   /// Set the maximum size of the coarsest level, default is 200.
+   void SetMaxCoarseSize(int size) { max_coarse_size = size; }
+
+   /// Set the order of the Chebyshev smoother, default is 2.
+   void SetSmootherOrder(int order) { smoother_order = order; }
+
+   /// Print a summary of the hierarchy during the setup when @a level > 0.
+   void SetPrintLevel(int level) { print_level = level; }
+
+   /// Return the operator complexity, i.e. the total number of nonzeros in all
+   /// levels divided by the number of nonzeros on the finest level.
+   real_t GetOperatorComplexity() const;
+
+   virtual ~SmoothedAggregationAMG();
+};
+
+} // namespace mfem
+
+#endif
@@ -17,6 +17,8 @@
 #include "picojson.h"
 
 #include <cerrno>      // errno
+#include <climits>
+#include <fstream>
 #include <sstream>
 #include <regex>
 
@@ -111,6 +113,10 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    pad_digits_cycle = pad_digits_rank = pad_digits_default;
    format = SERIAL_FORMAT; // use serial mesh format
    compression = 0;
+   num_io_files = 1;
+   async_save = false;
+   num_save_jobs = 0;
+   save_error = No_Error;
    error = No_Error;
 }
 
@@ -159,6 +165,7 @@ void DataCollection::SetFormat(int fmt)
 #ifdef MFEM_USE_MPI
       case PARALLEL_FORMAT: break;
 #endif
+      case BINARY_FORMAT: break;
       default: MFEM_ABORT("unknown format: " << fmt);
    }
    format = fmt;
@@ -172,6 +179,12 @@ void DataCollection::SetCompression(bool comp)
 #endif
 }
 
+void DataCollection::SetNumIOFiles(int nfiles)
+{
+   MFEM_VERIFY(nfiles > 0, "invalid number of files: " << nfiles);
+   num_io_files = nfiles;
+}
+
 void DataCollection::SetPrefixPath(const std::string& prefix)
 {
    if (!prefix.empty())
@@ -195,6 +208,12 @@ void DataCollection::Load(int cycle_)
 
 void DataCollection::Save()
 {
+   if (async_save)
+   {
+      SaveAsync();
+      return;
+   }
+
    SaveMesh();
 
    if (error) { return; }
@@ -212,22 +231,49 @@ void DataCollection::Save()
    }
 }
 
-void DataCollection::SaveMesh()
+bool DataCollection::CreateSaveDirectory()
 {
-   std::string dir_name = prefix_path + name;
-   if (cycle != -1)
-   {
-      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
-   }
+   std::string dir_name = GetDirectoryName();
    int error_code = create_directory(dir_name, mesh, myid);
    if (error_code)
    {
       error = WRITE_ERROR;
       MFEM_WARNING("Error creating directory: " << dir_name);
+      return false;
+   }
+   return true;
+}
+
+void DataCollection::SaveMesh()
+{
+   WaitSave();
+   if (!CreateSaveDirectory())
+   {
       return; // do not even try to write the mesh
    }
 
    std::string mesh_name = GetMeshFileName();
+#ifdef MFEM_USE_MPI
+   const ParMesh *pbmesh = dynamic_cast<const ParMesh*>(mesh);
+   if (pbmesh && format == BINARY_FORMAT)
+   {
+      // collective, writes a single file for all ranks
+      pbmesh->SaveBinary(mesh_name);
+      return;
+   }
+#endif
+   if (format == BINARY_FORMAT)
+   {
+      std::ofstream mesh_file(mesh_name, std::ios::binary);
+      mesh->PrintBinary(mesh_file);
+      if (!mesh_file)
+      {
+         error = WRITE_ERROR;
+         MFEM_WARNING("Error writing mesh to file: " << mesh_name);
+      }
+      return;
+   }
+
    mfem::ofgzstream mesh_file(mesh_name, compression);
    mesh_file.precision(precision);
 #ifdef MFEM_USE_MPI
@@ -248,6 +294,16 @@ void DataCollection::SaveMesh()
    }
 }
 
+std::string DataCollection::GetDirectoryName() const
+{
+   std::string dir_name = prefix_path + name;
+   if (cycle != -1)
+   {
+      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+   }
+   return dir_name;
+}
+
 std::string DataCollection::GetMeshShortFileName() const
 {
    return (serial || format == SERIAL_FORMAT) ? "mesh" : "pmesh";
@@ -255,27 +311,205 @@ std::string DataCollection::GetMeshShortFileName() const
 
 std::string DataCollection::GetMeshFileName() const
 {
+   if (format == BINARY_FORMAT && !serial)
+   {
+      // ParMesh::SaveBinary() writes a single file for all ranks
+      return GetDirectoryName() + "/" + GetMeshShortFileName();
+   }
    return GetFieldFileName(GetMeshShortFileName());
 }
 
 std::string DataCollection::GetFieldFileName(const std::string &field_name)
 const
 {
-   std::string dir_name = prefix_path + name;
-   if (cycle != -1)
+   std::string file_name = GetDirectoryName() + "/" + field_name;
+   if (appendRankToFileName || IsAggregated())
    {
-      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+      file_name += "." + to_padded_string(GetFileIndex(), pad_digits_rank);
    }
-   std::string file_name = dir_name + "/" + field_name;
-   if (appendRankToFileName)
+   return file_name;
+}
+
+bool DataCollection::IsAggregated() const
+{
+#ifdef MFEM_USE_MPI
+   return (format == BINARY_FORMAT && m_comm != MPI_COMM_NULL &&
+           num_procs > 1);
+#else
+   return false;
+#endif
+}
+
+int DataCollection::GetFileIndex() const
+{
+   if (!IsAggregated()) { return myid; }
+   // groups of consecutive ranks, of sizes differing by at most one
+   const int nfiles = std::min(num_io_files, num_procs);
+   return int(int64_t(myid)*nfiles / num_procs);
+}
+
+bool DataCollection::WriteBinaryFile(const std::string &fname,
+                                     const std::string &data)
+{
+   if (!IsAggregated())
    {
-      file_name += "." + to_padded_string(myid, pad_digits_rank);
+      std::ofstream file(fname, std::ios::binary);
+      file.write(data.data(), data.size());
+      return bool(file);
    }
-   return file_name;
+#ifdef MFEM_USE_MPI
+   MPI_Comm io_comm;
+   MPI_Comm_split(m_comm, GetFileIndex(), myid, &io_comm);
+   // funnel the collective writes through a single aggregator per file
+   const bool ok = WriteParallelBinaryFile(io_comm, fname,
+                                           "MFEM binary parallel field v1.0\n",
+                                           data, 1);
+   MPI_Comm_free(&io_comm);
+   return ok;
+#else
+   return false;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+bool DataCollection::WriteParallelBinaryFile(MPI_Comm comm,
+                                             const std::string &fname,
+                                             const std::string &tag,
+                                             const std::string &data,
+                                             int num_aggregators)
+{
+   MFEM_VERIFY(data.size() <= INT_MAX, "the binary data is too large");
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   // header: tag, byte order, number of ranks, offsets of all parts
+   const size_t align = bin_io::array_alignment;
+   const size_t hdr_size = (tag.size() + align - 1) / align * align +
+                           (nranks + 3)*sizeof(int64_t);
+
+   int64_t part_size = data.size(), part_offset = 0;
+   MPI_Exscan(&part_size, &part_offset, 1, MPI_INT64_T, MPI_SUM, comm);
+   if (rank == 0) { part_offset = 0; }
+   part_offset += hdr_size;
+   std::vector<int64_t> hdr(rank == 0 ? nranks + 3 : 1);
+   const int64_t part_end = part_offset + part_size;
+   MPI_Gather(&part_end, 1, MPI_INT64_T, rank == 0 ? hdr.data() + 3 : NULL,
+              1, MPI_INT64_T, 0, comm);
+
+   MPI_Info info = MPI_INFO_NULL;
+   if (num_aggregators > 0)
+   {
+      const std::string cb_nodes = to_string(num_aggregators);
+      MPI_Info_create(&info);
+      MPI_Info_set(info, const_cast<char*>("cb_nodes"),
+                   const_cast<char*>(cb_nodes.c_str()));
+      MPI_Info_set(info, const_cast<char*>("romio_cb_write"),
+                   const_cast<char*>("enable"));
+   }
+   MPI_File fh;
+   int err = MPI_File_open(comm, fname.c_str(),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY, info, &fh);
+   if (info != MPI_INFO_NULL) { MPI_Info_free(&info); }
+   if (err == MPI_SUCCESS)
+   {
+      MPI_File_set_size(fh, 0);
+      if (rank == 0)
+      {
+         hdr[0] = 0x0102030405060708;
+         hdr[1] = nranks;
+         hdr[2] = hdr_size;
+         std::vector<char> hdr_buf(tag.begin(), tag.end());
+         bin_io::AppendArray(hdr_buf, hdr.data(), hdr.size());
+         MFEM_ASSERT(hdr_buf.size() == hdr_size, "internal error");
+         err = MPI_File_write_at(fh, 0, hdr_buf.data(), int(hdr_buf.size()),
+                                 MPI_BYTE, MPI_STATUS_IGNORE);
+      }
+      const int err_part =
+         MPI_File_write_at_all(fh, part_offset, const_cast<char*>(data.data()),
+                               int(data.size()), MPI_BYTE, MPI_STATUS_IGNORE);
+      if (err == MPI_SUCCESS) { err = err_part; }
+      MPI_File_close(&fh);
+   }
+   return err == MPI_SUCCESS;
+}
+#endif
+
+bool DataCollection::ReadBinaryFile(const std::string &fname,
+                                    std::string &data)
+{
+   if (!IsAggregated())
+   {
+      std::ifstream file(fname, std::ios::binary);
+      std::stringstream buffer;
+      buffer << file.rdbuf();
+      data = buffer.str();
+      return bool(file);
+   }
+#ifdef MFEM_USE_MPI
+   MPI_Comm io_comm;
+   MPI_Comm_split(m_comm, GetFileIndex(), myid, &io_comm);
+   int io_rank, io_size;
+   MPI_Comm_rank(io_comm, &io_rank);
+   MPI_Comm_size(io_comm, &io_size);
+
+   MPI_File fh;
+   int ok = (MPI_File_open(io_comm, fname.c_str(), MPI_MODE_RDONLY,
+                           MPI_INFO_NULL, &fh) == MPI_SUCCESS);
+   if (!ok)
+   {
+      MPI_Comm_free(&io_comm);
+      return false;
+   }
+
+   const std::string tag = "MFEM binary parallel field v1.0\n";
+   const size_t align = bin_io::array_alignment;
+   const size_t tag_size = (tag.size() + align - 1) / align * align;
+   std::vector<char> tag_buf(tag_size);
+   int64_t hdr[2] = {0, 0}, part[2] = {0, 0};
+   ok = (MPI_File_read_at(fh, 0, tag_buf.data(), int(tag_size), MPI_BYTE,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+         MPI_File_read_at(fh, tag_size, hdr, 2, MPI_INT64_T,
+                          MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+         std::string(tag_buf.data(), tag.size()) == tag &&
+         hdr[0] == 0x0102030405060708 && hdr[1] == io_size);
+   if (ok)
+   {
+      ok = (MPI_File_read_at(fh, tag_size + (io_rank + 2)*sizeof(int64_t),
+                             part, 2, MPI_INT64_T, MPI_STATUS_IGNORE)
+            == MPI_SUCCESS && part[0] <= part[1] &&
+            part[1] - part[0] <= INT_MAX);
+   }
+   // all ranks in the group have to take part in the collective read
+   MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, io_comm);
+   if (ok)
+   {
+      data.resize(part[1] - part[0]);
+      ok = (MPI_File_read_at_all(fh, part[0], &data[0], int(data.size()),
+                                 MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS);
+   }
+   MPI_File_close(&fh);
+   MPI_Comm_free(&io_comm);
+   return ok;
+#else
+   return false;
+#endif
 }
 
 void DataCollection::SaveOneField(const FieldMapIterator &it)
 {
+   if (format == BINARY_FORMAT)
+   {
+      std::ostringstream field_data;
+      (it->second)->SaveBinary(field_data, compression ? -1 : 0);
+      if (!WriteBinaryFile(GetFieldFileName(it->first), field_data.str()))
+      {
+         error = WRITE_ERROR;
+         MFEM_WARNING("Error writing field to file: " << it->first);
+      }
+      return;
+   }
+
    mfem::ofgzstream field_file(GetFieldFileName(it->first), compression);
 
    field_file.precision(precision);
@@ -289,6 +523,18 @@ void DataCollection::SaveOneField(const FieldMapIterator &it)
 
 void DataCollection::SaveOneQField(const QFieldMapIterator &it)
 {
+   if (format == BINARY_FORMAT)
+   {
+      std::ostringstream q_field_data;
+      (it->second)->SaveBinary(q_field_data, compression ? -1 : 0);
+      if (!WriteBinaryFile(GetFieldFileName(it->first), q_field_data.str()))
+      {
+         error = WRITE_ERROR;
+         MFEM_WARNING("Error writing q-field to file: " << it->first);
+      }
+      return;
+   }
+
    mfem::ofgzstream q_field_file(GetFieldFileName(it->first), compression);
 
    q_field_file.precision(precision);
@@ -302,6 +548,7 @@ void DataCollection::SaveOneQField(const QFieldMapIterator &it)
 
 void DataCollection::SaveField(const std::string &field_name)
 {
+   WaitSave();
    FieldMapIterator it = field_map.find(field_name);
    if (it != field_map.end())
    {
@@ -311,6 +558,7 @@ void DataCollection::SaveField(const std::string &field_name)
 
 void DataCollection::SaveQField(const std::string &q_field_name)
 {
+   WaitSave();
    QFieldMapIterator it = q_field_map.find(q_field_name);
    if (it != q_field_map.end())
    {
@@ -318,6 +566,192 @@ void DataCollection::SaveQField(const std::string &q_field_name)
    }
 }
 
+DataCollection::SaveJob &DataCollection::NewSaveJob(
+   const std::string &file_name, const std::string &what)
+{
+   if (num_save_jobs == int(save_jobs.size())) { save_jobs.emplace_back(); }
+   SaveJob &job = save_jobs[num_save_jobs++];
+   job.file_name = file_name;
+   job.what = what;
+   job.binary = (format == BINARY_FORMAT);
+   job.compression = compression;
+   job.precision = precision;
+   job.header.clear();
+   job.values.clear();
+   job.width = 0;
+#ifdef MFEM_USE_MPI
+   job.comm = MPI_COMM_NULL;
+   job.num_aggregators = 0;
+#endif
+   return job;
+}
+
+void DataCollection::SaveAsync()
+{
+   // back-pressure: wait for the previous save to complete
+   WaitSave();
+   if (!CreateSaveDirectory()) { return; }
+   num_save_jobs = 0;
+
+   // Serialize the mesh in memory
+   {
+      SaveJob &job = NewSaveJob(GetMeshFileName(), "mesh");
+      std::ostringstream os;
+      os.precision(precision);
+#ifdef MFEM_USE_MPI
+      const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
+      if (pmesh && format == BINARY_FORMAT)
+      {
+         pmesh->ParPrintBinary(os);
+         MPI_Comm comm;
+         MPI_Comm_dup(pmesh->GetComm(), &comm);
+         save_comms.push_back(comm);
+         job.comm = comm;
+         job.tag = "MFEM binary parallel mesh v1.0\n";
+      }
+      else if (pmesh && format == PARALLEL_FORMAT)
+      {
+         pmesh->ParPrint(os);
+      }
+      else
+#endif
+      {
+         if (format == BINARY_FORMAT) { mesh->PrintBinary(os); }
+         else { mesh->Print(os); }
+      }
+      job.header = os.str();
+   }
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm io_comm = MPI_COMM_NULL;
+   if (IsAggregated())
+   {
+      MPI_Comm_split(m_comm, GetFileIndex(), myid, &io_comm);
+      save_comms.push_back(io_comm);
+   }
+   if (!save_comms.empty())
+   {
+      int provided;
+      MPI_Query_thread(&provided);
+      MFEM_VERIFY(provided == MPI_THREAD_MULTIPLE, "asynchronous parallel "
+                  "binary output requires MPI_THREAD_MULTIPLE");
+   }
+#endif
+
+   // Stage the field values on the host, the formatting is done by the thread
+   for (FieldMapIterator it = field_map.begin(); it != field_map.end(); ++it)
+   {
+      const GridFunction &gf = *it->second;
+      SaveJob &job = NewSaveJob(GetFieldFileName(it->first),
+                                "field: " + it->first);
+      std::ostringstream os;
+      gf.FESpace()->Save(os);
+      os << '\n';
+      job.header = os.str();
+      const real_t *values = gf.HostRead();
+      job.values.assign(values, values + gf.Size());
+#ifdef MFEM_USE_MPI
+      // see ParGridFunction::Save()
+      const ParGridFunction *pgf = dynamic_cast<const ParGridFunction*>(&gf);
+      if (pgf)
+      {
+         for (int i = 0; i < gf.Size(); i++)
+         {
+            if (pgf->ParFESpace()->GetDofSign(i) < 0)
+            {
+               job.values[i] = -job.values[i];
+            }
+         }
+      }
+      job.comm = io_comm;
+      job.tag = "MFEM binary parallel field v1.0\n";
+      job.num_aggregators = 1;
+#endif
+      job.width = (gf.FESpace()->GetOrdering() == Ordering::byNODES) ?
+                  1 : gf.FESpace()->GetVDim();
+   }
+   for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
+        ++it)
+   {
+      const QuadratureFunction &qf = *it->second;
+      SaveJob &job = NewSaveJob(GetFieldFileName(it->first),
+                                "q-field: " + it->first);
+      std::ostringstream os;
+      qf.GetSpace()->Save(os);
+      os << "VDim: " << qf.GetVDim() << '\n'
+         << '\n';
+      job.header = os.str();
+      const real_t *values = qf.HostRead();
+      job.values.assign(values, values + qf.Size());
+#ifdef MFEM_USE_MPI
+      job.comm = io_comm;
+      job.tag = "MFEM binary parallel field v1.0\n";
+      job.num_aggregators = 1;
+#endif
+      job.width = qf.GetVDim();
+   }
+
+   save_error = No_Error;
+   save_thread = std::thread([this]()
+   {
+      for (int i = 0; i < num_save_jobs; i++)
+      {
+         if (!WriteSaveJob(save_jobs[i]))
+         {
+            save_error = WRITE_ERROR;
+            MFEM_WARNING("Error writing " << save_jobs[i].what << " to file: "
+                         << save_jobs[i].file_name);
+         }
+      }
+   });
+}
+
+bool DataCollection::WriteSaveJob(const SaveJob &job)
+{
+   Vector values(const_cast<real_t*>(job.values.data()),
+                 int(job.values.size()));
+   if (job.binary)
+   {
+      std::string data;
+      if (job.width > 0)
+      {
+         std::ostringstream os;
+         os << job.header;
+         values.PrintBinary(os, job.compression ? -1 : 0);
+         data = os.str();
+      }
+      const std::string &buf = (job.width > 0) ? data : job.header;
+#ifdef MFEM_USE_MPI
+      if (job.comm != MPI_COMM_NULL)
+      {
+         return WriteParallelBinaryFile(job.comm, job.file_name, job.tag, buf,
+                                        job.num_aggregators);
+      }
+#endif
+      std::ofstream file(job.file_name, std::ios::binary);
+      file.write(buf.data(), buf.size());
+      return bool(file);
+   }
+
+   mfem::ofgzstream file(job.file_name, job.compression);
+   file.precision(job.precision);
+   file << job.header;
+   if (job.width > 0) { values.Print(file, job.width); }
+   file.flush();
+   return bool(file);
+}
+
+void DataCollection::WaitSave()
+{
+   if (!save_thread.joinable()) { return; }
+   save_thread.join();
+   if (save_error) { error = save_error; }
+#ifdef MFEM_USE_MPI
+   for (MPI_Comm &comm : save_comms) { MPI_Comm_free(&comm); }
+   save_comms.clear();
+#endif
+}
+
 void DataCollection::DeleteData()
 {
    if (own_data) { delete mesh; }
@@ -337,6 +771,7 @@ void DataCollection::DeleteAll()
 
 DataCollection::~DataCollection()
 {
+   WaitSave();
    DeleteData();
 }
 
@@ -500,7 +935,7 @@ void VisItDataCollection::Load(int cycle_)
                            to_padded_string(cycle, pad_digits_cycle) +
                            ".mfem_root";
    LoadVisItRootFile(root_name);
-   if (format != SERIAL_FORMAT || num_procs > 1)
+   if (format == PARALLEL_FORMAT || num_procs > 1)
    {
 #ifndef MFEM_USE_MPI
       MFEM_WARNING("Cannot load parallel VisIt root file in serial.");
@@ -565,7 +1000,40 @@ void VisItDataCollection::LoadMesh()
 {
    // GetMeshFileName() uses 'serial', so we need to set it in advance.
    serial = (format == SERIAL_FORMAT);
+   if (format == BINARY_FORMAT)
+   {
+      // the binary mesh is a ParMesh iff the collection has a communicator
+#ifdef MFEM_USE_MPI
+      serial = (m_comm == MPI_COMM_NULL);
+#else
+      serial = true;
+#endif
+   }
    std::string mesh_fname = GetMeshFileName();
+   if (format == BINARY_FORMAT)
+   {
+      if (!std::ifstream(mesh_fname))
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Unable to open mesh file: " << mesh_fname);
+         return;
+      }
+#ifdef MFEM_USE_MPI
+      if (!serial)
+      {
+         mesh = new ParMesh(ParMesh::LoadFromBinaryFile(m_comm, mesh_fname,
+                                                        true, false));
+      }
+      else
+#endif
+      {
+         mesh = new Mesh(Mesh::LoadFromBinaryFile(mesh_fname, 1, false));
+      }
+      spatial_dim = mesh->SpaceDimension();
+      topo_dim = mesh->Dimension();
+      own_data = true;
+      return;
+   }
    named_ifgzstream file(mesh_fname);
    // TODO: in parallel, check for errors on all processors
    if (!file)
@@ -607,6 +1075,32 @@ void VisItDataCollection::LoadFields()
         it != field_info_map.end(); ++it)
    {
       std::string fname = path_left + it->first + path_right;
+      if (IsAggregated())
+      {
+         std::string field_data;
+         if (!ReadBinaryFile(GetFieldFileName(it->first), field_data))
+         {
+            error = READ_ERROR;
+            MFEM_WARNING("Unable to read field file: "
+                         << GetFieldFileName(it->first));
+            return;
+         }
+#ifdef MFEM_USE_MPI
+         std::istringstream file(field_data);
+         ParMesh *pmesh = dynamic_cast<ParMesh*>(mesh);
+         if ((it->second).association == "nodes")
+         {
+            field_map.Register(it->first, new ParGridFunction(pmesh, file),
+                               own_data);
+         }
+         else if ((it->second).association == "elements")
+         {
+            q_field_map.Register(it->first, new QuadratureFunction(mesh, file),
+                                 own_data);
+         }
+#endif
+         continue;
+      }
       mfem::ifgzstream file(fname);
       // TODO: in parallel, check for errors on all processors
       if (!file)
@@ -667,6 +1161,10 @@ std::string VisItDataCollection::GetVisItRootString()
                                   file_ext_format);
    mesh["tags"] = picojson::value(mtags);
    mesh["format"] = picojson::value(to_string(format));
+   if (format == BINARY_FORMAT)
+   {
+      mesh["io_files"] = picojson::value(to_string(num_io_files));
+   }
 
    // Build the fields data entries
    for (FieldInfoMapIterator it = field_info_map.begin();
@@ -737,6 +1235,10 @@ void VisItDataCollection::ParseVisItRootString(const std::string& json)
    {
       format = to_int(mesh.get("format").get<std::string>());
    }
+   if (mesh.contains("io_files"))
+   {
+      num_io_files = to_int(mesh.get("io_files").get<std::string>());
+   }
    spatial_dim = to_int(mesh.get("tags").get("spatial_dim").get<std::string>());
    topo_dim = to_int(mesh.get("tags").get("topo_dim").get<std::string>());
    visit_max_levels_of_detail =
@@ -21,6 +21,8 @@
 #include <string>
 #include <map>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 namespace mfem
 {
@@ -150,9 +152,15 @@ public:
       SERIAL_FORMAT = 0, /**<
          MFEM's serial ascii format, using the methods Mesh::Print() /
          ParMesh::Print(), and GridFunction::Save() / ParGridFunction::Save().*/
-      PARALLEL_FORMAT = 1  /**<
+      PARALLEL_FORMAT = 1, /**<
          MFEM's parallel ascii format, using the methods ParMesh::ParPrint() and
          GridFunction::Save() / ParGridFunction::Save(). */
+      BINARY_FORMAT = 2    /**<
+         MFEM's binary format, using the methods Mesh::PrintBinary() /
+         ParMesh::SaveBinary() and GridFunction::SaveBinary(). In parallel, the
+         mesh is written to a single file and the data of each field from all
+         MPI ranks is aggregated in a few files, see SetNumIOFiles(). When
+         compression is enabled, the field values are compressed with zlib. */
    };
 
 protected:
@@ -208,6 +216,43 @@ protected:
    /// Output mesh format: see the #Format enumeration
    int format;
    int compression;
+   /// Number of files per field in parallel #BINARY_FORMAT output
+   int num_io_files;
+
+   /// Snapshot of the data of one file written by an asynchronous Save()
+   struct SaveJob
+   {
+      std::string file_name;
+      std::string what;   ///< description used in error messages
+      bool binary;
+      int compression, precision;
+      /// Text header of a field, or the whole serialized mesh
+      std::string header;
+      /// Field values staged on the host
+      std::vector<real_t> values;
+      /// Number of values per line in ASCII format; 0 if there are no values
+      int width;
+#ifdef MFEM_USE_MPI
+      /// Communicator for collective binary output, or MPI_COMM_NULL
+      MPI_Comm comm;
+      std::string tag;
+      int num_aggregators;
+#endif
+   };
+
+   /// Save asynchronously, see SetAsyncSave()
+   bool async_save;
+   /// Staging buffers of the asynchronous Save(), reused between calls
+   std::vector<SaveJob> save_jobs;
+   int num_save_jobs;
+   /// Thread writing the data staged in save_jobs
+   std::thread save_thread;
+   /// Error state of save_thread
+   int save_error;
+#ifdef MFEM_USE_MPI
+   /// Communicators used by save_thread, freed by WaitSave()
+   std::vector<MPI_Comm> save_comms;
+#endif
 
    /// Should the collection delete its mesh and fields
    bool own_data;
@@ -220,10 +265,49 @@ protected:
    /// Delete data owned by the DataCollection including field information
    void DeleteAll();
 
+   std::string GetDirectoryName() const;
    std::string GetMeshShortFileName() const;
    std::string GetMeshFileName() const;
    std::string GetFieldFileName(const std::string &field_name) const;
 
+   /// Are the parallel #BINARY_FORMAT fields aggregated in num_io_files files?
+   bool IsAggregated() const;
+   /** @brief Return the index of the file written by this rank, i.e. the
+       rank, or the I/O group of the rank when IsAggregated(). */
+   int GetFileIndex() const;
+
+   /** @brief Write the binary @a data to the file @a fname. When
+       IsAggregated(), this is collective and the data of all ranks in the I/O
+       group is written to the same file. Returns false on error. */
+   bool WriteBinaryFile(const std::string &fname, const std::string &data);
+   /** @brief Read the binary @a data of this rank, written by
+       WriteBinaryFile(), from the file @a fname. Returns false on error. */
+   bool ReadBinaryFile(const std::string &fname, std::string &data);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Write the binary @a data of all ranks in @a comm to the file
+       @a fname with collective MPI-IO calls. Returns false on error.
+
+       The file starts with the line @a tag, followed by the byte order mark,
+       the number of ranks and the offsets of the data of all ranks. When
+       @a num_aggregators is positive, it is passed to MPI-IO as the number of
+       ranks that perform the writes. */
+   static bool WriteParallelBinaryFile(MPI_Comm comm, const std::string &fname,
+                                       const std::string &tag,
+                                       const std::string &data,
+                                       int num_aggregators = 0);
+#endif
+
+   /// Stage the mesh and field data and start save_thread
+   void SaveAsync();
+   /// Return a new job in save_jobs, reusing its buffers
+   SaveJob &NewSaveJob(const std::string &file_name, const std::string &what);
+   /// Write the data of @a job, called by save_thread. Returns false on error.
+   static bool WriteSaveJob(const SaveJob &job);
+
+   /// Create the collection directory for the current cycle
+   bool CreateSaveDirectory();
+
    /// Save one field to disk, assuming the collection directory exists
    void SaveOneField(const FieldMapIterator &it);
 
@@ -353,6 +437,40 @@ public:
    /// Set the flag for use of gz compressed files
    virtual void SetCompression(bool comp);
 
+   /** @brief Set the number of files in which the data of each field is
+       aggregated, in parallel #BINARY_FORMAT output.
+
+       The MPI ranks are split into @a nfiles groups of consecutive ranks. The
+       ranks in each group write their data to a shared file with collective
+       MPI-IO calls, funneled through one aggregator rank per group, instead of
+       each rank writing its own file. This limits the load on the metadata
+       server of parallel file systems at large scale. The default is 1, i.e.
+       one file per field for all ranks. */
+   void SetNumIOFiles(int nfiles);
+   /// Get the number of files per field in parallel #BINARY_FORMAT output.
+   int GetNumIOFiles() const { return num_io_files; }
+
+   /** @brief Enable or disable the asynchronous mode of Save().
+
+       In asynchronous mode, Save() copies the data of the fields, from the
+       device if needed, to staging buffers on the host and serializes the mesh
+       in memory. It then returns, and a background thread formats, compresses
+       and writes the data while the simulation continues. If the previous
+       Save() is still in progress, Save() first waits for it to complete. The
+       error state of an asynchronous save is reported by Error() after
+       WaitSave(). In parallel #BINARY_FORMAT output, the background thread
+       performs collective MPI-IO calls, which requires MPI to be initialized
+       with MPI_THREAD_MULTIPLE support.
+
+       Derived classes that override Save(), such as ParaViewDataCollection,
+       do not support the asynchronous mode. */
+   void SetAsyncSave(bool async) { WaitSave(); async_save = async; }
+   /// Is the asynchronous mode of Save() enabled?
+   bool GetAsyncSave() const { return async_save; }
+   /** @brief Wait for the completion of the asynchronous Save() in progress,
+       if any. In parallel, this must be called on all ranks. */
+   void WaitSave();
+
    /// Set the path where the DataCollection will be saved.
    void SetPrefixPath(const std::string &prefix);
 
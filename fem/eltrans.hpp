@@ -311,6 +311,10 @@ public:
        will be selected. */
    void SetInitialGuessType(InitGuessType itype) { init_guess_type = itype; }
 
+   /// Return the current #InitGuessType.
+   InitGuessType GetInitialGuessType() const
+   { return static_cast<InitGuessType>(init_guess_type); }
+
    /** @brief Set the initial guess for subsequent calls to Transform(),
        switching to the #GivenPoint #InitGuessType at the same time. */
    void SetInitialGuess(const IntegrationPoint &init_ip)
@@ -45,6 +45,7 @@
 #include "transfer.hpp"
 #include "fespacehierarchy.hpp"
 #include "multigrid.hpp"
+#include "amg.hpp"
 #include "ceed/solvers/algebraic.hpp"
 #include "lor/lor.hpp"
 #include "dgmassinv.hpp"
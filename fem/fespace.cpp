@@ -384,17 +384,21 @@ void FiniteElementSpace::BuildElementToDofTable() const
 {
    if (elem_dof) { return; }
 
-   // TODO: can we call GetElementDofs only once per element?
+   // Call GetElementDofs only once per element: the dofs are collected in a
+   // temporary array and copied to the table after its row sizes are known
+   const int NE = mesh->GetNE();
    Table *el_dof = new Table;
    Table *el_fos = (mesh->Dimension() > 2) ? (new Table) : NULL;
-   Array<int> dofs;
+   Array<int> dofs, all_dofs;
    Array<int> F, Fo;
-   el_dof -> MakeI (mesh -> GetNE());
-   if (el_fos) { el_fos -> MakeI (mesh -> GetNE()); }
-   for (int i = 0; i < mesh -> GetNE(); i++)
+   el_dof -> MakeI (NE);
+   if (el_fos) { el_fos -> MakeI (NE); }
+   for (int i = 0; i < NE; i++)
    {
       GetElementDofs (i, dofs);
       el_dof -> AddColumnsInRow (i, dofs.Size());
+      if (i == 0) { all_dofs.Reserve(NE*dofs.Size()); }
+      all_dofs.Append(dofs);
 
       if (el_fos)
       {
@@ -402,21 +406,20 @@ void FiniteElementSpace::BuildElementToDofTable() const
          el_fos -> AddColumnsInRow (i, Fo.Size());
       }
    }
+   // after MakeJ(), the row offsets in el_dof are final and its J array has
+   // the same layout as all_dofs
    el_dof -> MakeJ();
-   if (el_fos) { el_fos -> MakeJ(); }
-   for (int i = 0; i < mesh -> GetNE(); i++)
+   std::copy(all_dofs.begin(), all_dofs.end(), el_dof -> GetJ());
+   if (el_fos)
    {
-      GetElementDofs (i, dofs);
-      el_dof -> AddConnections (i, (int *)dofs, dofs.Size());
-
-      if (el_fos)
+      el_fos -> MakeJ();
+      for (int i = 0; i < NE; i++)
       {
          mesh->GetElementFaces(i, F, Fo);
          el_fos -> AddConnections (i, (int *)Fo, Fo.Size());
       }
+      el_fos -> ShiftUpI();
    }
-   el_dof -> ShiftUpI();
-   if (el_fos) { el_fos -> ShiftUpI(); }
    elem_dof = el_dof;
    elem_fos = el_fos;
 }
@@ -706,6 +709,31 @@ void FiniteElementSpace::GetBoundaryTrueDofs(Array<int> &boundary_dofs,
    }
 }
 
+void FiniteElementSpace::GetVDofLevels(Array<int> &levels) const
+{
+   levels.SetSize(GetVSize());
+   levels = 0;
+   if (!mesh->ncmesh || mesh->GetNE() == 0) { return; }
+
+   Array<int> depth(mesh->GetNE());
+   for (int i = 0; i < depth.Size(); i++)
+   {
+      depth[i] = mesh->ncmesh->GetElementDepth(i);
+   }
+   const int min_depth = depth.Min();
+
+   Array<int> vdofs;
+   for (int i = 0; i < depth.Size(); i++)
+   {
+      GetElementVDofs(i, vdofs);
+      for (int j = 0; j < vdofs.Size(); j++)
+      {
+         const int vd = DecodeDof(vdofs[j]);
+         levels[vd] = std::max(levels[vd], depth[i] - min_depth);
+      }
+   }
+}
+
 void FiniteElementSpace::GetExteriorVDofs(Array<int> &ext_vdofs,
                                           int component) const
 {
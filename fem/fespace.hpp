@@ -1286,6 +1286,13 @@ public:
        marked as essential. */
    void GetBoundaryTrueDofs(Array<int> &boundary_dofs, int component = -1);
 
+   /** @brief Get the refinement level of each vdof, relative to the coarsest
+       element of the (local) mesh: the maximum over the elements containing
+       the vdof of NCMesh::GetElementDepth(), minus its minimum over the mesh.
+       All levels are zero for conforming meshes. Used e.g. to define the
+       levels of a MultirateABSolver. */
+   void GetVDofLevels(Array<int> &levels) const;
+
    /** @brief Mark degrees of freedom associated with exterior faces of the
        mesh. For spaces with 'vdim' > 1, the 'component' parameter can be used
        to restricts the marked vDOFs to the specified component. */
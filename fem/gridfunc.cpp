@@ -45,7 +45,12 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
 
    skip_comment_lines(input, '#');
    istream::int_type next_char = input.peek();
-   if (next_char == 'N') // First letter of "NURBS_patches"
+   if (next_char == 'M') // First letter of "MFEM binary vector"
+   {
+      LoadBinary(input);
+      MFEM_VERIFY(size == fes->GetVSize(), "invalid binary GridFunction size");
+   }
+   else if (next_char == 'N') // First letter of "NURBS_patches"
    {
       string buff;
       getline(input, buff);
@@ -3705,6 +3710,14 @@ void GridFunction::Save(const char *fname, int precision) const
    Save(ofs);
 }
 
+void GridFunction::SaveBinary(std::ostream &os, int compression_level) const
+{
+   fes->Save(os);
+   os << '\n';
+   PrintBinary(os, compression_level);
+   os.flush();
+}
+
 #ifdef MFEM_USE_ADIOS2
 void GridFunction::Save(adios2stream &os,
                         const std::string& variable_name,
@@ -101,8 +101,8 @@ public:
 
    /// Construct a GridFunction on the given Mesh, using the data from @a input.
    /** The content of @a input should be in the format created by the method
-       Save(). The reconstructed FiniteElementSpace and FiniteElementCollection
-       are owned by the GridFunction. */
+       Save() or SaveBinary(). The reconstructed FiniteElementSpace and
+       FiniteElementCollection are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
@@ -1525,6 +1525,14 @@ public:
    /// ASCII output.
    virtual void Save(const char *fname, int precision=16) const;
 
+   /// Save the GridFunction to a binary output stream.
+   /** The FiniteElementSpace header is written as in Save(), followed by the
+       values in binary format, see Vector::PrintBinary(), compressed with zlib
+       when @a compression_level is not zero. This is faster and more compact
+       than the ASCII output, and does not lose precision. The result can be
+       read back with the constructor GridFunction(Mesh*, std::istream&). */
+   virtual void SaveBinary(std::ostream &out, int compression_level = 0) const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
@@ -21,59 +21,66 @@ void KDTreeNodalProjection<2>::Project(const Vector& coords,const Vector& src,
    const int dim=dest->FESpace()->GetMesh()->SpaceDimension();
    const int vd=dest->VectorDim(); // dimension of the vector field
    const int np=src.Size()/vd; // number of points
-   int ind;
-   real_t dist;
    bool pt_inside_bbox;
-   KDTree2D::PointND pnd;
+
+   // search for the points inside the bounding box in one batch
+   std::vector<real_t> pts;
+   std::vector<int> pids;
    for (int i=0; i<np; i++)
    {
-      pnd.xx[0]=coords(i*dim+0);
-      pnd.xx[1]=coords(i*dim+1);
-
       pt_inside_bbox=true;
       for (int j=0; j<dim; j++)
       {
-         if (pnd.xx[j]>(maxbb[j]+lerr)) {pt_inside_bbox=false; break;}
-         if (pnd.xx[j]<(minbb[j]-lerr)) {pt_inside_bbox=false; break;}
+         if (coords(i*dim+j)>(maxbb[j]+lerr)) {pt_inside_bbox=false; break;}
+         if (coords(i*dim+j)<(minbb[j]-lerr)) {pt_inside_bbox=false; break;}
       }
-
       if (pt_inside_bbox)
       {
-         kdt->FindClosestPoint(pnd,ind,dist);
-         if (dist<lerr)
+         pts.insert(pts.end(),coords.GetData()+i*dim,
+                    coords.GetData()+(i+1)*dim);
+         pids.push_back(i);
+      }
+   }
+   std::vector<int> inds(pids.size());
+   std::vector<real_t> dists(pids.size());
+   kdt->FindClosestPoints(pts.data(),pids.size(),inds.data(),dists.data());
+
+   for (size_t p=0; p<pids.size(); p++)
+   {
+      const int i=pids[p], ind=inds[p];
+      if (dists[p]<lerr)
+      {
+         if (dest->FESpace()->GetOrdering()==Ordering::byNODES)
          {
-            if (dest->FESpace()->GetOrdering()==Ordering::byNODES)
+            if (ordering==Ordering::byNODES)
             {
-               if (ordering==Ordering::byNODES)
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di*np+ind]=src[di*np+i];
-                  }
+                  (*dest)[di*np+ind]=src[di*np+i];
                }
-               else
+            }
+            else
+            {
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di*np+ind]=src[di+i*vd];
-                  }
+                  (*dest)[di*np+ind]=src[di+i*vd];
                }
             }
-            else
+         }
+         else
+         {
+            if (ordering==Ordering::byNODES)
             {
-               if (ordering==Ordering::byNODES)
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di+ind*vd]=src[di*np+i];
-                  }
+                  (*dest)[di+ind*vd]=src[di*np+i];
                }
-               else
+            }
+            else
+            {
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di+ind*vd]=src[di+i*vd];
-                  }
+                  (*dest)[di+ind*vd]=src[di+i*vd];
                }
             }
          }
@@ -88,60 +95,66 @@ void KDTreeNodalProjection<3>::Project(const Vector& coords,const Vector& src,
    const int dim=dest->FESpace()->GetMesh()->SpaceDimension();
    const int vd=dest->VectorDim(); // dimension of the vector field
    const int np=src.Size()/vd; // number of points
-   int ind;
-   real_t dist;
    bool pt_inside_bbox;
-   KDTree3D::PointND pnd;
+
+   // search for the points inside the bounding box in one batch
+   std::vector<real_t> pts;
+   std::vector<int> pids;
    for (int i=0; i<np; i++)
    {
-      pnd.xx[0]=coords(i*dim+0);
-      pnd.xx[1]=coords(i*dim+1);
-      pnd.xx[2]=coords(i*dim+2);
-
       pt_inside_bbox=true;
       for (int j=0; j<dim; j++)
       {
-         if (pnd.xx[j]>(maxbb[j]+lerr)) {pt_inside_bbox=false; break;}
-         if (pnd.xx[j]<(minbb[j]-lerr)) {pt_inside_bbox=false; break;}
+         if (coords(i*dim+j)>(maxbb[j]+lerr)) {pt_inside_bbox=false; break;}
+         if (coords(i*dim+j)<(minbb[j]-lerr)) {pt_inside_bbox=false; break;}
       }
-
       if (pt_inside_bbox)
       {
-         kdt->FindClosestPoint(pnd,ind,dist);
-         if (dist<lerr)
+         pts.insert(pts.end(),coords.GetData()+i*dim,
+                    coords.GetData()+(i+1)*dim);
+         pids.push_back(i);
+      }
+   }
+   std::vector<int> inds(pids.size());
+   std::vector<real_t> dists(pids.size());
+   kdt->FindClosestPoints(pts.data(),pids.size(),inds.data(),dists.data());
+
+   for (size_t p=0; p<pids.size(); p++)
+   {
+      const int i=pids[p], ind=inds[p];
+      if (dists[p]<lerr)
+      {
+         if (dest->FESpace()->GetOrdering()==Ordering::byNODES)
          {
-            if (dest->FESpace()->GetOrdering()==Ordering::byNODES)
+            if (ordering==Ordering::byNODES)
             {
-               if (ordering==Ordering::byNODES)
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di*np+ind]=src[di*np+i];
-                  }
+                  (*dest)[di*np+ind]=src[di*np+i];
                }
-               else
+            }
+            else
+            {
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di*np+ind]=src[di+i*vd];
-                  }
+                  (*dest)[di*np+ind]=src[di+i*vd];
                }
             }
-            else
+         }
+         else
+         {
+            if (ordering==Ordering::byNODES)
             {
-               if (ordering==Ordering::byNODES)
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di+ind*vd]=src[di*np+i];
-                  }
+                  (*dest)[di+ind*vd]=src[di*np+i];
                }
-               else
+            }
+            else
+            {
+               for (int di=0; di<vd; di++)
                {
-                  for (int di=0; di<vd; di++)
-                  {
-                     (*dest)[di+ind*vd]=src[di+i*vd];
-                  }
+                  (*dest)[di+ind*vd]=src[di+i*vd];
                }
             }
          }
@@ -157,8 +170,6 @@ void KDTreeNodalProjection<2>::Project(const GridFunction& gf, real_t lerr)
    int np=gf.FESpace()->GetVSize()/gf.FESpace()->GetVDim();
    coo.SetSize(np*2);
    int vd=dest->VectorDim();
-   int ind;
-   real_t dist;
 
    Vector maxbb_src(2);
    Vector minbb_src(2);
@@ -226,14 +237,13 @@ void KDTreeNodalProjection<2>::Project(const GridFunction& gf, real_t lerr)
    }
 
    {
-      KDTree2D::PointND pnd;
+      std::vector<int> inds(np);
+      std::vector<real_t> dists(np);
+      kdt->FindClosestPoints(coo.GetData(),np,inds.data(),dists.data());
       for (int i=0; i<np; i++)
       {
-         pnd.xx[0]=coo(i*2+0);
-         pnd.xx[1]=coo(i*2+1);
-
-         kdt->FindClosestPoint(pnd,ind,dist);
-         if (dist<lerr)
+         const int ind=inds[i];
+         if (dists[i]<lerr)
          {
             if (dest->FESpace()->GetOrdering()==Ordering::byNODES)
             {
@@ -283,8 +293,6 @@ void KDTreeNodalProjection<3>::Project(const GridFunction& gf, real_t lerr)
    int np=gf.FESpace()->GetVSize()/gf.FESpace()->GetVDim();
    coo.SetSize(np*dim);
    int vd=dest->VectorDim();
-   int ind;
-   real_t dist;
 
    Vector maxbb_src(dim);
    Vector minbb_src(dim);
@@ -352,15 +360,13 @@ void KDTreeNodalProjection<3>::Project(const GridFunction& gf, real_t lerr)
    }
 
    {
-      KDTree3D::PointND pnd;
+      std::vector<int> inds(np);
+      std::vector<real_t> dists(np);
+      kdt->FindClosestPoints(coo.GetData(),np,inds.data(),dists.data());
       for (int i=0; i<np; i++)
       {
-         pnd.xx[0]=coo(i*dim+0);
-         pnd.xx[1]=coo(i*dim+1);
-         pnd.xx[2]=coo(i*dim+2);
-
-         kdt->FindClosestPoint(pnd,ind,dist);
-         if (dist<lerr)
+         const int ind=inds[i];
+         if (dists[i]<lerr)
          {
             if (dest->FESpace()->GetOrdering()==Ordering::byNODES)
             {
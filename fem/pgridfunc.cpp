@@ -949,6 +949,23 @@ void ParGridFunction::Save(std::ostream &os) const
    }
 }
 
+void ParGridFunction::SaveBinary(std::ostream &os,
+                                 int compression_level) const
+{
+   real_t *data_  = const_cast<real_t*>(HostRead());
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data_[i] = -data_[i]; }
+   }
+
+   GridFunction::SaveBinary(os, compression_level);
+
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data_[i] = -data_[i]; }
+   }
+}
+
 void ParGridFunction::Save(const char *fname, int precision) const
 {
    int rank = pfes->GetMyRank();
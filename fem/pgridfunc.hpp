@@ -582,6 +582,11 @@ public:
        the local dofs. */
    void Save(std::ostream &out) const override;
 
+   /** Save the local portion of the ParGridFunction in binary format, taking
+       into account the signs of the local dofs, see Save(). */
+   void SaveBinary(std::ostream &out,
+                   int compression_level = 0) const override;
+
    /// Save the ParGridFunction to a single file (written using MPI rank 0). The
    /// given @a precision will be used for ASCII output.
    void SaveAsOne(const char *fname, int precision=16) const;
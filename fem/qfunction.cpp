@@ -44,7 +44,16 @@ QuadratureFunction::QuadratureFunction(Mesh *mesh, std::istream &in)
    in >> ident; MFEM_VERIFY(ident == "VDim:", msg);
    in >> vdim;
 
-   Load(in, vdim*qspace->GetSize());
+   in >> std::ws;
+   if (in.peek() == 'M') // First letter of "MFEM binary vector"
+   {
+      LoadBinary(in);
+      MFEM_VERIFY(size == vdim*qspace->GetSize(), msg);
+   }
+   else
+   {
+      Load(in, vdim*qspace->GetSize());
+   }
 }
 
 void QuadratureFunction::Save(std::ostream &os) const
@@ -56,6 +65,16 @@ void QuadratureFunction::Save(std::ostream &os) const
    os.flush();
 }
 
+void QuadratureFunction::SaveBinary(std::ostream &os,
+                                    int compression_level) const
+{
+   GetSpace()->Save(os);
+   os << "VDim: " << vdim << '\n'
+      << '\n';
+   PrintBinary(os, compression_level);
+   os.flush();
+}
+
 void QuadratureFunction::ProjectGridFunction(const GridFunction &gf)
 {
    SetVDim(gf.VectorDim());
@@ -68,7 +68,9 @@ public:
    }
 
    /// Read a QuadratureFunction from the stream @a in.
-   /** The QuadratureFunction assumes ownership of the read QuadratureSpace. */
+   /** The content of @a in should be in the format created by the method
+       Save() or SaveBinary(). The QuadratureFunction assumes ownership of the
+       read QuadratureSpace. */
    QuadratureFunction(Mesh *mesh, std::istream &in);
 
    /// Get the vector dimension.
@@ -179,6 +181,12 @@ public:
    /// Write the QuadratureFunction to the stream @a out.
    void Save(std::ostream &out) const;
 
+   /** @brief Write the QuadratureFunction to the binary stream @a out, with
+       the values compressed with zlib when @a compression_level is not zero.
+
+       See GridFunction::SaveBinary(). */
+   void SaveBinary(std::ostream &out, int compression_level = 0) const;
+
    /// @brief Write the QuadratureFunction to @a out in VTU (ParaView) format.
    ///
    /// The data will be uncompressed if @a compression_level is zero, or if the
@@ -21,7 +21,8 @@ GridTransfer::GridTransfer(FiniteElementSpace &dom_fes_,
                            FiniteElementSpace &ran_fes_)
    : dom_fes(dom_fes_), ran_fes(ran_fes_),
      oper_type(Operator::ANY_TYPE),
-     fw_t_oper(), bw_t_oper(), use_ea(false), d_mt(Device::GetHostMemoryType())
+     fw_t_oper(), bw_t_oper(), use_ea(false), use_pa(false),
+     d_mt(Device::GetHostMemoryType())
 {
 #ifdef MFEM_USE_MPI
    const bool par_dom = dynamic_cast<ParFiniteElementSpace*>(&dom_fes);
@@ -1022,11 +1023,12 @@ void L2ProjectionGridTransfer::L2ProjectionL2Space::EAProlongateTranspose(
 
 L2ProjectionGridTransfer::L2ProjectionH1Space::L2ProjectionH1Space(
    const FiniteElementSpace& fes_ho_, const FiniteElementSpace& fes_lor_,
-   const bool use_ea_, MemoryType d_mt_)
+   const bool use_ea_, MemoryType d_mt_, const bool use_pa_)
    : L2Projection(fes_ho_, fes_lor_, d_mt_),
-     use_ea(use_ea_)
+     use_ea(use_ea_),
+     use_pa(use_pa_ && TensorMixedMassOperator::Supports(fes_ho_, fes_lor_))
 {
-   if (use_ea)
+   if (use_ea || use_pa)
    {
       EAL2ProjectionH1Space();
       return;
@@ -1077,11 +1079,13 @@ L2ProjectionGridTransfer::L2ProjectionH1Space::L2ProjectionH1Space(
 
 L2ProjectionGridTransfer::L2ProjectionH1Space::L2ProjectionH1Space(
    const ParFiniteElementSpace& pfes_ho, const ParFiniteElementSpace& pfes_lor,
-   const bool use_ea_, MemoryType d_mt_)
+   const bool use_ea_, MemoryType d_mt_, const bool use_pa_)
    : L2Projection(pfes_ho, pfes_lor, d_mt_),
-     use_ea(use_ea_), pcg(pfes_ho.GetComm())
+     use_ea(use_ea_),
+     use_pa(use_pa_ && TensorMixedMassOperator::Supports(pfes_ho, pfes_lor)),
+     pcg(pfes_ho.GetComm())
 {
-   if (use_ea)
+   if (use_ea || use_pa)
    {
       EAL2ProjectionH1Space(pfes_ho, pfes_lor);
       return;
@@ -1221,11 +1225,17 @@ void L2ProjectionGridTransfer::L2ProjectionH1Space::EAL2ProjectionH1Space()
    // **************************
    // mixed mass M_LH
    // **************************
-   MixedMassEA(fes_ho, fes_lor, M_LH_ea, d_mt);
-
-   // Set ownership
-   M_LH_local_op = new H1SpaceMixedMassOperator(&fes_ho, &fes_lor, &ho2lor,
-                                                &M_LH_ea);
+   if (use_pa)
+   {
+      M_LH_local_op = new TensorMixedMassOperator(*fes_ho_scalar,
+                                                  *fes_lor_scalar);
+   }
+   else
+   {
+      MixedMassEA(fes_ho, fes_lor, M_LH_ea, d_mt);
+      M_LH_local_op = new H1SpaceMixedMassOperator(&fes_ho, &fes_lor, &ho2lor,
+                                                   &M_LH_ea);
+   }
 
    ML_inv_vea.reset(new H1SpaceLumpedMassOperator(&fes_ho, &fes_lor, ML_inv_ea));
    M_LH.reset(M_LH_local_op);
@@ -1318,12 +1328,18 @@ void L2ProjectionGridTransfer::L2ProjectionH1Space::EAL2ProjectionH1Space
    // **************************
    // mixed mass M_LH
    // **************************
-   MixedMassEA(*pfes_ho_scalar.get(), *pfes_lor_scalar.get(), M_LH_ea, d_mt);
-
-   // Set ownership
-   M_LH_local_op = new H1SpaceMixedMassOperator(pfes_ho_scalar.get(),
-                                                pfes_lor_scalar.get(),
-                                                &ho2lor, &M_LH_ea);
+   if (use_pa)
+   {
+      M_LH_local_op = new TensorMixedMassOperator(*pfes_ho_scalar,
+                                                  *pfes_lor_scalar);
+   }
+   else
+   {
+      MixedMassEA(*pfes_ho_scalar.get(), *pfes_lor_scalar.get(), M_LH_ea, d_mt);
+      M_LH_local_op = new H1SpaceMixedMassOperator(pfes_ho_scalar.get(),
+                                                   pfes_lor_scalar.get(),
+                                                   &ho2lor, &M_LH_ea);
+   }
 
    const Operator *P_ho = pfes_ho_scalar->GetProlongationMatrix();
    const Operator *P_lor = pfes_lor_scalar->GetProlongationMatrix();
@@ -1993,6 +2009,675 @@ void L2ProjectionGridTransfer::H1SpaceLumpedMassOperator::MultTranspose(
    this->Mult(x,y); // lumped diagonal has the same Mult and MultTranspose behavior
 }
 
+namespace TransferKernels
+{
+
+namespace
+{
+
+// Kernels of TensorMixedMassOperator. Each high-order element has DH^dim
+// lexicographic dofs and R^dim sub-elements with DL^dim dofs and NQ^dim
+// quadrature points. The images of the quadrature points of all sub-elements
+// form a tensor-product grid with Q = R*NQ points in each direction, on which
+// the high-order basis, B_H, is evaluated. The elements are processed in
+// batches of NB elements, which share the scratch space in 'work'.
+void MixedMass2D(const int NE, const int NEL, const int R, const int NQ,
+                 const int DH, const int DL, const int NB,
+                 const Vector &B_H, const Vector &B_L, const Vector &D,
+                 const Array<int> &lor_els, const Vector &x, Vector &y,
+                 Vector &work)
+{
+   const int Q = R*NQ;
+   const int wsize = Q*DH + Q*Q + DL*NQ;
+   const auto Bh = Reshape(B_H.Read(), Q, DH);
+   const auto Bl = Reshape(B_L.Read(), NQ, DL);
+   const auto d = Reshape(D.Read(), NQ, NQ, R*R, NE);
+   const auto L = Reshape(lor_els.Read(), R*R, NE);
+   const auto X = Reshape(x.Read(), DH, DH, NE);
+   auto Y = Reshape(y.Write(), DL, DL, NEL);
+   real_t *w = work.Write();
+
+   for (int e0 = 0; e0 < NE; e0 += NB)
+   {
+      mfem::forall(std::min(NB, NE - e0), [=] MFEM_HOST_DEVICE (int eb)
+      {
+         const int e = e0 + eb;
+         auto T = Reshape(w + eb*wsize, Q, DH);
+         auto U = Reshape(w + eb*wsize + Q*DH, Q, Q);
+         auto A = Reshape(w + eb*wsize + Q*DH + Q*Q, DL, NQ);
+
+         // interpolate to the quadrature points of all sub-elements
+         for (int dy = 0; dy < DH; dy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               real_t s = 0.0;
+               for (int dx = 0; dx < DH; dx++) { s += Bh(qx,dx)*X(dx,dy,e); }
+               T(qx,dy) = s;
+            }
+         }
+         for (int qy = 0; qy < Q; qy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               real_t s = 0.0;
+               for (int dy = 0; dy < DH; dy++) { s += Bh(qy,dy)*T(qx,dy); }
+               U(qx,qy) = s;
+            }
+         }
+
+         // integrate against the basis of each sub-element
+         for (int cy = 0; cy < R; cy++)
+         {
+            for (int cx = 0; cx < R; cx++)
+            {
+               const int c = cx + R*cy, le = L(c,e);
+               for (int q2 = 0; q2 < NQ; q2++)
+               {
+                  for (int dx = 0; dx < DL; dx++)
+                  {
+                     real_t s = 0.0;
+                     for (int q1 = 0; q1 < NQ; q1++)
+                     {
+                        s += Bl(q1,dx)*d(q1,q2,c,e)*U(cx*NQ+q1, cy*NQ+q2);
+                     }
+                     A(dx,q2) = s;
+                  }
+               }
+               for (int dy = 0; dy < DL; dy++)
+               {
+                  for (int dx = 0; dx < DL; dx++)
+                  {
+                     real_t s = 0.0;
+                     for (int q2 = 0; q2 < NQ; q2++)
+                     {
+                        s += Bl(q2,dy)*A(dx,q2);
+                     }
+                     Y(dx,dy,le) = s;
+                  }
+               }
+            }
+         }
+      });
+   }
+}
+
+void MixedMassTranspose2D(const int NE, const int NEL, const int R,
+                          const int NQ, const int DH, const int DL,
+                          const int NB, const Vector &B_H, const Vector &B_L,
+                          const Vector &D, const Array<int> &lor_els,
+                          const Vector &x, Vector &y, Vector &work)
+{
+   const int Q = R*NQ;
+   const int wsize = Q*DH + Q*Q + DL*NQ;
+   const auto Bh = Reshape(B_H.Read(), Q, DH);
+   const auto Bl = Reshape(B_L.Read(), NQ, DL);
+   const auto d = Reshape(D.Read(), NQ, NQ, R*R, NE);
+   const auto L = Reshape(lor_els.Read(), R*R, NE);
+   const auto X = Reshape(x.Read(), DL, DL, NEL);
+   auto Y = Reshape(y.Write(), DH, DH, NE);
+   real_t *w = work.Write();
+
+   for (int e0 = 0; e0 < NE; e0 += NB)
+   {
+      mfem::forall(std::min(NB, NE - e0), [=] MFEM_HOST_DEVICE (int eb)
+      {
+         const int e = e0 + eb;
+         auto T = Reshape(w + eb*wsize, Q, DH);
+         auto U = Reshape(w + eb*wsize + Q*DH, Q, Q);
+         auto A = Reshape(w + eb*wsize + Q*DH + Q*Q, NQ, DL);
+
+         // values at the quadrature points of each sub-element
+         for (int cy = 0; cy < R; cy++)
+         {
+            for (int cx = 0; cx < R; cx++)
+            {
+               const int c = cx + R*cy, le = L(c,e);
+               for (int dy = 0; dy < DL; dy++)
+               {
+                  for (int q1 = 0; q1 < NQ; q1++)
+                  {
+                     real_t s = 0.0;
+                     for (int dx = 0; dx < DL; dx++)
+                     {
+                        s += Bl(q1,dx)*X(dx,dy,le);
+                     }
+                     A(q1,dy) = s;
+                  }
+               }
+               for (int q2 = 0; q2 < NQ; q2++)
+               {
+                  for (int q1 = 0; q1 < NQ; q1++)
+                  {
+                     real_t s = 0.0;
+                     for (int dy = 0; dy < DL; dy++)
+                     {
+                        s += Bl(q2,dy)*A(q1,dy);
+                     }
+                     U(cx*NQ+q1, cy*NQ+q2) = d(q1,q2,c,e)*s;
+                  }
+               }
+            }
+         }
+
+         // integrate against the high-order basis
+         for (int dy = 0; dy < DH; dy++)
+         {
+            for (int qx = 0; qx < Q; qx++)
+            {
+               real_t s = 0.0;
+               for (int qy = 0; qy < Q; qy++) { s += Bh(qy,dy)*U(qx,qy); }
+               T(qx,dy) = s;
+            }
+         }
+         for (int dy = 0; dy < DH; dy++)
+         {
+            for (int dx = 0; dx < DH; dx++)
+            {
+               real_t s = 0.0;
+               for (int qx = 0; qx < Q; qx++) { s += Bh(qx,dx)*T(qx,dy); }
+               Y(dx,dy,e) = s;
+            }
+         }
+      });
+   }
+}
+
+void MixedMass3D(const int NE, const int NEL, const int R, const int NQ,
+                 const int DH, const int DL, const int NB,
+                 const Vector &B_H, const Vector &B_L, const Vector &D,
+                 const Array<int> &lor_els, const Vector &x, Vector &y,
+                 Vector &work)
+{
+   const int Q = R*NQ;
+   const int wsize = Q*DH*DH + Q*Q*DH + Q*Q*Q + DL*NQ*NQ + DL*DL*NQ;
+   const auto Bh = Reshape(B_H.Read(), Q, DH);
+   const auto Bl = Reshape(B_L.Read(), NQ, DL);
+   const auto d = Reshape(D.Read(), NQ, NQ, NQ, R*R*R, NE);
+   const auto L = Reshape(lor_els.Read(), R*R*R, NE);
+   const auto X = Reshape(x.Read(), DH, DH, DH, NE);
+   auto Y = Reshape(y.Write(), DL, DL, DL, NEL);
+   real_t *w = work.Write();
+
+   for (int e0 = 0; e0 < NE; e0 += NB)
+   {
+      mfem::forall(std::min(NB, NE - e0), [=] MFEM_HOST_DEVICE (int eb)
+      {
+         const int e = e0 + eb;
+         real_t *we = w + eb*wsize;
+         auto T1 = Reshape(we, Q, DH, DH);
+         auto T2 = Reshape(we + Q*DH*DH, Q, Q, DH);
+         auto U = Reshape(we + Q*DH*DH + Q*Q*DH, Q, Q, Q);
+         auto A1 = Reshape(we + Q*DH*DH + Q*Q*DH + Q*Q*Q, DL, NQ, NQ);
+         auto A2 = Reshape(we + Q*DH*DH + Q*Q*DH + Q*Q*Q + DL*NQ*NQ,
+                           DL, DL, NQ);
+
+         // interpolate to the quadrature points of all sub-elements
+         for (int dz = 0; dz < DH; dz++)
+         {
+            for (int dy = 0; dy < DH; dy++)
+            {
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  real_t s = 0.0;
+                  for (int dx = 0; dx < DH; dx++)
+                  {
+                     s += Bh(qx,dx)*X(dx,dy,dz,e);
+                  }
+                  T1(qx,dy,dz) = s;
+               }
+            }
+         }
+         for (int dz = 0; dz < DH; dz++)
+         {
+            for (int qy = 0; qy < Q; qy++)
+            {
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  real_t s = 0.0;
+                  for (int dy = 0; dy < DH; dy++)
+                  {
+                     s += Bh(qy,dy)*T1(qx,dy,dz);
+                  }
+                  T2(qx,qy,dz) = s;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q; qz++)
+         {
+            for (int qy = 0; qy < Q; qy++)
+            {
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  real_t s = 0.0;
+                  for (int dz = 0; dz < DH; dz++)
+                  {
+                     s += Bh(qz,dz)*T2(qx,qy,dz);
+                  }
+                  U(qx,qy,qz) = s;
+               }
+            }
+         }
+
+         // integrate against the basis of each sub-element
+         for (int c = 0; c < R*R*R; c++)
+         {
+            const int cx = c % R, cy = (c / R) % R, cz = c / (R*R);
+            const int le = L(c,e);
+            for (int q3 = 0; q3 < NQ; q3++)
+            {
+               for (int q2 = 0; q2 < NQ; q2++)
+               {
+                  for (int dx = 0; dx < DL; dx++)
+                  {
+                     real_t s = 0.0;
+                     for (int q1 = 0; q1 < NQ; q1++)
+                     {
+                        s += Bl(q1,dx)*d(q1,q2,q3,c,e)*
+                             U(cx*NQ+q1, cy*NQ+q2, cz*NQ+q3);
+                     }
+                     A1(dx,q2,q3) = s;
+                  }
+               }
+            }
+            for (int q3 = 0; q3 < NQ; q3++)
+            {
+               for (int dy = 0; dy < DL; dy++)
+               {
+                  for (int dx = 0; dx < DL; dx++)
+                  {
+                     real_t s = 0.0;
+                     for (int q2 = 0; q2 < NQ; q2++)
+                     {
+                        s += Bl(q2,dy)*A1(dx,q2,q3);
+                     }
+                     A2(dx,dy,q3) = s;
+                  }
+               }
+            }
+            for (int dz = 0; dz < DL; dz++)
+            {
+               for (int dy = 0; dy < DL; dy++)
+               {
+                  for (int dx = 0; dx < DL; dx++)
+                  {
+                     real_t s = 0.0;
+                     for (int q3 = 0; q3 < NQ; q3++)
+                     {
+                        s += Bl(q3,dz)*A2(dx,dy,q3);
+                     }
+                     Y(dx,dy,dz,le) = s;
+                  }
+               }
+            }
+         }
+      });
+   }
+}
+
+void MixedMassTranspose3D(const int NE, const int NEL, const int R,
+                          const int NQ, const int DH, const int DL,
+                          const int NB, const Vector &B_H, const Vector &B_L,
+                          const Vector &D, const Array<int> &lor_els,
+                          const Vector &x, Vector &y, Vector &work)
+{
+   const int Q = R*NQ;
+   const int wsize = Q*DH*DH + Q*Q*DH + Q*Q*Q + DL*NQ*NQ + DL*DL*NQ;
+   const auto Bh = Reshape(B_H.Read(), Q, DH);
+   const auto Bl = Reshape(B_L.Read(), NQ, DL);
+   const auto d = Reshape(D.Read(), NQ, NQ, NQ, R*R*R, NE);
+   const auto L = Reshape(lor_els.Read(), R*R*R, NE);
+   const auto X = Reshape(x.Read(), DL, DL, DL, NEL);
+   auto Y = Reshape(y.Write(), DH, DH, DH, NE);
+   real_t *w = work.Write();
+
+   for (int e0 = 0; e0 < NE; e0 += NB)
+   {
+      mfem::forall(std::min(NB, NE - e0), [=] MFEM_HOST_DEVICE (int eb)
+      {
+         const int e = e0 + eb;
+         real_t *we = w + eb*wsize;
+         auto T1 = Reshape(we, Q, DH, DH);
+         auto T2 = Reshape(we + Q*DH*DH, Q, Q, DH);
+         auto U = Reshape(we + Q*DH*DH + Q*Q*DH, Q, Q, Q);
+         auto A1 = Reshape(we + Q*DH*DH + Q*Q*DH + Q*Q*Q, NQ, NQ, DL);
+         auto A2 = Reshape(we + Q*DH*DH + Q*Q*DH + Q*Q*Q + DL*NQ*NQ,
+                           NQ, DL, DL);
+
+         // values at the quadrature points of each sub-element
+         for (int c = 0; c < R*R*R; c++)
+         {
+            const int cx = c % R, cy = (c / R) % R, cz = c / (R*R);
+            const int le = L(c,e);
+            for (int dz = 0; dz < DL; dz++)
+            {
+               for (int dy = 0; dy < DL; dy++)
+               {
+                  for (int q1 = 0; q1 < NQ; q1++)
+                  {
+                     real_t s = 0.0;
+                     for (int dx = 0; dx < DL; dx++)
+                     {
+                        s += Bl(q1,dx)*X(dx,dy,dz,le);
+                     }
+                     A2(q1,dy,dz) = s;
+                  }
+               }
+            }
+            for (int dz = 0; dz < DL; dz++)
+            {
+               for (int q2 = 0; q2 < NQ; q2++)
+               {
+                  for (int q1 = 0; q1 < NQ; q1++)
+                  {
+                     real_t s = 0.0;
+                     for (int dy = 0; dy < DL; dy++)
+                     {
+                        s += Bl(q2,dy)*A2(q1,dy,dz);
+                     }
+                     A1(q1,q2,dz) = s;
+                  }
+               }
+            }
+            for (int q3 = 0; q3 < NQ; q3++)
+            {
+               for (int q2 = 0; q2 < NQ; q2++)
+               {
+                  for (int q1 = 0; q1 < NQ; q1++)
+                  {
+                     real_t s = 0.0;
+                     for (int dz = 0; dz < DL; dz++)
+                     {
+                        s += Bl(q3,dz)*A1(q1,q2,dz);
+                     }
+                     U(cx*NQ+q1, cy*NQ+q2, cz*NQ+q3) = d(q1,q2,q3,c,e)*s;
+                  }
+               }
+            }
+         }
+
+         // integrate against the high-order basis
+         for (int dz = 0; dz < DH; dz++)
+         {
+            for (int qy = 0; qy < Q; qy++)
+            {
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  real_t s = 0.0;
+                  for (int qz = 0; qz < Q; qz++) { s += Bh(qz,dz)*U(qx,qy,qz); }
+                  T2(qx,qy,dz) = s;
+               }
+            }
+         }
+         for (int dz = 0; dz < DH; dz++)
+         {
+            for (int dy = 0; dy < DH; dy++)
+            {
+               for (int qx = 0; qx < Q; qx++)
+               {
+                  real_t s = 0.0;
+                  for (int qy = 0; qy < Q; qy++)
+                  {
+                     s += Bh(qy,dy)*T2(qx,qy,dz);
+                  }
+                  T1(qx,dy,dz) = s;
+               }
+            }
+         }
+         for (int dz = 0; dz < DH; dz++)
+         {
+            for (int dy = 0; dy < DH; dy++)
+            {
+               for (int dx = 0; dx < DH; dx++)
+               {
+                  real_t s = 0.0;
+                  for (int qx = 0; qx < Q; qx++)
+                  {
+                     s += Bh(qx,dx)*T1(qx,dy,dz);
+                  }
+                  Y(dx,dy,dz,e) = s;
+               }
+            }
+         }
+      });
+   }
+}
+
+} // anonymous namespace
+
+} // namespace TransferKernels
+
+bool L2ProjectionGridTransfer::TensorMixedMassOperator::SubElementMap(
+   const FiniteElementSpace &fes_ho_, const FiniteElementSpace &fes_lor_,
+   Array<int> &lor_els_, Vector &pts1d)
+{
+   const Mesh &mesh_ho = *fes_ho_.GetMesh();
+   const Mesh &mesh_lor = *fes_lor_.GetMesh();
+   const int dim_ = mesh_ho.Dimension();
+   const int ne_ho = mesh_ho.GetNE(), ne_lor = mesh_lor.GetNE();
+   if (ne_ho == 0 || (dim_ != 2 && dim_ != 3)) { return false; }
+   if (fes_ho_.IsVariableOrder() || fes_lor_.IsVariableOrder())
+   {
+      return false;
+   }
+   if (!dynamic_cast<const TensorBasisElement*>(fes_ho_.GetTypicalFE()) ||
+       !dynamic_cast<const TensorBasisElement*>(fes_lor_.GetTypicalFE()))
+   {
+      return false;
+   }
+
+   const Geometry::Type geom = (dim_ == 2) ? Geometry::SQUARE : Geometry::CUBE;
+   Array<Geometry::Type> geoms_ho, geoms_lor;
+   mesh_ho.GetGeometries(dim_, geoms_ho);
+   mesh_lor.GetGeometries(dim_, geoms_lor);
+   if (geoms_ho.Size() != 1 || geoms_ho[0] != geom ||
+       geoms_lor.Size() != 1 || geoms_lor[0] != geom) { return false; }
+
+   const CoarseFineTransformations &cf_tr = mesh_lor.GetRefinementTransforms();
+   if (cf_tr.embeddings.Size() != ne_lor) { return false; }
+   const DenseTensor &pmats = cf_tr.point_matrices[geom];
+   const int nref = pmats.SizeK();
+   const int r = (int) std::round(std::pow(real_t(nref), 1.0/dim_));
+   if (nref == 0 || (dim_ == 2 ? r*r : r*r*r) != nref ||
+       ne_lor != nref*ne_ho) { return false; }
+
+   // the 1D breakpoints of the sub-elements are their lower corners, and 1
+   const real_t tol = 1e-12;
+   std::vector<real_t> pts(1, 1.0);
+   for (int k = 0; k < nref; k++)
+   {
+      for (int d = 0; d < dim_; d++) { pts.push_back(pmats(d, 0, k)); }
+   }
+   std::sort(pts.begin(), pts.end());
+   pts.erase(std::unique(pts.begin(), pts.end(), [=](real_t a, real_t b)
+   { return b - a < tol; }), pts.end());
+   if ((int) pts.size() != r + 1) { return false; }
+   pts1d.SetSize(r + 1);
+   for (int i = 0; i <= r; i++) { pts1d(i) = pts[i]; }
+
+   // the sub-elements must be boxes with the orientation of the element
+   const IntegrationRule &verts = *Geometries.GetVertices(geom);
+   const int vmax = (dim_ == 2) ? 2 : 6; // the vertex (1,1) or (1,1,1)
+   Array<int> sub_elem(nref);
+   for (int k = 0; k < nref; k++)
+   {
+      int c = 0, stride = 1;
+      real_t lo[3], hi[3];
+      for (int d = 0; d < dim_; d++)
+      {
+         lo[d] = pmats(d, 0, k);
+         hi[d] = pmats(d, vmax, k);
+         int i = 0;
+         while (i < r && std::abs(pts1d(i) - lo[d]) >= tol) { i++; }
+         if (i == r || std::abs(pts1d(i+1) - hi[d]) >= tol) { return false; }
+         c += i*stride;
+         stride *= r;
+      }
+      for (int v = 0; v < verts.GetNPoints(); v++)
+      {
+         real_t ref[3];
+         verts.IntPoint(v).Get(ref, dim_);
+         for (int d = 0; d < dim_; d++)
+         {
+            const real_t x = lo[d] + (hi[d] - lo[d])*ref[d];
+            if (std::abs(pmats(d, v, k) - x) >= tol) { return false; }
+         }
+      }
+      sub_elem[k] = c;
+   }
+
+   lor_els_.SetSize(nref*ne_ho);
+   lor_els_ = -1;
+   for (int l = 0; l < ne_lor; l++)
+   {
+      const Embedding &emb = cf_tr.embeddings[l];
+      const int idx = sub_elem[emb.matrix] + nref*emb.parent;
+      if (lor_els_[idx] >= 0) { return false; }
+      lor_els_[idx] = l;
+   }
+   return true;
+}
+
+bool L2ProjectionGridTransfer::TensorMixedMassOperator::Supports(
+   const FiniteElementSpace &fes_ho_, const FiniteElementSpace &fes_lor_)
+{
+   Array<int> lor_els_;
+   Vector pts1d;
+   return SubElementMap(fes_ho_, fes_lor_, lor_els_, pts1d);
+}
+
+L2ProjectionGridTransfer::TensorMixedMassOperator::TensorMixedMassOperator(
+   const FiniteElementSpace &fes_ho_, const FiniteElementSpace &fes_lor_)
+   : Operator(fes_lor_.GetVSize(), fes_ho_.GetVSize()),
+     fes_ho(fes_ho_), fes_lor(fes_lor_),
+     dim(fes_ho_.GetMesh()->Dimension()), nel_ho(fes_ho_.GetNE())
+{
+   MFEM_VERIFY(fes_ho.GetVDim() == 1 && fes_lor.GetVDim() == 1,
+               "scalar spaces are expected");
+   Vector pts1d;
+   MFEM_VERIFY(SubElementMap(fes_ho, fes_lor, lor_els, pts1d),
+               "the spaces are not supported");
+   nref1d = pts1d.Size() - 1;
+
+   const FiniteElement &fe_ho = *fes_ho.GetTypicalFE();
+   const FiniteElement &fe_lor = *fes_lor.GetTypicalFE();
+   const Poly_1D::Basis &basis_ho =
+      dynamic_cast<const TensorBasisElement&>(fe_ho).GetBasis1D();
+   const Poly_1D::Basis &basis_lor =
+      dynamic_cast<const TensorBasisElement&>(fe_lor).GetBasis1D();
+   dofs1d_ho = fe_ho.GetOrder() + 1;
+   dofs1d_lor = fe_lor.GetOrder() + 1;
+
+   // same quadrature as in MixedMassEA()
+   const Geometry::Type geom = fe_ho.GetGeomType();
+   const int order = fe_lor.GetOrder() + fe_ho.GetOrder() +
+                     fes_lor.GetElementTransformation(0)->OrderW();
+   const IntegrationRule &ir = IntRules.Get(geom, order);
+   const IntegrationRule &ir1d = IntRules.Get(Geometry::SEGMENT, order);
+   nq1d = ir1d.GetNPoints();
+   const int nqe = ir.GetNPoints();
+   MFEM_VERIFY(nqe == (dim == 2 ? nq1d*nq1d : nq1d*nq1d*nq1d),
+               "tensor-product quadrature expected");
+
+   // 1D bases: the high-order one at the images of the quadrature points of
+   // all sub-elements
+   const int nq = nref1d*nq1d;
+   B_H.SetSize(nq*dofs1d_ho);
+   B_L.SetSize(nq1d*dofs1d_lor);
+   Vector shape_ho(dofs1d_ho), shape_lor(dofs1d_lor);
+   for (int i = 0; i < nref1d; i++)
+   {
+      for (int q = 0; q < nq1d; q++)
+      {
+         const real_t x = pts1d(i) + (pts1d(i+1) - pts1d(i))*ir1d.IntPoint(q).x;
+         basis_ho.Eval(x, shape_ho);
+         for (int j = 0; j < dofs1d_ho; j++)
+         {
+            B_H(i*nq1d + q + nq*j) = shape_ho(j);
+         }
+      }
+   }
+   for (int q = 0; q < nq1d; q++)
+   {
+      basis_lor.Eval(ir1d.IntPoint(q).x, shape_lor);
+      for (int j = 0; j < dofs1d_lor; j++) { B_L(q + nq1d*j) = shape_lor(j); }
+   }
+
+   // quadrature data
+   const int nref = lor_els.Size()/nel_ho;
+   const GeometricFactors *geom_facts = fes_lor.GetMesh()->GetGeometricFactors(
+                                           ir, GeometricFactors::DETERMINANTS);
+   D.SetSize(nqe*nref*nel_ho);
+   const auto W = Reshape(ir.GetWeights().Read(), nqe);
+   const auto J = Reshape(geom_facts->detJ.Read(), nqe, fes_lor.GetNE());
+   const auto L = Reshape(lor_els.Read(), nref, nel_ho);
+   auto d_D = Reshape(D.Write(), nqe, nref, nel_ho);
+   mfem::forall(nqe*nref*nel_ho, [=] MFEM_HOST_DEVICE (int tid)
+   {
+      const int q = tid % nqe;
+      const int c = (tid / nqe) % nref;
+      const int e = tid / (nqe*nref);
+      d_D(q, c, e) = W(q)*J(q, L(c, e));
+   });
+
+   // scratch space, limited to about 64 MB for large meshes
+   const int dh = dofs1d_ho, dl = dofs1d_lor;
+   const int wsize = (dim == 2) ?
+                     nq*dh + nq*nq + dl*nq1d :
+                     nq*dh*dh + nq*nq*dh + nq*nq*nq + dl*nq1d*nq1d + dl*dl*nq1d;
+   batch = std::max(1, std::min(nel_ho, (1 << 23)/wsize));
+   work.SetSize(batch*wsize);
+   work.UseDevice(true);
+
+   const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+   x_e.SetSize(fes_ho.GetElementRestriction(ordering)->Height());
+   y_e.SetSize(fes_lor.GetElementRestriction(ordering)->Height());
+   x_e.UseDevice(true);
+   y_e.UseDevice(true);
+}
+
+void L2ProjectionGridTransfer::TensorMixedMassOperator::Mult(
+   const Vector &x, Vector &y) const
+{
+   const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+   const int nel_lor = fes_lor.GetNE();
+   fes_ho.GetElementRestriction(ordering)->Mult(x, x_e);
+   if (dim == 2)
+   {
+      TransferKernels::MixedMass2D(nel_ho, nel_lor, nref1d, nq1d, dofs1d_ho,
+                                   dofs1d_lor, batch, B_H, B_L, D, lor_els,
+                                   x_e, y_e, work);
+   }
+   else
+   {
+      TransferKernels::MixedMass3D(nel_ho, nel_lor, nref1d, nq1d, dofs1d_ho,
+                                   dofs1d_lor, batch, B_H, B_L, D, lor_els,
+                                   x_e, y_e, work);
+   }
+   fes_lor.GetElementRestriction(ordering)->MultTranspose(y_e, y);
+}
+
+void L2ProjectionGridTransfer::TensorMixedMassOperator::MultTranspose(
+   const Vector &x, Vector &y) const
+{
+   const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+   const int nel_lor = fes_lor.GetNE();
+   fes_lor.GetElementRestriction(ordering)->Mult(x, y_e);
+   if (dim == 2)
+   {
+      TransferKernels::MixedMassTranspose2D(nel_ho, nel_lor, nref1d, nq1d,
+                                            dofs1d_ho, dofs1d_lor, batch, B_H,
+                                            B_L, D, lor_els, y_e, x_e, work);
+   }
+   else
+   {
+      TransferKernels::MixedMassTranspose3D(nel_ho, nel_lor, nref1d, nq1d,
+                                            dofs1d_ho, dofs1d_lor, batch, B_H,
+                                            B_L, D, lor_els, y_e, x_e, work);
+   }
+   fes_ho.GetElementRestriction(ordering)->MultTranspose(x_e, y);
+}
+
 L2ProjectionGridTransfer::~L2ProjectionGridTransfer()
 {
    delete F;
@@ -2023,7 +2708,7 @@ void L2ProjectionGridTransfer::BuildF()
       if (!Parallel())
       {
          F = new L2ProjectionH1Space(dom_fes, ran_fes,
-                                     use_ea, d_mt);
+                                     use_ea, d_mt, use_pa);
       }
       else
       {
@@ -2033,7 +2718,7 @@ void L2ProjectionGridTransfer::BuildF()
          const mfem::ParFiniteElementSpace& ran_pfes =
             static_cast<mfem::ParFiniteElementSpace&>(ran_fes);
          F = new L2ProjectionH1Space(dom_pfes, ran_pfes,
-                                     use_ea, d_mt);
+                                     use_ea, d_mt, use_pa);
 #endif
       }
    }
@@ -41,6 +41,7 @@ protected:
    OperatorHandle bw_t_oper; ///< Backward true-dof operator
 
    bool use_ea;
+   bool use_pa;
 
    MemoryType d_mt;
 
@@ -75,6 +76,11 @@ public:
        transfers, L2, H1 FEM spaces currently supported */
    void UseEA(bool use_ea_) { use_ea = use_ea_;}
 
+   /** Uses matrix-free, sum-factorized versions for L2Projection transfers of
+       H1 spaces with tensor-product elements on uniformly refined meshes. Other
+       spaces use the versions selected with UseEA(). */
+   void UsePA(bool use_pa_) { use_pa = use_pa_; }
+
    /** Set memory type for large data structures */
    void SetMemType(MemoryType d_mt_) {d_mt = d_mt_;}
 
@@ -270,6 +276,58 @@ public:
       void MultTranspose(const Vector& x, Vector& y) const;
    };
 
+   /** @brief Sum-factorized mixed mass operator M_LH between scalar H1 spaces
+       of tensor-product elements.
+
+       The images of the quadrature points of the LOR sub-elements in the
+       reference space of a high-order element form a tensor-product grid, so
+       the high-order basis functions are evaluated at all of them with 1D
+       contractions, as in the partially assembled MassIntegrator. Only the
+       1D bases and the quadrature weights scaled by the Jacobian determinants
+       of the LOR elements are stored, instead of the dense element matrices
+       of H1SpaceMixedMassOperator. The sub-elements must be (possibly
+       non-uniformly spaced) boxes aligned with the high-order element, as
+       created by Mesh::MakeRefined(), see Supports(). */
+   class TensorMixedMassOperator : public Operator
+   {
+   protected:
+      const FiniteElementSpace &fes_ho;
+      const FiniteElementSpace &fes_lor;
+      int dim, nel_ho;
+      int nref1d; ///< number of sub-elements in each direction
+      int nq1d; ///< number of 1D quadrature points in a sub-element
+      int dofs1d_ho, dofs1d_lor;
+      /// High-order 1D basis at the quadrature points of all sub-elements
+      Vector B_H;
+      /// Low-order 1D basis at the quadrature points of a sub-element
+      Vector B_L;
+      /// Quadrature weights times Jacobian determinants of the LOR elements
+      Vector D;
+      /// LOR element of each sub-element of each high-order element
+      Array<int> lor_els;
+      /// Number of high-order elements processed at once, see #work
+      int batch;
+      mutable Vector x_e, y_e, work;
+
+      /** Find the sub-element of each LOR element, stored in @a lor_els_, and
+          the 1D breakpoints of the sub-elements in @a pts1d. Returns false if
+          the refinement is not supported. */
+      static bool SubElementMap(const FiniteElementSpace &fes_ho_,
+                                const FiniteElementSpace &fes_lor_,
+                                Array<int> &lor_els_, Vector &pts1d);
+
+   public:
+      TensorMixedMassOperator(const FiniteElementSpace &fes_ho_,
+                              const FiniteElementSpace &fes_lor_);
+
+      /// Returns true if the operator can be constructed for the given spaces.
+      static bool Supports(const FiniteElementSpace &fes_ho_,
+                           const FiniteElementSpace &fes_lor_);
+
+      void Mult(const Vector& x, Vector& y) const override;
+      void MultTranspose(const Vector& x, Vector& y) const override;
+   };
+
    /** Class for projection operator between a L2 high-order finite element
        space on a coarse mesh, and a L2 low-order finite element space on a
        refined mesh (LOR). */
@@ -352,17 +410,24 @@ public:
    class L2ProjectionH1Space : public L2Projection
    {
       const bool use_ea;
+      const bool use_pa;
 
    public:
+      /** If @a use_pa_ is true and the spaces are supported by
+          TensorMixedMassOperator, the mixed mass matrix is not assembled and
+          all operators, including the conjugate gradient solver of the
+          prolongation, are matrix-free. Otherwise, @a use_pa_ is ignored. */
       L2ProjectionH1Space(const FiniteElementSpace &fes_ho_,
                           const FiniteElementSpace &fes_lor_,
                           const bool use_ea_,
-                          MemoryType d_mt_ = Device::GetHostMemoryType());
+                          MemoryType d_mt_ = Device::GetHostMemoryType(),
+                          const bool use_pa_ = false);
 #ifdef MFEM_USE_MPI
       L2ProjectionH1Space(const ParFiniteElementSpace &pfes_ho_,
                           const ParFiniteElementSpace &pfes_lor_,
                           const bool use_ea_,
-                          MemoryType d_mt_ = Device::GetHostMemoryType());
+                          MemoryType d_mt_ = Device::GetHostMemoryType(),
+                          const bool use_pa_ = false);
 #endif
       /// Same as above but assembles action of R through 4 parts:
       ///   ( )  inv( lumped(M_L) ), which is a diagonal matrix (essentially a vector)
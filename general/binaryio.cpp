@@ -12,6 +12,12 @@
 #include "binaryio.hpp"
 #include "error.hpp"
 
+#ifdef MFEM_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+
 namespace mfem
 {
 namespace bin_io
@@ -102,5 +108,73 @@ void DecodeBase64(const char *src, size_t len, std::vector<char> &buf)
 
 size_t NumBase64Chars(size_t nbytes) { return ((4*nbytes/3) + 3) & ~3; }
 
+void WriteBlocks(std::ostream &out, const void *bytes, size_t nbytes,
+                 int compression_level)
+{
+   const char *in = static_cast<const char *>(bytes);
+   if (compression_level == 0)
+   {
+      write<int64_t>(out, 0);
+      out.write(in, nbytes);
+      return;
+   }
+#ifdef MFEM_USE_ZLIB
+   MFEM_ASSERT(compression_level >= -1 && compression_level <= 9,
+               "Compression level must be between -1 and 9 (inclusive).");
+   const size_t bs = compression_block_size;
+   const int64_t nblocks = (nbytes + bs - 1) / bs;
+   write<int64_t>(out, nblocks);
+   std::vector<Bytef> buf(compressBound(uLong(std::min(nbytes, bs))));
+   for (int64_t b = 0; b < nblocks; b++)
+   {
+      const size_t offset = b*bs, len = std::min(nbytes - offset, bs);
+      uLongf buf_sz = buf.size();
+      const int err = compress2(buf.data(), &buf_sz,
+                                reinterpret_cast<const Bytef *>(in + offset),
+                                uLong(len), compression_level);
+      MFEM_VERIFY(err == Z_OK, "zlib compression error: " << err);
+      write<int64_t>(out, buf_sz);
+      out.write(reinterpret_cast<const char *>(buf.data()), buf_sz);
+   }
+#else
+   MFEM_ABORT("MFEM must be compiled with ZLib support to output "
+              "compressed binary data.");
+#endif
+}
+
+void ReadBlocks(std::istream &in, void *bytes, size_t nbytes)
+{
+   char *out = static_cast<char *>(bytes);
+   const int64_t nblocks = read<int64_t>(in);
+   if (nblocks == 0)
+   {
+      in.read(out, nbytes);
+      MFEM_VERIFY(in, "unexpected end of binary data");
+      return;
+   }
+#ifdef MFEM_USE_ZLIB
+   const size_t bs = compression_block_size;
+   MFEM_VERIFY(nblocks == int64_t((nbytes + bs - 1) / bs),
+               "invalid compressed binary data");
+   std::vector<Bytef> buf;
+   for (int64_t b = 0; b < nblocks; b++)
+   {
+      const size_t offset = b*bs, len = std::min(nbytes - offset, bs);
+      const int64_t buf_sz = read<int64_t>(in);
+      buf.resize(buf_sz);
+      in.read(reinterpret_cast<char *>(buf.data()), buf_sz);
+      MFEM_VERIFY(in, "unexpected end of binary data");
+      uLongf out_sz = len;
+      const int err = uncompress(reinterpret_cast<Bytef *>(out + offset),
+                                 &out_sz, buf.data(), uLong(buf_sz));
+      MFEM_VERIFY(err == Z_OK && out_sz == len,
+                  "zlib decompression error: " << err);
+   }
+#else
+   MFEM_ABORT("MFEM must be compiled with ZLib support to read "
+              "compressed binary data.");
+#endif
+}
+
 } // namespace mfem::bin_io
 } // namespace mfem
@@ -13,7 +13,9 @@
 #define MFEM_BINARYIO
 
 #include "../config/config.hpp"
+#include "error.hpp"
 
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -58,6 +60,52 @@ void AppendBytes(std::vector<char> &vec, const T &val)
    vec.insert(vec.end(), ptr, ptr + sizeof(T));
 }
 
+/// Alignment, in bytes, of the arrays written with AppendArray().
+constexpr size_t array_alignment = 8;
+
+/** @brief Append @a n values from @a data to @a vec, after zero padding which
+    aligns them to a multiple of array_alignment bytes from the beginning of
+    @a vec. */
+template <typename T>
+void AppendArray(std::vector<char> &vec, const T *data, size_t n)
+{
+   const size_t pos = (vec.size() + array_alignment - 1) /
+                      array_alignment * array_alignment;
+   vec.resize(pos + n*sizeof(T), 0);
+   if (n) { std::memcpy(vec.data() + pos, data, n*sizeof(T)); }
+}
+
+/** @brief Read @a n values, written with AppendArray(), from the buffer
+    @a buf of size @a size, starting at the position @a pos, which is advanced
+    past the values. */
+template <typename T>
+void ReadArray(const char *buf, size_t size, size_t &pos, T *data, size_t n)
+{
+   pos = (pos + array_alignment - 1) / array_alignment * array_alignment;
+   MFEM_VERIFY(pos + n*sizeof(T) <= size, "unexpected end of binary data");
+   if (n) { std::memcpy(data, buf + pos, n*sizeof(T)); }
+   pos += n*sizeof(T);
+}
+
+/// Size, in bytes, of the blocks compressed independently by WriteBlocks().
+constexpr size_t compression_block_size = size_t(1) << 22;
+
+/** @brief Write the buffer @a bytes of length @a nbytes to the binary stream
+    @a out, compressing it with zlib when @a compression_level is not zero.
+
+    The data is preceded by the int64_t number of blocks, which is 0 when the
+    data is not compressed. Otherwise, the data is split in blocks of size
+    compression_block_size which are compressed independently, each one
+    preceded by its int64_t compressed size, so that the additional memory
+    needed for compression is bounded by the block size. Compression requires
+    MFEM to be built with MFEM_USE_ZLIB = YES. */
+void WriteBlocks(std::ostream &out, const void *bytes, size_t nbytes,
+                 int compression_level);
+
+/** @brief Read @a nbytes, written with WriteBlocks(), from the binary stream
+    @a in into the buffer @a bytes. */
+void ReadBlocks(std::istream &in, void *bytes, size_t nbytes);
+
 /// @brief Given a buffer @a bytes of length @a nbytes, encode the data in
 /// base-64 format, and write the encoded data to the output stream @a out.
 void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes);
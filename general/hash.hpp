@@ -26,8 +26,7 @@ namespace mfem
  */
 struct Hashed2
 {
-   int p1, p2;
-   int next;
+   int p1, p2; // NOTE: p1 = -1 marks an unused item
 };
 
 /** A concept for items that should be used in HashTable and be accessible by
@@ -36,7 +35,6 @@ struct Hashed2
 struct Hashed4
 {
    int p1, p2, p3; // NOTE: p4 is neither hashed nor stored
-   int next;
 };
 
 
@@ -72,11 +70,14 @@ struct Hashed4
  *   The data structure and implementation is based on a BlockArray<T> which
  *   provides an efficient item storage that avoids heap fragmentation, and
  *   index-based item access. The hash table implemented on top of the
- *   BlockArray provides fast associative (key -> value) access by grouping
- *   items into bins (buckets) of O(1) size.
+ *   BlockArray provides fast associative (key -> value) access by open
+ *   addressing: each slot of the table stores the id of an item and a one byte
+ *   tag with 7 bits of the 64-bit hash of its key. The slots are probed in
+ *   groups of 6, stored in 32 bytes, whose tags are compared to the tag of the
+ *   key in parallel within a 64-bit word, so the items (stored elsewhere in
+ *   memory) are only accessed to confirm a matching tag.
  *   - "id" denotes the index of an item in the underlying BlockArray<T>,
- *   - "idx" denotes the index of a bin, determined by hashing a key with
- *     the function `Hash`.
+ *   - "pos" denotes the index of a slot in the table.
  */
 template<typename T>
 class HashTable : public BlockArray<T>
@@ -89,8 +90,9 @@ public:
 
        @param[in] block_size The size of the storage blocks of the underlying
                              BlockArray<T>.
-       @param[in] init_hash_size The initial size of the hash table. Must be
-                                 a power of 2. */
+       @param[in] init_hash_size The initial size of the hash table, which
+                                 has init_hash_size/8 groups of slots. Must
+                                 be a power of 2. */
    HashTable(int block_size = 16*1024, int init_hash_size = 32*1024);
    /// @brief Deep copy
    HashTable(const HashTable& other);
@@ -232,7 +234,7 @@ public:
        @param[in] id Index of the item in the underlying BlockArray<T>.
 
        @warning It is assumed that 0 <= id < NumIds(). */
-   bool IdExists(int id) const { return (Base::At(id).next != -2); }
+   bool IdExists(int id) const { return (Base::At(id).p1 != -1); }
 
    /** @brief Remove an item from the hash table.
 
@@ -290,7 +292,7 @@ public:
    /// @brief Write details of the memory usage to the mfem output stream.
    void PrintMemoryDetail() const;
 
-   /// @brief Print a histogram of bin sizes for debugging purposes.
+   /// @brief Print a histogram of probe lengths for debugging purposes.
    void PrintStats() const;
 
    class iterator : public Base::iterator
@@ -302,13 +304,13 @@ public:
       iterator() { }
       iterator(const base &it) : base(it)
       {
-         while (base::good() && (*this)->next == -2) { base::next(); }
+         while (base::good() && (*this)->p1 == -1) { base::next(); }
       }
 
    public:
       iterator &operator++()
       {
-         while (base::next(), base::good() && (*this)->next == -2) { }
+         while (base::next(), base::good() && (*this)->p1 == -1) { }
          return *this;
       }
    };
@@ -322,13 +324,13 @@ public:
       const_iterator() { }
       const_iterator(const base &it) : base(it)
       {
-         while (base::good() && (*this)->next == -2) { base::next(); }
+         while (base::good() && (*this)->p1 == -1) { base::next(); }
       }
 
    public:
       const_iterator &operator++()
       {
-         while (base::next(), base::good() && (*this)->next == -2) { }
+         while (base::next(), base::good() && (*this)->p1 == -1) { }
          return *this;
       }
    };
@@ -342,114 +344,197 @@ public:
    const_iterator cend() const { return const_iterator(); }
 
 protected:
-   /** The hash table: each bin is a linked list of items. For each non-empty
-       bin, this arrays stores the 'id' of the first item in the list, or -1
-       if the bin is empty. */
-   int* table;
-
-   /** mask = table_size-1. Used for fast modulo operation in Hash(), to wrap
-       the raw hashed index around the current table size (which must be a power
-       of two). */
+   /// Number of slots probed at once. Their tags are the first bytes of a
+   /// 64-bit word, whose remaining bytes are PAD.
+   static constexpr int GROUP = 6;
+   static constexpr unsigned char EMPTY = 0x80;
+   static constexpr unsigned char DELETED = 0xFE;
+   static constexpr unsigned char PAD = 0xFF;
+
+   /** A group of slots, whose tags and item ids fill 32 bytes, so that a
+       probe touches a single cache line. */
+   struct alignas(32) Group
+   {
+      /// Tags of the slots: EMPTY, DELETED or 7 bits of the hash of the key
+      unsigned char tag[8];
+      /// Ids of the items in the slots with a valid tag
+      int id[GROUP];
+   };
+
+   /// The table: mask+1 groups of slots, aligned to 32 bytes within the
+   /// allocated memory @a table_mem
+   Group* groups;
+   char* table_mem;
+
+   /** mask = number of groups-1. Used for fast modulo operation, to wrap
+       the hashed group index around the current table size (the number of
+       groups must be a power of two). */
    int mask;
 
+   /** Number of EMPTY slots that can still be used before the table is
+       rehashed. Keeps the fraction of non-empty slots (items plus deleted
+       slots) at most 7/8, so each probe sequence ends in an EMPTY slot. */
+   int growth_left;
+
    /** List of deleted items in the BlockArray<T>. New items are created with
        these ids first, before they are appended to the block array. */
    Array<int> unused;
 
+   /// Tag of the slot @a pos.
+   unsigned char &Tag(int pos) { return groups[pos/GROUP].tag[pos%GROUP]; }
+   unsigned char Tag(int pos) const { return groups[pos/GROUP].tag[pos%GROUP]; }
+
+   /// Item id of the slot @a pos.
+   int &Slot(int pos) { return groups[pos/GROUP].id[pos%GROUP]; }
+   int Slot(int pos) const { return groups[pos/GROUP].id[pos%GROUP]; }
+
+   /// Mix the bits of the compact 64-bit key @a k (splitmix64 finalizer).
+   static inline std::uint64_t Mix(std::uint64_t k)
+   {
+      k ^= k >> 30;
+      k *= 0xbf58476d1ce4e5b9ULL;
+      k ^= k >> 27;
+      k *= 0x94d049bb133111ebULL;
+      k ^= k >> 31;
+      return k;
+   }
+
    /** @brief hash function for Hashed2 items.
 
        @param[in] p1 First part of the key.
        @param[in] p2 Second part of the key.
-       @return The hash key "idx" identifying a bin/bucket.
+       @return The 64-bit hash of the key packed into 64 bits.
 
-       NOTE: the constants are arbitrary
        @warning This method should only be called if T inherits from Hashed2. */
-   inline int Hash(size_t p1, size_t p2) const
-   { return (984120265ul*p1 + 125965121ul*p2) & mask; }
+   static inline std::uint64_t Hash(int p1, int p2)
+   {
+      return Mix((std::uint64_t(std::uint32_t(p1)) << 32) | std::uint32_t(p2));
+   }
 
    /** @brief hash function for Hashed4 items.
 
        @param[in] p1 First part of the key.
        @param[in] p2 Second part of the key.
        @param[in] p3 Third part of the key.
-       @return The hash key "idx" identifying a bin/bucket.
+       @return The 64-bit hash of the key.
 
-       NOTE: The constants are arbitrary.
        NOTE: p4 is not hashed nor stored as p1, p2, p3 identify a face uniquely.
        @warning This method should only be called if T inherits from Hashed4. */
-   inline int Hash(size_t p1, size_t p2, size_t p3) const
-   { return (984120265ul*p1 + 125965121ul*p2 + 495698413ul*p3) & mask; }
+   static inline std::uint64_t Hash(int p1, int p2, int p3)
+   {
+      return Mix(Hash(p1, p2) ^ std::uint32_t(p3));
+   }
 
    // Delete() and Reparent() use one of these:
    /// @brief Hash function for items of type T that inherit from Hashed2.
-   inline int Hash(const Hashed2& item) const
+   static inline std::uint64_t Hash(const Hashed2& item)
    { return Hash(item.p1, item.p2); }
 
    /// @brief Hash function for items of type T that inherit from Hashed4.
-   inline int Hash(const Hashed4& item) const
+   static inline std::uint64_t Hash(const Hashed4& item)
    { return Hash(item.p1, item.p2, item.p3); }
 
-   /** @brief Search the index of the item associated to the key (p1,p2)
-       starting from the item with index @a id.
+   /// Return the tags of the group of slots starting at @a c, as a 64-bit
+   /// word with the tag of c[i] in the byte i.
+   static inline std::uint64_t LoadGroup(const unsigned char *c)
+   {
+      std::uint64_t w = 0;
+      for (int i = 0; i < 8; i++) { w |= std::uint64_t(c[i]) << (8*i); }
+      return w;
+   }
 
-       @param[in] id Index of the item in the underlying BlockArray<T>.
-       @param[in] p1 First part of the key.
-       @param[in] p2 Second part of the key.
-       @return The index "id" of the key in the BlockArray<T>.
+   /** Return a word with the high bit set in the bytes of @a w equal to
+       @a tag. There may be false positives (only in bytes above a true match),
+       so the candidates must be verified. */
+   static inline std::uint64_t MatchTag(std::uint64_t w, unsigned char tag)
+   {
+      const std::uint64_t lsbs = 0x0101010101010101ULL;
+      const std::uint64_t x = w ^ (lsbs * tag);
+      return (x - lsbs) & ~x & (lsbs << 7);
+   }
 
-       @warning This method should only be called if T inherits from Hashed2. */
-   int SearchList(int id, int p1, int p2) const;
+   /// Return a word with the high bit set in the EMPTY bytes of @a w.
+   static inline std::uint64_t MatchEmpty(std::uint64_t w)
+   { return w & (~w << 6) & 0x8080808080808080ULL; }
 
-   /** @brief Search the index of the item associated to the key (p1,p2,p3,(p4))
-       starting from the item with index @a id.
+   /// Return a word with the high bit set in the EMPTY or DELETED bytes of
+   /// @a w.
+   static inline std::uint64_t MatchFree(std::uint64_t w)
+   { return w & (~w << 7) & 0x8080808080808080ULL; }
 
-       @param[in] id Index of the item in the underlying BlockArray<T>.
-       @param[in] p1 First part of the key.
-       @param[in] p2 Second part of the key.
-       @param[in] p3 Third part of the key.
-       @return The index "id" of the key in the BlockArray<T>.
+   /// Return the index of the lowest byte with the high bit set in @a m != 0.
+   static inline int LowestByte(std::uint64_t m)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(m) >> 3;
+#else
+      int i = 0;
+      for (; !(m & 0x80); m >>= 8) { i++; }
+      return i;
+#endif
+   }
 
-       @warning This method should only be called if T inherits from Hashed4. */
-   int SearchList(int id, int p1, int p2, int p3) const;
+   /** @brief Search the slot of the item for which @a match(id) is true,
+       among the slots whose tag matches the hash @a h.
+
+       The groups are probed in the triangular sequence g, g+1, g+3, g+6, ...,
+       which visits all groups, since their number is a power of two. The
+       search stops at the first group with an EMPTY slot.
+
+       @return The position of the slot in the table, or -1 if not found. */
+   template <typename Match>
+   inline int Probe(std::uint64_t h, Match match) const;
 
-   /** @brief Insert the item 'id' into bin 'idx'.
+   /** @brief Search the slot of the item associated to the key (p1,p2).
 
-       @param[in] idx The bin/bucket index.
-       @param[in] id The index of the item in the BlockArray<T>.
-       @param[in] item The item to insert at the beginning of the linked list.
+       @warning This method should only be called if T inherits from Hashed2. */
+   int FindSlot(std::uint64_t h, int p1, int p2) const;
+
+   /** @brief Search the slot of the item associated to the key (p1,p2,p3).
+
+       @warning This method should only be called if T inherits from Hashed4. */
+   int FindSlot(std::uint64_t h, int p1, int p2, int p3) const;
 
-       @warning The method only works with bin 'idx' and does not check the
-                overall fill factor of the hash table. If appropriate,
-                use CheckRehash() for that. */
-   inline void Insert(int idx, int id, T &item);
+   /** @brief Return the id of an unused item, appending a new item to the
+       BlockArray if there is none. */
+   inline int NewId();
 
-   /** @brief Unlink an item @a id from the linked list of bin @a idx.
+   /** @brief Insert the item 'id' with hash @a h in the first free slot of
+       its probe sequence.
 
-       @param[in] idx The bin/bucket index.
-       @param[in] id The index of the item in the BlockArray<T>.
+       @warning The method does not check the overall fill factor of the hash
+                table. Call CheckRehash() before the key of the item is set. */
+   inline void Insert(std::uint64_t h, int id);
+
+   /** @brief Mark the slot of item @a id, with hash @a h, as DELETED.
 
        @warning The method aborts if the item is not found. */
-   void Unlink(int idx, int id);
+   void Unlink(std::uint64_t h, int id);
 
-   /** @brief Check table fill factor and resize if necessary.
+   /** @brief Make sure the next Insert() can use an EMPTY slot.
 
-       The method checks the average size of the bins (i.e., the fill factor).
-       If the fill factor is > 2, the table is enlarged (see DoRehash()). */
+       If there are no EMPTY slots left to use, the table is rehashed (see
+       DoRehash()). */
    inline void CheckRehash();
 
-   /** @brief Double the size of the hash table (i.e., double the number of bins)
-       and reinsert all items into the new bins.
+   /** @brief Reinsert all items into a table with (at most) 7/16 of its slots
+       used, which also removes the DELETED slots. The table size is doubled
+       as many times as necessary.
 
        NOTE: Rehashing is computationally expensive (O(N) in the number of items),
        but since it is only done rarely (when the number of items doubles),
        the amortized complexity of inserting an item is still O(1). */
    void DoRehash();
 
-   /** @brief Return the size of the bin "idx".
+   /// Allocate the table with @a num_groups groups of EMPTY slots.
+   void AllocTable(int num_groups);
+
+   /// Mark all slots EMPTY.
+   void ClearTable();
 
-       @param[in] idx The index of the bin.
-       @return The size of the bin. */
-   int BinSize(int idx) const;
+   /** @brief Return the number of probed groups needed to find the item in
+       the slot @a pos. */
+   int ProbeLength(int pos) const;
 };
 
 
@@ -530,6 +615,33 @@ public:
    std::string GetHash() const;
 };
 
+/** @brief Return a fast, non-cryptographic 64-bit hash of the sequence of @a n
+    integers @a ints, combined with @a seed.
+
+    Unlike HashFunction, this does not require GnuTLS. It is intended for cheap
+    detection of changes in integer data, e.g. the sparsity pattern (I and J
+    arrays) of a matrix. The result depends on the integer values only, not on
+    their type. */
+template <typename int_type>
+inline std::uint64_t HashInts64(const int_type *ints, std::size_t n,
+                                std::uint64_t seed = 0)
+{
+   // FNV-1a over whole integers, followed by the splitmix64 finalizer
+   std::uint64_t h = 14695981039346656037ULL ^ seed;
+   for (std::size_t i = 0; i < n; i++)
+   {
+      h ^= static_cast<std::uint64_t>(ints[i]);
+      h *= 1099511628211ULL;
+   }
+   h ^= static_cast<std::uint64_t>(n);
+   h ^= h >> 30;
+   h *= 0xbf58476d1ce4e5b9ULL;
+   h ^= h >> 27;
+   h *= 0x94d049bb133111ebULL;
+   h ^= h >> 31;
+   return h;
+}
+
 
 // implementation
 
@@ -537,30 +649,51 @@ template<typename T>
 HashTable<T>::HashTable(int block_size, int init_hash_size)
    : Base(block_size)
 {
-   mask = init_hash_size-1;
-   MFEM_VERIFY(!(init_hash_size & mask), "init_size must be a power of two.");
-
-   table = new int[init_hash_size];
-   for (int i = 0; i < init_hash_size; i++)
-   {
-      table[i] = -1;
-   }
+   MFEM_VERIFY(!(init_hash_size & (init_hash_size-1)),
+               "init_size must be a power of two.");
+   AllocTable(std::max(init_hash_size/8, 1));
 }
 
 template<typename T>
 HashTable<T>::HashTable(const HashTable& other)
-   : Base(other), mask(other.mask)
+   : Base(other)
 {
-   int size = mask+1;
-   table = new int[size];
-   memcpy(table, other.table, size*sizeof(int));
+   AllocTable(other.mask+1);
+   memcpy(groups, other.groups, (mask+1)*sizeof(Group));
+   growth_left = other.growth_left;
    other.unused.Copy(unused);
 }
 
 template<typename T>
 HashTable<T>::~HashTable()
 {
-   delete [] table;
+   delete [] table_mem;
+}
+
+template<typename T>
+void HashTable<T>::AllocTable(int num_groups)
+{
+   // allocate with 'new char[]' instead of 'new Group[]', which does not
+   // support extended alignment before C++17
+   const std::size_t align = alignof(Group);
+   table_mem = new char[num_groups*sizeof(Group) + align];
+   groups = reinterpret_cast<Group*>(
+               table_mem + (align - reinterpret_cast<std::uintptr_t>(table_mem)
+                            % align) % align);
+   mask = num_groups-1;
+   ClearTable();
+}
+
+template<typename T>
+void HashTable<T>::ClearTable()
+{
+   for (int g = 0; g <= mask; g++)
+   {
+      memset(groups[g].tag, EMPTY, GROUP);
+      memset(groups[g].tag + GROUP, PAD, 8 - GROUP);
+   }
+   const int num_slots = (mask+1)*GROUP;
+   growth_left = num_slots*7/8;
 }
 
 namespace internal
@@ -608,15 +741,8 @@ inline T* HashTable<T>::Get(int p1, int p2, int p3, int p4)
 }
 
 template<typename T>
-int HashTable<T>::GetId(int p1, int p2)
+inline int HashTable<T>::NewId()
 {
-   // search for the item in the hashtable
-   if (p1 > p2) { std::swap(p1, p2); }
-   int idx = Hash(p1, p2);
-   int id = SearchList(table[idx], p1, p2);
-   if (id >= 0) { return id; }
-
-   // not found - use an unused item or create a new one
    int new_id;
    if (unused.Size())
    {
@@ -627,13 +753,27 @@ int HashTable<T>::GetId(int p1, int p2)
    {
       new_id = Base::Append();
    }
+   return new_id;
+}
+
+template<typename T>
+int HashTable<T>::GetId(int p1, int p2)
+{
+   // search for the item in the hashtable
+   if (p1 > p2) { std::swap(p1, p2); }
+   const std::uint64_t h = Hash(p1, p2);
+   int pos = FindSlot(h, p1, p2);
+   if (pos >= 0) { return Slot(pos); }
+
+   // not found - use an unused item or create a new one
+   CheckRehash();
+   int new_id = NewId();
    T& item = Base::At(new_id);
    item.p1 = p1;
    item.p2 = p2;
 
    // insert into hashtable
-   Insert(idx, new_id, item);
-   CheckRehash();
+   Insert(h, new_id);
 
    return new_id;
 }
@@ -643,29 +783,20 @@ int HashTable<T>::GetId(int p1, int p2, int p3, int p4)
 {
    // search for the item in the hashtable
    internal::sort4_ext(p1, p2, p3, p4);
-   int idx = Hash(p1, p2, p3);
-   int id = SearchList(table[idx], p1, p2, p3);
-   if (id >= 0) { return id; }
+   const std::uint64_t h = Hash(p1, p2, p3);
+   int pos = FindSlot(h, p1, p2, p3);
+   if (pos >= 0) { return Slot(pos); }
 
    // not found - use an unused item or create a new one
-   int new_id;
-   if (unused.Size())
-   {
-      new_id = unused.Last();
-      unused.DeleteLast();
-   }
-   else
-   {
-      new_id = Base::Append();
-   }
+   CheckRehash();
+   int new_id = NewId();
    T& item = Base::At(new_id);
    item.p1 = p1;
    item.p2 = p2;
    item.p3 = p3;
 
    // insert into hashtable
-   Insert(idx, new_id, item);
-   CheckRehash();
+   Insert(h, new_id);
 
    return new_id;
 }
@@ -702,47 +833,66 @@ template<typename T>
 int HashTable<T>::FindId(int p1, int p2) const
 {
    if (p1 > p2) { std::swap(p1, p2); }
-   return SearchList(table[Hash(p1, p2)], p1, p2);
+   int pos = FindSlot(Hash(p1, p2), p1, p2);
+   return (pos >= 0) ? Slot(pos) : -1;
 }
 
 template<typename T>
 int HashTable<T>::FindId(int p1, int p2, int p3, int p4) const
 {
    internal::sort4_ext(p1, p2, p3, p4);
-   return SearchList(table[Hash(p1, p2, p3)], p1, p2, p3);
+   int pos = FindSlot(Hash(p1, p2, p3), p1, p2, p3);
+   return (pos >= 0) ? Slot(pos) : -1;
 }
 
 template<typename T>
-int HashTable<T>::SearchList(int id, int p1, int p2) const
+template<typename Match>
+inline int HashTable<T>::Probe(std::uint64_t h, Match match) const
 {
-   while (id >= 0)
+   const unsigned char tag = h & 0x7f;
+   int g = int(h >> 7) & mask;
+   for (int i = 1; true; i++)
    {
-      const T& item = Base::At(id);
-      if (item.p1 == p1 && item.p2 == p2) { return id; }
-      id = item.next;
+      const Group &grp = groups[g];
+      const std::uint64_t w = LoadGroup(grp.tag);
+      for (std::uint64_t m = MatchTag(w, tag); m; m &= m-1)
+      {
+         const int slot = LowestByte(m);
+         if (grp.tag[slot] == tag && match(grp.id[slot]))
+         {
+            return g*GROUP + slot;
+         }
+      }
+      if (MatchEmpty(w)) { return -1; }
+      g = (g + i) & mask;
    }
-   return -1;
 }
 
 template<typename T>
-int HashTable<T>::SearchList(int id, int p1, int p2, int p3) const
+int HashTable<T>::FindSlot(std::uint64_t h, int p1, int p2) const
 {
-   while (id >= 0)
+   return Probe(h, [this, p1, p2](int id)
    {
       const T& item = Base::At(id);
-      if (item.p1 == p1 && item.p2 == p2 && item.p3 == p3) { return id; }
-      id = item.next;
-   }
-   return -1;
+      return item.p1 == p1 && item.p2 == p2;
+   });
 }
 
 template<typename T>
-inline void HashTable<T>::CheckRehash()
+int HashTable<T>::FindSlot(std::uint64_t h, int p1, int p2, int p3) const
 {
-   const int fill_factor = 2;
+   return Probe(h, [this, p1, p2, p3](int id)
+   {
+      const T& item = Base::At(id);
+      return item.p1 == p1 && item.p2 == p2 && item.p3 == p3;
+   });
+}
 
-   // is the table overfull?
-   if (Base::Size() > (mask+1) * fill_factor)
+template<typename T>
+inline void HashTable<T>::CheckRehash()
+{
+   // are there EMPTY slots left to use?
+   if (growth_left == 0)
    {
       DoRehash();
    }
@@ -751,13 +901,16 @@ inline void HashTable<T>::CheckRehash()
 template<typename T>
 void HashTable<T>::DoRehash()
 {
-   delete [] table;
+   int count = 0;
+   for (const_iterator it = cbegin(); it != cend(); ++it) { count++; }
+
+   // double the table size, if necessary, to use at most 7/16 of the slots
+   // after inserting the next item
+   int new_table_size = mask+1;
+   while (16*(count+1) > 7*GROUP*new_table_size) { new_table_size *= 2; }
 
-   // double the table size
-   int new_table_size = 2*(mask+1);
-   table = new int[new_table_size];
-   for (int i = 0; i < new_table_size; i++) { table[i] = -1; }
-   mask = new_table_size-1;
+   delete [] table_mem;
+   AllocTable(new_table_size);
 
 #if defined(MFEM_DEBUG) && !defined(MFEM_USE_MPI)
    mfem::out << _MFEM_FUNC_NAME << ": rehashing to size " << new_table_size
@@ -767,34 +920,36 @@ void HashTable<T>::DoRehash()
    // reinsert all items
    for (iterator it = begin(); it != end(); ++it)
    {
-      Insert(Hash(*it), it.index(), *it);
+      Insert(Hash(*it), it.index());
    }
 }
 
 template<typename T>
-inline void HashTable<T>::Insert(int idx, int id, T &item)
+inline void HashTable<T>::Insert(std::uint64_t h, int id)
 {
-   // add item at the beginning of the linked list
-   item.next = table[idx];
-   table[idx] = id;
-}
-
-template<typename T>
-void HashTable<T>::Unlink(int idx, int id)
-{
-   // remove item from the linked list
-   int* p_id = table + idx;
-   while (*p_id >= 0)
+   int g = int(h >> 7) & mask;
+   for (int i = 1; true; i++)
    {
-      T& item = Base::At(*p_id);
-      if (*p_id == id)
+      Group &grp = groups[g];
+      const std::uint64_t m = MatchFree(LoadGroup(grp.tag));
+      if (m)
       {
-         *p_id = item.next;
+         const int slot = LowestByte(m);
+         if (grp.tag[slot] == EMPTY) { growth_left--; }
+         grp.tag[slot] = h & 0x7f;
+         grp.id[slot] = id;
          return;
       }
-      p_id = &(item.next);
+      g = (g + i) & mask;
    }
-   MFEM_ABORT("HashTable<>::Unlink: item not found!");
+}
+
+template<typename T>
+void HashTable<T>::Unlink(std::uint64_t h, int id)
+{
+   int pos = Probe(h, [id](int slot_id) { return slot_id == id; });
+   MFEM_VERIFY(pos >= 0, "HashTable<>::Unlink: item not found!");
+   Tag(pos) = DELETED;
 }
 
 template<typename T>
@@ -802,7 +957,7 @@ void HashTable<T>::Delete(int id)
 {
    T& item = Base::At(id);
    Unlink(Hash(item), id);
-   item.next = -2;    // mark item as unused
+   item.p1 = -1;      // mark item as unused
    unused.Append(id); // add its id to the unused ids
 }
 
@@ -810,7 +965,7 @@ template<typename T>
 void HashTable<T>::DeleteAll()
 {
    Base::DeleteAll();
-   for (int i = 0; i <= mask; i++) { table[i] = -1; }
+   ClearTable();
    unused.DeleteAll();
 }
 
@@ -820,18 +975,16 @@ void HashTable<T>::Alloc(int id, int p1, int p2)
    // enlarge the BlockArray to hold 'id'
    while (id >= Base::Size())
    {
-      Base::At(Base::Append()).next = -2; // append "unused" items
+      Base::At(Base::Append()).p1 = -1; // append "unused" items
    }
 
    T& item = Base::At(id);
-   if (item.next == -2)
+   if (item.p1 == -1)
    {
-      item.next = -1;
+      CheckRehash();
       item.p1 = p1;
       item.p2 = p2;
-
-      Insert(Hash(p1, p2), id, item);
-      CheckRehash();
+      Insert(Hash(p1, p2), id);
    }
 }
 
@@ -841,13 +994,15 @@ void HashTable<T>::UpdateUnused()
    unused.DeleteAll();
    for (int i = 0; i < Base::Size(); i++)
    {
-      if (Base::At(i).next == -2) { unused.Append(i); }
+      if (Base::At(i).p1 == -1) { unused.Append(i); }
    }
 }
 
 template<typename T>
 void HashTable<T>::Reparent(int id, int new_p1, int new_p2)
 {
+   CheckRehash();
+
    T& item = Base::At(id);
    Unlink(Hash(item), id);
 
@@ -856,14 +1011,15 @@ void HashTable<T>::Reparent(int id, int new_p1, int new_p2)
    item.p2 = new_p2;
 
    // reinsert under new parent IDs
-   int new_idx = Hash(new_p1, new_p2);
-   Insert(new_idx, id, item);
+   Insert(Hash(new_p1, new_p2), id);
 }
 
 template<typename T>
 void HashTable<T>::Reparent(int id,
                             int new_p1, int new_p2, int new_p3, int new_p4)
 {
+   CheckRehash();
+
    T& item = Base::At(id);
    Unlink(Hash(item), id);
 
@@ -873,32 +1029,31 @@ void HashTable<T>::Reparent(int id,
    item.p3 = new_p3;
 
    // reinsert under new parent IDs
-   int new_idx = Hash(new_p1, new_p2, new_p3);
-   Insert(new_idx, id, item);
+   Insert(Hash(new_p1, new_p2, new_p3), id);
 }
 
 template<typename T>
 std::size_t HashTable<T>::MemoryUsage() const
 {
-   return (mask+1) * sizeof(int) + Base::MemoryUsage() + unused.MemoryUsage();
+   return (mask+1) * sizeof(Group) + Base::MemoryUsage() +
+          unused.MemoryUsage();
 }
 
 template<typename T>
 void HashTable<T>::PrintMemoryDetail() const
 {
-   mfem::out << Base::MemoryUsage() << " + " << (mask+1) * sizeof(int)
-             << " + " << unused.MemoryUsage();
+   mfem::out << Base::MemoryUsage() << " + "
+             << (mask+1) * sizeof(Group) << " + " << unused.MemoryUsage();
 }
 
 template<typename T>
-int HashTable<T>::BinSize(int idx) const
+int HashTable<T>::ProbeLength(int pos) const
 {
-   int count = 0;
-   int id = table[idx];
-   while (id >= 0)
+   const std::uint64_t h = Hash(Base::At(Slot(pos)));
+   int g = int(h >> 7) & mask, count = 1;
+   for (int i = 1; g != pos / GROUP; i++)
    {
-      const T& item = Base::At(id);
-      id = item.next;
+      g = (g + i) & mask;
       count++;
    }
    return count;
@@ -907,28 +1062,31 @@ int HashTable<T>::BinSize(int idx) const
 template<typename T>
 void HashTable<T>::PrintStats() const
 {
-   int table_size = mask+1;
+   int table_size = (mask+1)*GROUP;
    mfem::out << "Hash table size: " << table_size << "\n";
    mfem::out << "Item count: " << Size() << "\n";
    mfem::out << "BlockArray size: " << Base::Size() << "\n";
 
    const int H = 16;
-   int hist[H];
+   int hist[H], deleted = 0;
 
    for (int i = 0; i < H; i++) { hist[i] = 0; }
 
    for (int i = 0; i < table_size; i++)
    {
-      int bs = BinSize(i);
-      if (bs >= H) { bs = H-1; }
-      hist[bs]++;
+      if (Tag(i) == DELETED) { deleted++; }
+      if (Tag(i) & 0x80) { continue; }
+      int len = ProbeLength(i);
+      if (len >= H) { len = H-1; }
+      hist[len]++;
    }
 
-   mfem::out << "Bin size histogram:\n";
-   for (int i = 0; i < H; i++)
+   mfem::out << "Deleted slots: " << deleted << "\n";
+   mfem::out << "Probe length histogram:\n";
+   for (int i = 1; i < H; i++)
    {
-      mfem::out << "  size " << i << ": "
-                << hist[i] << " bins" << std::endl;
+      mfem::out << "  " << i << " groups: "
+                << hist[i] << " items" << std::endl;
    }
 }
 
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <tuple>
 
 namespace mfem
@@ -113,6 +114,15 @@ public:
 /// defined on different MPI communicator. This can be useful when
 /// comparing a solution computed on m ranks against a solution
 /// computed with n or 1 rank(s).
+///
+/// The tree is stored implicitly in the point cloud: Sort() reorders the points
+/// such that the median of each subtree is at its center, and the subtrees
+/// with at most #leaf_size points are scanned linearly. The tree is built with
+/// OpenMP tasks and the batched queries, e.g., FindClosestPoints(), are
+/// distributed among the OpenMP threads when MFEM_USE_OPENMP is enabled; all
+/// queries are const and thread-safe. By default, the batched queries are
+/// processed in the order of a k-d tree of the query points, so that
+/// consecutive queries visit the same parts of the tree, see SetSortQueries().
 template <typename Tindex, typename Tfloat, size_t ndim=3,
           typename Tnorm=KDTreeNorms::Norm_l2<Tfloat,ndim> >
 class KDTree : public KDTreeBase<Tindex, Tfloat>
@@ -146,6 +156,12 @@ public:
       NodeND(PointND pt_, Tindex ind_ = 0) : pt(pt_), ind(ind_) { }
    };
 
+   /// Maximum number of points in the leaves of the tree
+   static constexpr size_t leaf_size = 8;
+
+   /// Minimum size of the tree for sorting the batched queries
+   static constexpr size_t sort_min_size = 65536;
+
    /// Default constructor
    KDTree() = default;
 
@@ -186,9 +202,23 @@ public:
    /// needs to be rebuild by a new call to Sort().
    void Sort() override
    {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel
+      #pragma omp single
+#endif
       SortInPlace(data.begin(),data.end(),0);
    }
 
+   /// @brief Enable or disable the sorting of the query points of the batched
+   /// queries.
+   ///
+   /// The sorting improves the cache reuse for large trees, when the query
+   /// points are given in a random order, but its cost is wasted if they
+   /// already are ordered, e.g., by a space-filling curve. Enabled by default,
+   /// the queries are never sorted for trees with less than #sort_min_size
+   /// points, which fit in the cache.
+   void SetSortQueries(bool sort) { sort_queries = sort; }
+
    /// Adds a new node to the point cloud
    void AddPoint(const PointND &pt, Tindex ii)
    {
@@ -258,6 +288,73 @@ public:
       clp=data[best_candidate.pos].pt;
    }
 
+   /// Finds the nearest neighbour indices @a ind and, if @a dist is not null,
+   /// the distances of the @a npts points whose coordinates are stored
+   /// consecutively in @a xx.
+   void FindClosestPoints(const Tfloat *xx, size_t npts, Tindex *ind,
+                          Tfloat *dist = nullptr) const
+   {
+      std::vector<NodeND> qs;
+      OrderQueries(xx,npts,qs);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for (long j=0; j<(long)npts; j++)
+      {
+         const size_t i=qs[j].ind;
+         Tindex ii;
+         Tfloat dd;
+         FindClosestPoint(qs[j].pt,ii,dd);
+         ind[i]=ii;
+         if (dist) { dist[i]=dd; }
+      }
+   }
+
+   /// Finds the @a k closest points to @a pt. The indices and the distances
+   /// are returned in the vectors @a ind and @a dist, sorted by increasing
+   /// distance. If the point cloud has less than @a k points, all points are
+   /// returned.
+   void FindKNearestPoints(const PointND &pt, size_t k,
+                           std::vector<Tindex> &ind,
+                           std::vector<Tfloat> &dist) const
+   {
+      std::vector< std::tuple<Tfloat,Tindex> > res;
+      KNearest(pt,k,res);
+      ind.resize(res.size());
+      dist.resize(res.size());
+      for (size_t i=0; i<res.size(); i++)
+      {
+         dist[i]=std::get<0>(res[i]);
+         ind[i]=std::get<1>(res[i]);
+      }
+   }
+
+   /// Finds the @a k closest points to each of the @a npts points whose
+   /// coordinates are stored consecutively in @a xx. The indices and the
+   /// distances for point i are returned in ind[k*i:k*i+k] and, if @a dist is
+   /// not null, in dist[k*i:k*i+k], sorted by increasing distance. The point
+   /// cloud must have at least @a k points.
+   void FindKNearestPoints(const Tfloat *xx, size_t npts, size_t k,
+                           Tindex *ind, Tfloat *dist = nullptr) const
+   {
+      std::vector<NodeND> qs;
+      OrderQueries(xx,npts,qs);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for (long j=0; j<(long)npts; j++)
+      {
+         const size_t i=qs[j].ind;
+         std::vector< std::tuple<Tfloat,Tindex> > res;
+         KNearest(qs[j].pt,k,res);
+         for (size_t r=0; r<res.size(); r++)
+         {
+            ind[k*i+r]=std::get<1>(res[r]);
+            if (dist) { dist[k*i+r]=std::get<0>(res[r]); }
+         }
+      }
+   }
+
 
    /// Brute force search - please, use it only for debuging purposes
    void FindClosestPointSlow(const PointND &pt, Tindex &ind, Tfloat &dist) const
@@ -284,23 +381,57 @@ public:
 
    /// Finds all points within a distance R from point pt. The indices are
    /// returned in the vector res and the correponding distances in vector dist.
-   void FindNeighborPoints(const PointND &pt,Tfloat R, std::vector<Tindex> & res,
-                           std::vector<Tfloat> & dist)
+   void FindNeighborPoints(const PointND &pt,Tfloat R,
+                           std::vector<Tindex> & res,
+                           std::vector<Tfloat> & dist) const
    {
-      FindNeighborPoints(pt,R,data.begin(),data.end(),0,res,dist);
+      FindNeighborPoints(pt,R,data.cbegin(),data.cend(),0,res,dist);
    }
 
    /// Finds all points within a distance R from point pt. The indices are
    /// returned in the vector res and the correponding distances in vector dist.
-   void FindNeighborPoints(const PointND &pt,Tfloat R, std::vector<Tindex> & res)
+   void FindNeighborPoints(const PointND &pt,Tfloat R,
+                           std::vector<Tindex> & res) const
    {
-      FindNeighborPoints(pt,R,data.begin(),data.end(),0,res);
+      FindNeighborPoints(pt,R,data.cbegin(),data.cend(),0,res);
+   }
+
+   /// Finds all points within a distance R from each of the @a npts points
+   /// whose coordinates are stored consecutively in @a xx. The indices of the
+   /// neighbors of point i are returned in res[offsets[i]:offsets[i+1]].
+   void FindNeighborPoints(const Tfloat *xx, size_t npts, Tfloat R,
+                           std::vector<size_t> &offsets,
+                           std::vector<Tindex> &res) const
+   {
+      std::vector<NodeND> qs;
+      OrderQueries(xx,npts,qs);
+      std::vector< std::vector<Tindex> > lres(npts);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for (long j=0; j<(long)npts; j++)
+      {
+         FindNeighborPoints(qs[j].pt,R,data.cbegin(),data.cend(),0,
+                            lres[qs[j].ind]);
+      }
+
+      offsets.resize(npts+1);
+      offsets[0]=0;
+      for (size_t i=0; i<npts; i++)
+      {
+         offsets[i+1]=offsets[i]+lres[i].size();
+      }
+      res.resize(offsets[npts]);
+      for (size_t i=0; i<npts; i++)
+      {
+         std::copy(lres[i].begin(),lres[i].end(),res.begin()+offsets[i]);
+      }
    }
 
    /// Brute force search - please, use it only for debuging purposes
    void FindNeighborPointsSlow(const PointND &pt,Tfloat R,
                                std::vector<Tindex> &res,
-                               std::vector<Tfloat> &dist)
+                               std::vector<Tfloat> &dist) const
    {
       Tfloat dd;
       for (auto iti=data.begin(); iti!=data.end(); iti++)
@@ -316,7 +447,7 @@ public:
 
    /// Brute force search - please, use it only for debuging purposes
    void FindNeighborPointsSlow(const PointND &pt,Tfloat R,
-                               std::vector<Tindex> &res)
+                               std::vector<Tindex> &res) const
    {
       Tfloat dd;
       for (auto iti=data.begin(); iti!=data.end(); iti++)
@@ -354,17 +485,23 @@ private:
       }
    };
 
-   mutable PointND tp; ///< Point for storing tmp data
    Tnorm fnorm;
 
+   /// Sort the query points of the batched queries, see SetSortQueries()
+   bool sort_queries = true;
+
+   /// Minimum number of points of a subtree sorted in a separate OpenMP task
+   static constexpr size_t task_size = 4096;
+
    /// Computes the distance between two nodes
    Tfloat Dist(const PointND &pt1, const PointND &pt2) const
    {
+      Tfloat tp[ndim];
       for (size_t i=0; i<ndim; i++)
       {
-         tp.xx[i]=pt1.xx[i]-pt2.xx[i];
+         tp[i]=pt1.xx[i]-pt2.xx[i];
       }
-      return fnorm(tp.xx);
+      return fnorm(tp);
    }
 
    /// The point cloud is stored in a vector.
@@ -381,17 +518,42 @@ private:
       return itb->pt.xx[cdim];
    }
 
+   /// Copies the @a npts query points in @a xx to @a qs, where the index of
+   /// each point is its position in @a xx, and sorts them if #sort_queries
+   /// is set and the tree is large.
+   void OrderQueries(const Tfloat *xx, size_t npts,
+                     std::vector<NodeND> &qs) const
+   {
+      qs.resize(npts);
+      for (size_t i=0; i<npts; i++)
+      {
+         qs[i]=NodeND(PointND(xx+ndim*i),Tindex(i));
+      }
+      if (sort_queries && data.size()>=sort_min_size)
+      {
+#ifdef MFEM_USE_OPENMP
+         #pragma omp parallel
+         #pragma omp single
+#endif
+         SortInPlace(qs.begin(),qs.end(),0);
+      }
+   }
+
    /// Sorts the point cloud
-   void SortInPlace(typename std::vector<NodeND>::iterator itb,
-                    typename std::vector<NodeND>::iterator ite,
-                    size_t level)
+   static void SortInPlace(typename std::vector<NodeND>::iterator itb,
+                           typename std::vector<NodeND>::iterator ite,
+                           size_t level)
    {
       std::uint8_t cdim=(std::uint8_t)(level%ndim);
       size_t siz=ite-itb;
-      if (siz>2)
+      if (siz>leaf_size)
       {
          std::nth_element(itb, itb+siz/2, ite, CompN(cdim));
          level=level+1;
+         // the two subtrees are independent, sort the large ones in parallel
+#ifdef MFEM_USE_OPENMP
+         #pragma omp task if (siz>task_size)
+#endif
          SortInPlace(itb, itb+siz/2, level);
          SortInPlace(itb+siz/2+1,ite, level);
       }
@@ -415,7 +577,7 @@ private:
       std::uint8_t dim=(std::uint8_t) (level%ndim);
       size_t siz=ite-itb;
       typename std::vector<NodeND>::const_iterator mtb=itb+siz/2;
-      if (siz>2)
+      if (siz>leaf_size)
       {
          // median is at itb+siz/2
          level=level+1;
@@ -484,17 +646,30 @@ private:
       }
    }
 
+   /// Returns the distances and indices of the k closest points to a point
+   /// pt, sorted by increasing distance.
+   void KNearest(const PointND &pt, size_t k,
+                 std::vector< std::tuple<Tfloat,Tindex> > &res) const
+   {
+      k=std::min(k,data.size());
+      res.assign(k,std::make_tuple(std::numeric_limits<Tfloat>::max(),
+                                   Tindex()));
+      if (k==0) { return; }
+      NNS(pt,k,data.cbegin(),data.cend(),0,res);
+      std::sort(res.begin(),res.end());
+   }
+
    /// Returns distances and indices of the n closest points to a point pt.
-   void NNS(PointND& pt,const int& npoints,
-            typename std::vector<NodeND>::iterator itb,
-            typename std::vector<NodeND>::iterator ite,
+   void NNS(const PointND& pt, size_t npoints,
+            typename std::vector<NodeND>::const_iterator itb,
+            typename std::vector<NodeND>::const_iterator ite,
             size_t level,
             std::vector< std::tuple<Tfloat,Tindex> > & res) const
    {
       std::uint8_t dim=(std::uint8_t) (level%ndim);
       size_t siz=ite-itb;
-      typename std::vector<NodeND>::iterator mtb=itb+siz/2;
-      if (siz>2)
+      typename std::vector<NodeND>::const_iterator mtb=itb+siz/2;
+      if (siz>leaf_size)
       {
          // median is at itb+siz/2
          level=level+1;
@@ -537,16 +712,16 @@ private:
    }
 
    /// Finds the set of indices of points within a distance R of a point pt.
-   void FindNeighborPoints(PointND& pt, Tfloat R,
-                           typename std::vector<NodeND>::iterator itb,
-                           typename std::vector<NodeND>::iterator ite,
+   void FindNeighborPoints(const PointND& pt, Tfloat R,
+                           typename std::vector<NodeND>::const_iterator itb,
+                           typename std::vector<NodeND>::const_iterator ite,
                            size_t level,
                            std::vector<Tindex> & res) const
    {
       std::uint8_t dim=(std::uint8_t) (level%ndim);
       size_t siz=ite-itb;
-      typename std::vector<NodeND>::iterator mtb=itb+siz/2;
-      if (siz>2)
+      typename std::vector<NodeND>::const_iterator mtb=itb+siz/2;
+      if (siz>leaf_size)
       {
          // median is at itb+siz/2
          level=level+1;
@@ -586,16 +761,16 @@ private:
    }
 
    /// Finds the set of indices of points within a distance R of a point pt.
-   void FindNeighborPoints(PointND& pt, Tfloat R,
-                           typename std::vector<NodeND>::iterator itb,
-                           typename std::vector<NodeND>::iterator ite,
+   void FindNeighborPoints(const PointND& pt, Tfloat R,
+                           typename std::vector<NodeND>::const_iterator itb,
+                           typename std::vector<NodeND>::const_iterator ite,
                            size_t level,
                            std::vector<Tindex> & res, std::vector<Tfloat> & dist) const
    {
       std::uint8_t dim=(std::uint8_t) (level%ndim);
       size_t siz=ite-itb;
-      typename std::vector<NodeND>::iterator mtb=itb+siz/2;
-      if (siz>2)
+      typename std::vector<NodeND>::const_iterator mtb=itb+siz/2;
+      if (siz>leaf_size)
       {
          // median is at itb+siz/2
          level=level+1;
@@ -0,0 +1,747 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "cholesky.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+// Include the METIS header, if using version 5. If using METIS 4, the needed
+// declarations are inlined below, i.e. no header is needed.
+#if defined(MFEM_USE_METIS) && defined(MFEM_USE_METIS_5)
+#include "metis.h"
+#endif
+
+// METIS 4 prototypes
+#if defined(MFEM_USE_METIS) && !defined(MFEM_USE_METIS_5)
+typedef int idx_t;
+extern "C" {
+   void METIS_NodeND(int*, idx_t*, idx_t*, int*, int*, idx_t*, idx_t*);
+}
+#endif
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// Build the graph of A + A^t, without the diagonal, with sorted column indices.
+static void SymmetricGraph(int n, const int *AI, const int *AJ,
+                           Array<int> &GI, Array<int> &GJ)
+{
+   GI.SetSize(n+1);
+   GI = 0;
+   for (int r = 0; r < n; r++)
+   {
+      for (int k = AI[r]; k < AI[r+1]; k++)
+      {
+         const int c = AJ[k];
+         if (c != r) { GI[r+1]++; GI[c+1]++; }
+      }
+   }
+   GI.PartialSum();
+   GJ.SetSize(GI[n]);
+   Array<int> next(n);
+   for (int r = 0; r < n; r++) { next[r] = GI[r]; }
+   for (int r = 0; r < n; r++)
+   {
+      for (int k = AI[r]; k < AI[r+1]; k++)
+      {
+         const int c = AJ[k];
+         if (c != r) { GJ[next[r]++] = c; GJ[next[c]++] = r; }
+      }
+   }
+   // Sort and remove duplicate entries, compressing GJ in place
+   int nnz = 0;
+   for (int r = 0; r < n; r++)
+   {
+      int *row = GJ.GetData() + GI[r];
+      const int len = GI[r+1] - GI[r];
+      std::sort(row, row + len);
+      const int start = nnz;
+      for (int k = 0; k < len; k++)
+      {
+         if (k == 0 || row[k] != row[k-1]) { GJ[nnz++] = row[k]; }
+      }
+      GI[r] = start;
+   }
+   GI[n] = nnz;
+   GJ.SetSize(nnz);
+}
+
+// Nested dissection based on level structures: each connected subgraph is
+// split by the middle level of a rooted level structure from a
+// pseudo-peripheral vertex, the two halves are ordered recursively and the
+// separator is numbered last.
+struct NestedDissectionOrdering
+{
+   const int *I, *J;
+   Array<int> label, level;
+   int num_labels = 0;
+   Array<int> &p;
+   static constexpr int leaf_size = 64;
+
+   NestedDissectionOrdering(const Array<int> &GI, const Array<int> &GJ,
+                            Array<int> &p_)
+      : I(GI.GetData()), J(GJ.GetData()), label(GI.Size()-1),
+        level(GI.Size()-1), p(p_)
+   {
+      label = 0;
+      level = -1;
+   }
+
+   // Breadth-first search from @a root within the vertices labeled @a lbl.
+   // Returns the number of levels, the visited vertices are appended to
+   // @a queue in BFS order.
+   int BFS(int root, int lbl, Array<int> &queue)
+   {
+      const int start = queue.Size();
+      queue.Append(root);
+      level[root] = 0;
+      int nlevels = 1;
+      for (int q = start; q < queue.Size(); q++)
+      {
+         const int v = queue[q];
+         for (int k = I[v]; k < I[v+1]; k++)
+         {
+            const int u = J[k];
+            if (label[u] == lbl && level[u] < 0)
+            {
+               level[u] = level[v] + 1;
+               nlevels = std::max(nlevels, level[u] + 1);
+               queue.Append(u);
+            }
+         }
+      }
+      return nlevels;
+   }
+
+   void Relabel(const Array<int> &verts, int lbl)
+   {
+      for (int v : verts) { label[v] = lbl; }
+   }
+
+   void Order(const Array<int> &verts)
+   {
+      if (verts.Size() <= leaf_size) { p.Append(verts); return; }
+
+      // Split the vertices into connected components
+      const int lbl = label[verts[0]];
+      Array<int> queue;
+      queue.Reserve(verts.Size());
+      Array<int> comp_offsets(1);
+      comp_offsets[0] = 0;
+      for (int v : verts)
+      {
+         if (level[v] < 0)
+         {
+            BFS(v, lbl, queue);
+            comp_offsets.Append(queue.Size());
+         }
+      }
+      for (int v : verts) { level[v] = -1; }
+
+      const int ncomp = comp_offsets.Size() - 1;
+      for (int c = 0; c < ncomp; c++)
+      {
+         Array<int> comp(queue.GetData() + comp_offsets[c],
+                         comp_offsets[c+1] - comp_offsets[c]);
+         if (comp.Size() <= leaf_size) { p.Append(comp); continue; }
+         Array<int> comp_copy(comp);
+         Relabel(comp_copy, ++num_labels);
+         Split(comp_copy);
+      }
+   }
+
+   // Split the connected set of vertices @a verts and order its parts.
+   void Split(const Array<int> &verts)
+   {
+      const int lbl = label[verts[0]];
+      Array<int> queue;
+      queue.Reserve(verts.Size());
+
+      // Find a pseudo-peripheral vertex
+      int root = verts[0];
+      int nlevels = BFS(root, lbl, queue);
+      for (int it = 0; it < 8; it++)
+      {
+         int cand = -1, min_deg = -1;
+         for (int q = queue.Size()-1; q >= 0; q--)
+         {
+            const int v = queue[q];
+            if (level[v] != nlevels - 1) { break; }
+            const int deg = I[v+1] - I[v];
+            if (cand < 0 || deg < min_deg) { cand = v; min_deg = deg; }
+         }
+         for (int v : queue) { level[v] = -1; }
+         queue.SetSize(0);
+         const int cand_nlevels = BFS(cand, lbl, queue);
+         if (cand_nlevels <= nlevels)
+         {
+            for (int v : queue) { level[v] = -1; }
+            queue.SetSize(0);
+            BFS(root, lbl, queue);
+            break;
+         }
+         root = cand;
+         nlevels = cand_nlevels;
+      }
+
+      if (nlevels < 3)
+      {
+         for (int v : queue) { level[v] = -1; }
+         p.Append(verts);
+         return;
+      }
+
+      // Choose the middle level, so that the two halves are balanced
+      Array<int> level_count(nlevels);
+      level_count = 0;
+      for (int v : queue) { level_count[level[v]]++; }
+      int mid = 1, below = level_count[0];
+      while (mid < nlevels - 2 && 2*(below + level_count[mid]) < verts.Size())
+      {
+         below += level_count[mid++];
+      }
+
+      // The separator consists of the vertices in the middle level with
+      // neighbors in the next level
+      Array<int> part_a, part_b, sep;
+      for (int v : queue)
+      {
+         const int lv = level[v];
+         if (lv < mid) { part_a.Append(v); }
+         else if (lv > mid) { part_b.Append(v); }
+         else
+         {
+            bool is_sep = false;
+            for (int k = I[v]; k < I[v+1]; k++)
+            {
+               const int u = J[k];
+               if (label[u] == lbl && level[u] == mid + 1)
+               {
+                  is_sep = true;
+                  break;
+               }
+            }
+            if (is_sep) { sep.Append(v); }
+            else { part_a.Append(v); }
+         }
+      }
+      for (int v : queue) { level[v] = -1; }
+
+      Relabel(part_a, ++num_labels);
+      Relabel(part_b, ++num_labels);
+      Relabel(sep, ++num_labels);
+      Order(part_a);
+      Order(part_b);
+      p.Append(sep);
+   }
+};
+
+} // namespace internal
+
+SparseCholeskySolver::SparseCholeskySolver(FactorizationType type_)
+   : Solver(0, false), type(type_) { }
+
+SparseCholeskySolver::SparseCholeskySolver(const SparseMatrix &A,
+                                           FactorizationType type_)
+   : Solver(0, false), type(type_)
+{
+   SetOperator(A);
+}
+
+void SparseCholeskySolver::NestedDissection(const Array<int> &I,
+                                            const Array<int> &J,
+                                            Array<int> &p)
+{
+   const int n = I.Size() - 1;
+   p.SetSize(0);
+   p.Reserve(n);
+   internal::NestedDissectionOrdering nd(I, J, p);
+   Array<int> verts(n);
+   for (int i = 0; i < n; i++) { verts[i] = i; }
+   nd.Order(verts);
+   MFEM_ASSERT(p.Size() == n, "invalid nested dissection ordering");
+}
+
+void SparseCholeskySolver::ComputeOrdering(const Array<int> &I,
+                                           const Array<int> &J)
+{
+   const int n = I.Size() - 1;
+   perm.SetSize(n);
+   if (ordering == NATURAL || J.Size() == 0)
+   {
+      for (int i = 0; i < n; i++) { perm[i] = i; }
+      return;
+   }
+#ifdef MFEM_USE_METIS
+   Array<idx_t> xadj(n+1), adjncy(J.Size()), mperm(n), miperm(n);
+   for (int i = 0; i <= n; i++) { xadj[i] = I[i]; }
+   for (int k = 0; k < J.Size(); k++) { adjncy[k] = J[k]; }
+   idx_t nv = n;
+#ifndef MFEM_USE_METIS_5
+   int numflag = 0, options[8];
+   options[0] = 0; // use default options
+   METIS_NodeND(&nv, xadj.GetData(), adjncy.GetData(), &numflag, options,
+                mperm.GetData(), miperm.GetData());
+#else
+   idx_t options[METIS_NOPTIONS];
+   METIS_SetDefaultOptions(options);
+   options[METIS_OPTION_NUMBERING] = 0;
+   int err = METIS_NodeND(&nv, xadj.GetData(), adjncy.GetData(), NULL,
+                          options, mperm.GetData(), miperm.GetData());
+   MFEM_VERIFY(err == METIS_OK, "error in METIS_NodeND!");
+#endif
+   for (int i = 0; i < n; i++) { perm[i] = mperm[i]; }
+#else
+   NestedDissection(I, J, perm);
+#endif
+}
+
+void SparseCholeskySolver::SymbolicFactorization(const SparseMatrix &A)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(A.Height() == A.Width(), "the matrix must be square");
+   const int n = A.Height();
+   height = width = n;
+   factored = false;
+
+   const int *AI = A.HostReadI(), *AJ = A.HostReadJ();
+   const int nnz = AI[n];
+   pattern_I.SetSize(n+1);
+   pattern_J.SetSize(nnz);
+   std::copy(AI, AI + n + 1, pattern_I.begin());
+   std::copy(AJ, AJ + nnz, pattern_J.begin());
+
+   // Fill-reducing ordering of the graph of A + A^t
+   Array<int> GI, GJ;
+   internal::SymmetricGraph(n, AI, AJ, GI, GJ);
+   ComputeOrdering(GI, GJ);
+   iperm.SetSize(n);
+   for (int i = 0; i < n; i++) { iperm[perm[i]] = i; }
+
+   // Elimination tree of the permuted matrix (Liu's algorithm)
+   Array<int> parent(n), ancestor(n);
+   for (int k = 0; k < n; k++)
+   {
+      parent[k] = ancestor[k] = -1;
+      const int r = perm[k];
+      for (int e = GI[r]; e < GI[r+1]; e++)
+      {
+         int i = iperm[GJ[e]];
+         while (i != -1 && i < k)
+         {
+            const int inext = ancestor[i];
+            ancestor[i] = k;
+            if (inext == -1) { parent[i] = k; }
+            i = inext;
+         }
+      }
+   }
+
+   // Postorder the elimination tree, so that the columns of each supernode are
+   // numbered consecutively
+   {
+      Array<int> head(n), next(n), post(n), stack(n);
+      head = -1;
+      for (int j = n-1; j >= 0; j--)
+      {
+         if (parent[j] == -1) { continue; }
+         next[j] = head[parent[j]];
+         head[parent[j]] = j;
+      }
+      int k = 0;
+      for (int j = 0; j < n; j++)
+      {
+         if (parent[j] != -1) { continue; }
+         int top = 0;
+         stack[0] = j;
+         while (top >= 0)
+         {
+            const int v = stack[top];
+            const int c = head[v];
+            if (c == -1) { top--; post[k++] = v; }
+            else { head[v] = next[c]; stack[++top] = c; }
+         }
+      }
+      Array<int> ipost(n), new_parent(n), new_perm(n);
+      for (int i = 0; i < n; i++) { ipost[post[i]] = i; }
+      for (int i = 0; i < n; i++)
+      {
+         const int pa = parent[post[i]];
+         new_parent[i] = (pa == -1) ? -1 : ipost[pa];
+         new_perm[i] = perm[post[i]];
+      }
+      Swap(parent, new_parent);
+      Swap(perm, new_perm);
+      for (int i = 0; i < n; i++) { iperm[perm[i]] = i; }
+   }
+
+   // Column counts of L from the row subtrees of the elimination tree
+   Array<int> col_count(n), mark(n), num_child(n);
+   col_count = 1;
+   mark = -1;
+   num_child = 0;
+   for (int k = 0; k < n; k++)
+   {
+      if (parent[k] != -1) { num_child[parent[k]]++; }
+      mark[k] = k;
+      const int r = perm[k];
+      for (int e = GI[r]; e < GI[r+1]; e++)
+      {
+         for (int i = iperm[GJ[e]]; i < k && mark[i] != k; i = parent[i])
+         {
+            col_count[i]++;
+            mark[i] = k;
+         }
+      }
+   }
+
+   // Fundamental supernodes
+   sn_start.SetSize(0);
+   sn_start.Reserve(n+1);
+   col_to_sn.SetSize(n);
+   for (int j = 0; j < n; j++)
+   {
+      const bool merge = j > 0 && parent[j-1] == j && num_child[j] == 1 &&
+                         col_count[j-1] == col_count[j] + 1;
+      if (!merge) { sn_start.Append(j); }
+      col_to_sn[j] = sn_start.Size() - 1;
+   }
+   sn_start.Append(n);
+   const int nsn = sn_start.Size() - 1;
+
+   sn_rows_offsets.SetSize(nsn+1);
+   sn_val_offsets.SetSize(nsn+1);
+   sn_rows_offsets[0] = sn_val_offsets[0] = 0;
+   for (int s = 0; s < nsn; s++)
+   {
+      const int nr = col_count[sn_start[s]];
+      const int nc = sn_start[s+1] - sn_start[s];
+      const long long nval = sn_val_offsets[s] + (long long)nr*nc;
+      MFEM_VERIFY(nval <= std::numeric_limits<int>::max(),
+                  "the factor is too large");
+      sn_rows_offsets[s+1] = sn_rows_offsets[s] + nr;
+      sn_val_offsets[s+1] = int(nval);
+   }
+
+   // Row structure of the supernodes: the columns of the supernode, the
+   // entries of the matrix below the supernode and the rows of the child
+   // supernodes
+   Array<int> sn_head(nsn), sn_next(nsn);
+   sn_head = -1;
+   for (int t = nsn-1; t >= 0; t--)
+   {
+      const int pa = parent[sn_start[t+1]-1];
+      if (pa != -1)
+      {
+         sn_next[t] = sn_head[col_to_sn[pa]];
+         sn_head[col_to_sn[pa]] = t;
+      }
+   }
+   sn_rows.SetSize(sn_rows_offsets[nsn]);
+   mark = -1;
+   for (int s = 0; s < nsn; s++)
+   {
+      const int f = sn_start[s], l = sn_start[s+1];
+      int *rows = sn_rows.GetData() + sn_rows_offsets[s];
+      int nr = 0;
+      for (int j = f; j < l; j++) { rows[nr++] = j; mark[j] = s; }
+      for (int j = f; j < l; j++)
+      {
+         const int c = perm[j];
+         for (int e = GI[c]; e < GI[c+1]; e++)
+         {
+            const int i = iperm[GJ[e]];
+            if (i >= l && mark[i] != s) { rows[nr++] = i; mark[i] = s; }
+         }
+      }
+      for (int t = sn_head[s]; t != -1; t = sn_next[t])
+      {
+         const int *trows = sn_rows.GetData() + sn_rows_offsets[t];
+         const int tnr = sn_rows_offsets[t+1] - sn_rows_offsets[t];
+         for (int q = 0; q < tnr; q++)
+         {
+            const int i = trows[q];
+            if (i >= l && mark[i] != s) { rows[nr++] = i; mark[i] = s; }
+         }
+      }
+      MFEM_VERIFY(nr == sn_rows_offsets[s+1] - sn_rows_offsets[s],
+                  "inconsistent supernodal structure");
+      std::sort(rows + (l - f), rows + nr);
+   }
+
+   // Position of the entries of A in the (permuted) lower triangular factor
+   val_map.SetSize(nnz);
+   for (int r = 0; r < n; r++)
+   {
+      const int i = iperm[r];
+      for (int k = AI[r]; k < AI[r+1]; k++)
+      {
+         const int j = iperm[AJ[k]];
+         if (i < j) { val_map[k] = -1; continue; }
+         const int s = col_to_sn[j];
+         const int *rows_b = sn_rows.GetData() + sn_rows_offsets[s];
+         const int *rows_e = sn_rows.GetData() + sn_rows_offsets[s+1];
+         const int pos = int(std::lower_bound(rows_b, rows_e, i) - rows_b);
+         val_map[k] = sn_val_offsets[s] + (j - sn_start[s])*int(rows_e - rows_b)
+                      + pos;
+      }
+   }
+
+   values.SetSize(sn_val_offsets[nsn]);
+   values.UseDevice(false);
+
+   if (print_level > 0)
+   {
+      mfem::out << "SparseCholeskySolver: n = " << n << ", nnz(A) = " << nnz
+                << ", supernodes = " << nsn << ", nnz(L) = " << GetFactorNNZ()
+                << '\n';
+   }
+}
+
+void SparseCholeskySolver::FactorSupernode(int s, Array<int> &rel,
+                                           Vector &work, int work_size)
+{
+   const int f = sn_start[s], nc = sn_start[s+1] - f;
+   const int nr = sn_rows_offsets[s+1] - sn_rows_offsets[s];
+   const int *rows = sn_rows.GetData() + sn_rows_offsets[s];
+   real_t *L = values.GetData() + sn_val_offsets[s];
+   const bool chol = (type == CHOLESKY);
+
+   // Dense factorization of the nr x nc panel
+   for (int k = 0; k < nc; k++)
+   {
+      real_t *Lk = L + k*nr;
+      const real_t d = Lk[k];
+      if (chol)
+      {
+         MFEM_VERIFY(d > 0.0, "the matrix is not positive definite, pivot "
+                     << f + k << " = " << d);
+         const real_t sd = std::sqrt(d);
+         Lk[k] = sd;
+         for (int p = k+1; p < nr; p++) { Lk[p] /= sd; }
+         for (int j = k+1; j < nc; j++)
+         {
+            real_t *Lj = L + j*nr;
+            const real_t t = Lk[j];
+            for (int p = j; p < nr; p++) { Lj[p] -= Lk[p]*t; }
+         }
+      }
+      else
+      {
+         MFEM_VERIFY(d != 0.0, "zero pivot " << f + k << " in the LDL^t "
+                     "factorization");
+         diag[f+k] = d;
+         for (int j = k+1; j < nc; j++)
+         {
+            real_t *Lj = L + j*nr;
+            const real_t t = Lk[j]/d;
+            for (int p = j; p < nr; p++) { Lj[p] -= Lk[p]*t; }
+         }
+         Lk[k] = 1.0;
+         for (int p = k+1; p < nr; p++) { Lk[p] /= d; }
+      }
+   }
+
+   // Update the ancestor supernodes with L21 D L21^t, one target supernode at
+   // a time
+   const real_t *D = chol ? nullptr : diag.GetData() + f;
+   int q = nc;
+   while (q < nr)
+   {
+      const int t = col_to_sn[rows[q]];
+      const int ft = sn_start[t], lt = sn_start[t+1];
+      const int nrt = sn_rows_offsets[t+1] - sn_rows_offsets[t];
+      const int *rows_t = sn_rows.GetData() + sn_rows_offsets[t];
+      real_t *Lt = values.GetData() + sn_val_offsets[t];
+
+      // Relative position of the rows of the supernode in the target: the
+      // remaining rows of s are a subset of the rows of t
+      int qe = q;
+      for (int p = q, pt = 0; p < nr; p++)
+      {
+         while (rows_t[pt] != rows[p]) { pt++; }
+         MFEM_ASSERT(pt < nrt, "invalid supernodal structure");
+         rel[p] = pt;
+         if (rows[p] < lt) { qe = p + 1; }
+      }
+
+      // The update is computed four columns at a time into a dense buffer,
+      // which is then scattered into the target supernode
+      const int nblocks = (qe - q + 3)/4;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for if ((long long)(qe-q)*(nr-q)*nc > 32768)
+#endif
+      for (int blk = 0; blk < nblocks; blk++)
+      {
+#ifdef MFEM_USE_OPENMP
+         real_t *u = work.GetData() + 4*work_size*omp_get_thread_num();
+#else
+         real_t *u = work.GetData();
+#endif
+         const int q0 = q + 4*blk, nq = std::min(4, qe - q0), m = nr - q0;
+         for (int i = 0; i < 4*m; i++) { u[i] = 0.0; }
+         for (int k = 0; k < nc; k++)
+         {
+            const real_t *Lk = L + k*nr + q0;
+            real_t w[4] = {0.0, 0.0, 0.0, 0.0};
+            for (int j = 0; j < nq; j++) { w[j] = chol ? Lk[j] : Lk[j]*D[k]; }
+            for (int p = 0; p < m; p++)
+            {
+               const real_t l = Lk[p];
+               u[p] += l*w[0];
+               u[m+p] += l*w[1];
+               u[2*m+p] += l*w[2];
+               u[3*m+p] += l*w[3];
+            }
+         }
+         for (int j = 0; j < nq; j++)
+         {
+            real_t *Ltc = Lt + (rows[q0+j] - ft)*nrt;
+            const int *rel_j = rel.GetData() + q0;
+            for (int p = j; p < m; p++) { Ltc[rel_j[p]] -= u[j*m+p]; }
+         }
+      }
+      q = qe;
+   }
+}
+
+void SparseCholeskySolver::NumericFactorization(const SparseMatrix &A)
+{
+   const int n = A.Height();
+   MFEM_VERIFY(n == height && A.NumNonZeroElems() == val_map.Size(),
+               "the sparsity pattern does not match the symbolic "
+               "factorization");
+
+   const real_t *data = A.HostReadData();
+   values = 0.0;
+   for (int k = 0; k < val_map.Size(); k++)
+   {
+      if (val_map[k] >= 0) { values[val_map[k]] += data[k]; }
+   }
+   if (type == LDLT)
+   {
+      diag.SetSize(n);
+      diag.UseDevice(false);
+   }
+
+   int max_rows = 0;
+   for (int s = 0; s < GetNumSupernodes(); s++)
+   {
+      max_rows = std::max(max_rows, sn_rows_offsets[s+1] - sn_rows_offsets[s]);
+   }
+#ifdef MFEM_USE_OPENMP
+   const int nthreads = omp_get_max_threads();
+#else
+   const int nthreads = 1;
+#endif
+   Array<int> rel(max_rows);
+   Vector work(4*max_rows*nthreads);
+   work.UseDevice(false);
+   for (int s = 0; s < GetNumSupernodes(); s++)
+   {
+      FactorSupernode(s, rel, work, max_rows);
+   }
+   factored = true;
+}
+
+void SparseCholeskySolver::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix*>(&op);
+   MFEM_VERIFY(A, "SparseCholeskySolver: the operator must be a SparseMatrix");
+   MFEM_VERIFY(A->Finalized(), "the matrix must be finalized");
+
+   const int n = A->Height();
+   const int *AI = A->HostReadI(), *AJ = A->HostReadJ();
+   const bool same_pattern =
+      pattern_I.Size() == n + 1 && pattern_J.Size() == AI[n] &&
+      std::equal(AI, AI + n + 1, pattern_I.begin()) &&
+      std::equal(AJ, AJ + AI[n], pattern_J.begin());
+   if (!same_pattern) { SymbolicFactorization(*A); }
+   NumericFactorization(*A);
+}
+
+void SparseCholeskySolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(factored, "the matrix has not been factored");
+   const int n = height;
+   const bool chol = (type == CHOLESKY);
+
+   tmp.SetSize(n);
+   tmp.UseDevice(false);
+   real_t *y = tmp.GetData();
+   const real_t *bp = b.HostRead();
+   for (int i = 0; i < n; i++) { y[i] = bp[perm[i]]; }
+
+   // Forward substitution with L
+   const int nsn = GetNumSupernodes();
+   for (int s = 0; s < nsn; s++)
+   {
+      const int f = sn_start[s], nc = sn_start[s+1] - f;
+      const int nr = sn_rows_offsets[s+1] - sn_rows_offsets[s];
+      const int *rows = sn_rows.GetData() + sn_rows_offsets[s];
+      const real_t *L = values.GetData() + sn_val_offsets[s];
+      for (int k = 0; k < nc; k++)
+      {
+         const real_t *Lk = L + k*nr;
+         if (chol) { y[f+k] /= Lk[k]; }
+         const real_t yk = y[f+k];
+         for (int p = k+1; p < nr; p++) { y[rows[p]] -= Lk[p]*yk; }
+      }
+   }
+
+   if (!chol)
+   {
+      for (int i = 0; i < n; i++) { y[i] /= diag[i]; }
+   }
+
+   // Backward substitution with L^t
+   for (int s = nsn-1; s >= 0; s--)
+   {
+      const int f = sn_start[s], nc = sn_start[s+1] - f;
+      const int nr = sn_rows_offsets[s+1] - sn_rows_offsets[s];
+      const int *rows = sn_rows.GetData() + sn_rows_offsets[s];
+      const real_t *L = values.GetData() + sn_val_offsets[s];
+      for (int k = nc-1; k >= 0; k--)
+      {
+         const real_t *Lk = L + k*nr;
+         real_t yk = y[f+k];
+         for (int p = k+1; p < nr; p++) { yk -= Lk[p]*y[rows[p]]; }
+         y[f+k] = chol ? yk/Lk[k] : yk;
+      }
+   }
+
+   real_t *xp = x.HostWrite();
+   for (int i = 0; i < n; i++) { xp[perm[i]] = y[i]; }
+}
+
+long long SparseCholeskySolver::GetFactorNNZ() const
+{
+   long long nnz = 0;
+   for (int s = 0; s < GetNumSupernodes(); s++)
+   {
+      const long long nc = sn_start[s+1] - sn_start[s];
+      const long long nr = sn_rows_offsets[s+1] - sn_rows_offsets[s];
+      nnz += nr*nc - nc*(nc-1)/2;
+   }
+   return nnz;
+}
+
+} // namespace mfem
@@ -0,0 +1,156 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_CHOLESKY
+#define MFEM_CHOLESKY
+
+#include "../config/config.hpp"
+#include "operator.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Native supernodal sparse Cholesky (L L^t) or LDL^t direct solver for
+    symmetric SparseMatrix operators.
+
+    The factorization is split into a symbolic phase, which computes a
+    fill-reducing ordering, the elimination tree and the supernodal structure of
+    the factor, and a numeric phase, which computes the entries of the factor.
+    The numeric factorization is right-looking: each supernode is factored as a
+    dense panel and its Schur complement update is scattered into the
+    supernodes of its ancestors in the elimination tree. The dense updates are
+    threaded with OpenMP, when enabled.
+
+    SetOperator() repeats the symbolic phase only if the sparsity pattern of the
+    matrix changed since the previous call, so a sequence of matrices with a
+    fixed pattern (e.g. in time-stepping or Newton iterations) is refactored
+    only numerically.
+
+    The matrix must be stored with both its lower and upper triangular parts.
+    The Cholesky factorization requires a symmetric positive definite matrix.
+    The LDL^t factorization is performed without pivoting, and can be used for
+    symmetric quasi-definite matrices, e.g. saddle point problems with a
+    negative definite (2,2) block. */
+class SparseCholeskySolver : public Solver
+{
+public:
+   /// Type of the factorization
+   enum FactorizationType
+   {
+      CHOLESKY, ///< A = L L^t
+      LDLT      ///< A = L D L^t with unit lower triangular L
+   };
+
+   /// Fill-reducing ordering computed in the symbolic factorization
+   enum OrderingType
+   {
+      NATURAL,          ///< No reordering
+      NESTED_DISSECTION ///< METIS_NodeND when available, or a native version
+   };
+
+protected:
+   FactorizationType type;
+   OrderingType ordering = NESTED_DISSECTION;
+   int print_level = 0;
+
+   /// Copy of the sparsity pattern of the factored matrix
+   Array<int> pattern_I, pattern_J;
+
+   /// Fill-reducing permutation: new index -> old index, and its inverse
+   Array<int> perm, iperm;
+
+   /// Supernodes: the columns of supernode s are [sn_start[s], sn_start[s+1])
+   Array<int> sn_start, col_to_sn;
+
+   /// Row indices of each supernode, sorted, starting with its own columns
+   Array<int> sn_rows, sn_rows_offsets;
+
+   /// Values of each supernode: dense, column-major panels of size
+   /// (number of rows) x (number of columns)
+   Array<int> sn_val_offsets;
+   Vector values;
+
+   /// Diagonal of the LDL^t factorization
+   Vector diag;
+
+   /// Position of each entry of the matrix in @a values, -1 for entries in the
+   /// (permuted) strictly upper triangular part
+   Array<int> val_map;
+
+   bool factored = false;
+
+   mutable Vector tmp;
+
+   /// Compute the fill-reducing ordering of the symmetric graph (I,J).
+   void ComputeOrdering(const Array<int> &I, const Array<int> &J);
+
+   /// Native nested dissection ordering of the symmetric graph (I,J), used
+   /// when METIS is not available.
+   static void NestedDissection(const Array<int> &I, const Array<int> &J,
+                                Array<int> &p);
+
+   /** @brief Factor the panel of supernode @a s and update its ancestors,
+       using the workspace @a rel and @a work (4*@a work_size entries per
+       thread). */
+   void FactorSupernode(int s, Array<int> &rel, Vector &work, int work_size);
+
+public:
+   /// Construct an empty solver of the given @a type.
+   SparseCholeskySolver(FactorizationType type = CHOLESKY);
+
+   /// Construct a solver of the given @a type and factor @a A.
+   SparseCholeskySolver(const SparseMatrix &A,
+                        FactorizationType type = CHOLESKY);
+
+   /// Set the factorization type, must be called before SetOperator().
+   void SetFactorizationType(FactorizationType t)
+   { type = t; pattern_I.DeleteAll(); }
+
+   /// Set the fill-reducing ordering, must be called before SetOperator().
+   void SetOrdering(OrderingType o) { ordering = o; pattern_I.DeleteAll(); }
+
+   /// Print statistics of the factorization when @a level > 0.
+   void SetPrintLevel(int level) { print_level = level; }
+
+   /** @brief Factor @a op, which must be a finalized SparseMatrix.
+
+       The symbolic factorization is reused if the sparsity pattern of @a op is
+       the same as the one of the previous call. */
+   void SetOperator(const Operator &op) override;
+
+   /// Compute the ordering and the structure of the factor of @a A.
+   void SymbolicFactorization(const SparseMatrix &A);
+
+   /** @brief Compute the factor of @a A, which must have the same sparsity
+       pattern as the matrix used in the last SymbolicFactorization(). */
+   void NumericFactorization(const SparseMatrix &A);
+
+   /// Solve A x = b.
+   void Mult(const Vector &b, Vector &x) const override;
+
+   /// Same as Mult(), since A is symmetric.
+   void MultTranspose(const Vector &b, Vector &x) const override
+   { Mult(b, x); }
+
+   /// Return the number of supernodes in the factor.
+   int GetNumSupernodes() const { return sn_start.Size() - 1; }
+
+   /// Return the number of nonzeros in the factor L (including the diagonal).
+   long long GetFactorNNZ() const;
+
+   /// Return the fill-reducing permutation (new index -> old index).
+   const Array<int> &GetPermutation() const { return perm; }
+};
+
+} // namespace mfem
+
+#endif
@@ -24,9 +24,11 @@
 #include "blockmatrix.hpp"
 #include "blockoperator.hpp"
 #include "sparsesmoothers.hpp"
+#include "cholesky.hpp"
 #include "densemat.hpp"
 #include "symmat.hpp"
 #include "ode.hpp"
+#include "mgrit.hpp"
 #include "solvers.hpp"
 #include "handle.hpp"
 #include "invariants.hpp"
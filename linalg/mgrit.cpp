@@ -0,0 +1,268 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mgrit.hpp"
+#include "../general/globals.hpp"
+
+#include <iomanip>
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+MGRITSolver::MGRITSolver(MPI_Comm time_comm_, MPI_Comm space_comm_)
+   : time_comm(time_comm_), space_comm(space_comm_)
+{
+   if (time_comm != MPI_COMM_NULL)
+   {
+      MPI_Comm_rank(time_comm, &time_rank);
+      MPI_Comm_size(time_comm, &time_size);
+   }
+}
+
+void MGRITSolver::SplitCommunicator(MPI_Comm comm, int num_time_ranks,
+                                    MPI_Comm &space_comm, MPI_Comm &time_comm)
+{
+   int size, rank;
+   MPI_Comm_size(comm, &size);
+   MPI_Comm_rank(comm, &rank);
+   MFEM_VERIFY(num_time_ranks > 0 && size % num_time_ranks == 0,
+               "The number of ranks, " << size << ", is not divisible by the "
+               "number of time ranks, " << num_time_ranks);
+   const int space_size = size/num_time_ranks;
+   MPI_Comm_split(comm, rank/space_size, rank, &space_comm);
+   MPI_Comm_split(comm, rank%space_size, rank, &time_comm);
+}
+#endif
+
+bool MGRITSolver::Root() const
+{
+#ifdef MFEM_USE_MPI
+   if (space_comm != MPI_COMM_NULL)
+   {
+      int space_rank;
+      MPI_Comm_rank(space_comm, &space_rank);
+      if (space_rank != 0) { return false; }
+   }
+#endif
+   return time_rank == 0;
+}
+
+real_t MGRITSolver::GlobalSum(real_t a) const
+{
+#ifdef MFEM_USE_MPI
+   if (space_comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &a, 1, MPITypeMap<real_t>::mpi_type,
+                    MPI_SUM, space_comm);
+   }
+   if (time_comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &a, 1, MPITypeMap<real_t>::mpi_type,
+                    MPI_SUM, time_comm);
+   }
+#endif
+   return a;
+}
+
+void MGRITSolver::ReceivePrevious()
+{
+#ifdef MFEM_USE_MPI
+   if (time_rank > 0)
+   {
+      MPI_Recv(U[0].HostWrite(), U[0].Size(), MPITypeMap<real_t>::mpi_type,
+               time_rank - 1, 0, time_comm, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+void MGRITSolver::SendNext(const Vector &x)
+{
+#ifdef MFEM_USE_MPI
+   if (time_rank < time_size - 1)
+   {
+      MPI_Isend(x.HostRead(), x.Size(), MPITypeMap<real_t>::mpi_type,
+                time_rank + 1, 0, time_comm, &send_request);
+   }
+#else
+   MFEM_CONTRACT_VAR(x);
+#endif
+}
+
+void MGRITSolver::WaitSend()
+{
+#ifdef MFEM_USE_MPI
+   if (send_request != MPI_REQUEST_NULL)
+   {
+      MPI_Wait(&send_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+void MGRITSolver::ExchangeNeighbors(const Vector &x)
+{
+#ifdef MFEM_USE_MPI
+   if (time_size > 1)
+   {
+      const int next = (time_rank < time_size - 1) ? time_rank + 1 :
+                       MPI_PROC_NULL;
+      const int prev = (time_rank > 0) ? time_rank - 1 : MPI_PROC_NULL;
+      // U[0] is kept on the first rank, which receives nothing
+      MPI_Sendrecv(x.HostRead(), x.Size(), MPITypeMap<real_t>::mpi_type,
+                   next, 0, U[0].HostReadWrite(), U[0].Size(),
+                   MPITypeMap<real_t>::mpi_type, prev, 0, time_comm,
+                   MPI_STATUS_IGNORE);
+   }
+#else
+   MFEM_CONTRACT_VAR(x);
+#endif
+}
+
+void MGRITSolver::Propagate(ODESolver &solver, int steps, int i,
+                            Vector &x) const
+{
+   // Restart the solver, since x is not the result of its previous step
+   solver.Init(*f);
+   real_t t = t0 + (first_interval + i)*DT;
+   const real_t dt = DT/steps;
+   for (int j = 0; j < steps; j++)
+   {
+      real_t h = dt;
+      solver.Step(x, t, h);
+   }
+}
+
+void MGRITSolver::CoarseSweep(bool correct)
+{
+   // The receive is needed before the first step of the sweep. The send of
+   // U[num_local] completes while this rank continues with the relaxation.
+   WaitSend();
+   ReceivePrevious();
+   for (int i = 0; i < num_local; i++)
+   {
+      GU[i] = U[i];
+      Propagate(*coarse, coarse_steps, i, GU[i]);
+      if (correct) { add(GU[i], FU[i], U[i+1]); }
+      else { U[i+1] = GU[i]; }
+   }
+   SendNext(U[num_local]);
+}
+
+void MGRITSolver::Relax()
+{
+   for (int i = 0; i < num_local; i++)
+   {
+      FU[i] = U[i];
+      Propagate(*fine, cfactor, i, FU[i]);
+   }
+   if (relaxation == FCF_RELAXATION)
+   {
+      // C-relaxation: U[i+1] <- F(U[i]), followed by a second F-relaxation.
+      // All ranks send and receive at once, so the exchange is not
+      // serialized along the time ranks.
+      WaitSend();
+      for (int i = num_local; i > 0; i--) { U[i] = FU[i-1]; }
+      ExchangeNeighbors(U[num_local]);
+      for (int i = 0; i < num_local; i++)
+      {
+         FU[i] = U[i];
+         Propagate(*fine, cfactor, i, FU[i]);
+      }
+   }
+}
+
+real_t MGRITSolver::ResidualNorm() const
+{
+   real_t sum = 0.0;
+   Vector r(U[0].Size());
+   for (int i = 0; i < num_local; i++)
+   {
+      subtract(FU[i], U[i+1], r);
+      sum += r*r;
+   }
+   return sqrt(GlobalSum(sum));
+}
+
+void MGRITSolver::Solve(Vector &x, real_t t0_, real_t tf)
+{
+   MFEM_VERIFY(f && fine && coarse, "The propagators are not set");
+   MFEM_VERIFY(num_intervals >= time_size, "The number of intervals, "
+               << num_intervals << ", is less than the number of time ranks, "
+               << time_size);
+   MFEM_VERIFY(cfactor > 0 && coarse_steps > 0, "Invalid number of steps");
+
+   first_interval = (time_rank*num_intervals)/time_size;
+   num_local = ((time_rank + 1)*num_intervals)/time_size - first_interval;
+   t0 = t0_;
+   DT = (tf - t0)/num_intervals;
+
+   const int n = x.Size();
+   U.resize(num_local + 1);
+   FU.resize(num_local);
+   GU.resize(num_local);
+   for (auto &v : U) { v.SetSize(n); }
+   for (auto &v : FU) { v.SetSize(n); }
+   for (auto &v : GU) { v.SetSize(n); }
+
+   // Initial guess: sequential coarse time stepping
+   U[0] = x;
+   CoarseSweep(false);
+
+   converged = false;
+   for (final_iter = 0; true; final_iter++)
+   {
+      Relax();
+      final_norm = ResidualNorm();
+      if (final_iter == 0) { initial_norm = final_norm; }
+      if (print_level > 0 && Root())
+      {
+         mfem::out << "   MGRIT iteration : " << std::setw(3) << final_iter
+                   << "  ||r|| = " << final_norm << '\n';
+      }
+      if (final_norm <= std::max(rel_tol*initial_norm, abs_tol))
+      {
+         converged = true;
+         break;
+      }
+      if (final_iter == max_iter) { break; }
+
+      // Coarse-grid correction, with G evaluated at the relaxed values, which
+      // were changed by the C-relaxation
+      for (int i = 0; i < num_local; i++)
+      {
+         if (relaxation == FCF_RELAXATION)
+         {
+            GU[i] = U[i];
+            Propagate(*coarse, coarse_steps, i, GU[i]);
+         }
+         FU[i] -= GU[i];
+      }
+      CoarseSweep(true);
+   }
+   if (print_level > 0 && Root() && !converged)
+   {
+      mfem::out << "MGRIT: No convergence!\n";
+   }
+
+   WaitSend();
+
+   // The solution at tf is the fine propagation of the last C-point value
+   x = FU[num_local-1];
+#ifdef MFEM_USE_MPI
+   if (time_comm != MPI_COMM_NULL)
+   {
+      MPI_Bcast(x.HostReadWrite(), n, MPITypeMap<real_t>::mpi_type,
+                time_size - 1, time_comm);
+   }
+#endif
+}
+
+} // namespace mfem
@@ -0,0 +1,204 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_MGRIT
+#define MFEM_MGRIT
+
+#include "../config/config.hpp"
+#include "../general/communication.hpp"
+#include "ode.hpp"
+#include <vector>
+
+namespace mfem
+{
+
+/** @brief Parallel-in-time solver for the ODE du/dt = f(u,t): two-level
+    multigrid reduction in time (MGRIT), which includes Parareal.
+
+    The time interval [t0, tf] is split into N coarse intervals [T_n, T_{n+1}]
+    of size DT = (tf - t0)/N, whose end points are the C-points. Two ODESolver
+    objects define the propagators over one interval:
+    - the fine propagator F takes m steps of size DT/m, where m is the
+      coarsening factor, with the fine solver;
+    - the coarse propagator G takes a few (typically one) steps with a cheaper
+      coarse solver, e.g. a lower order method.
+
+    Each iteration applies a relaxation on the fine level, which is parallel
+    over the intervals, followed by a coarse-grid correction, which is a
+    sequential sweep with G:
+
+        U_{n+1} <- G(U_n) + F(U^r_n) - G(U^r_n),
+
+    where U^r are the relaxed values. F-relaxation propagates each C-point
+    value with F, and gives the Parareal method. FCF-relaxation additionally
+    updates the C-points with the propagated values (C-relaxation) and
+    propagates them again, which doubles the cost of the relaxation but reduces
+    the number of iterations. After k iterations, the first k (with
+    F-relaxation) or 2k (with FCF-relaxation) C-point values are equal to
+    those of the sequential fine time stepping.
+
+    The intervals are distributed in contiguous blocks across the ranks of the
+    time communicator, while each spatial vector is distributed across the
+    ranks of the space communicator, see SplitCommunicator(). The propagators
+    are restarted with ODESolver::Init() at the start of each interval, so
+    multistep methods redo their startup phase in each interval.
+
+    For more details, see R. D. Falgout, S. Friedhoff, Tz. V. Kolev,
+    S. P. MacLachlan and J. B. Schroder, "Parallel time integration with
+    multigrid", SIAM J. Sci. Comput. 36 (2014). */
+class MGRITSolver
+{
+public:
+   /// Relaxation on the fine level
+   enum RelaxationType
+   {
+      F_RELAXATION,  ///< Parareal
+      FCF_RELAXATION ///< F-, C- and F-relaxation
+   };
+
+protected:
+#ifdef MFEM_USE_MPI
+   MPI_Comm time_comm = MPI_COMM_NULL;
+   MPI_Comm space_comm = MPI_COMM_NULL;
+#endif
+   int time_rank = 0, time_size = 1;
+#ifdef MFEM_USE_MPI
+   /// Request of the pending send started by SendNext()
+   MPI_Request send_request = MPI_REQUEST_NULL;
+#endif
+
+   TimeDependentOperator *f = nullptr;
+   ODESolver *fine = nullptr, *coarse = nullptr;
+
+   int num_intervals = 1, cfactor = 2, coarse_steps = 1;
+   RelaxationType relaxation = F_RELAXATION;
+
+   int max_iter = 20, print_level = 0;
+   real_t rel_tol = 0.0, abs_tol = 1e-10;
+
+   int final_iter = 0;
+   real_t initial_norm = 0.0, final_norm = 0.0;
+   bool converged = false;
+
+   /// First local interval and number of local intervals
+   int first_interval = 0, num_local = 1;
+
+   /** C-point values of the local intervals: U[i] is the value at the start
+       of the local interval i, and U[num_local] at the end of the last one.
+       FU[i] and GU[i] are the propagated values F(U[i]) and G(U[i]). */
+   std::vector<Vector> U, FU, GU;
+
+   real_t t0 = 0.0, DT = 0.0;
+
+   /// Propagate @a x over the local interval @a i with @a solver, taking
+   /// @a steps steps.
+   void Propagate(ODESolver &solver, int steps, int i, Vector &x) const;
+
+   /// Set GU[i] and U[i+1] on the local intervals, by a sequential sweep
+   /// with G over all intervals. If @a correct, the corrections stored in
+   /// FU are added to the values of U.
+   void CoarseSweep(bool correct);
+
+   /// Apply the relaxation on the fine level, computing FU.
+   void Relax();
+
+   /// Return the norm of FU[i] - U[i+1] over all intervals.
+   real_t ResidualNorm() const;
+
+   /// Receive U[0] from the previous time rank.
+   void ReceivePrevious();
+
+   /// Start sending @a x to the next time rank. The send is completed by
+   /// WaitSend(), and @a x must not be modified before that.
+   void SendNext(const Vector &x);
+
+   /// Wait for the send started by SendNext(), if any.
+   void WaitSend();
+
+   /// Send @a x to the next time rank and receive U[0] from the previous one
+   /// in a single exchange.
+   void ExchangeNeighbors(const Vector &x);
+
+   /// Sum of @a a over the time and space communicators.
+   real_t GlobalSum(real_t a) const;
+
+   bool Root() const;
+
+public:
+   /// Construct a serial (in time) solver, where all intervals are local.
+   MGRITSolver() { }
+
+#ifdef MFEM_USE_MPI
+   /** @brief Construct a solver whose intervals are distributed across
+       @a time_comm, with spatial vectors distributed across @a space_comm,
+       which is MPI_COMM_NULL for serial vectors. */
+   MGRITSolver(MPI_Comm time_comm_, MPI_Comm space_comm_ = MPI_COMM_NULL);
+
+   /** @brief Split @a comm into @a num_time_ranks groups of consecutive
+       ranks, which form the space communicators, and the time communicators,
+       which connect the ranks with the same index in the groups. The size of
+       @a comm must be divisible by @a num_time_ranks. */
+   static void SplitCommunicator(MPI_Comm comm, int num_time_ranks,
+                                 MPI_Comm &space_comm, MPI_Comm &time_comm);
+#endif
+
+   /** @brief Set the ODE operator and the fine and coarse propagators. The
+       solvers are initialized with @a f_ in Solve(). */
+   void SetPropagators(TimeDependentOperator &f_, ODESolver &fine_,
+                       ODESolver &coarse_)
+   { f = &f_; fine = &fine_; coarse = &coarse_; }
+
+   /// Set the total number of coarse intervals, which must be at least the
+   /// number of time ranks.
+   void SetNumIntervals(int n) { num_intervals = n; }
+
+   /// Set the number of fine steps per interval.
+   void SetCoarseningFactor(int m) { cfactor = m; }
+
+   /// Set the number of coarse steps per interval.
+   void SetNumCoarseSteps(int s) { coarse_steps = s; }
+
+   void SetRelaxation(RelaxationType r) { relaxation = r; }
+
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+   void SetRelTol(real_t rtol) { rel_tol = rtol; }
+   void SetAbsTol(real_t atol) { abs_tol = atol; }
+
+   /// Print the residual norm of each iteration when @a level > 0.
+   void SetPrintLevel(int level) { print_level = level; }
+
+   /** @brief Solve the ODE on [@a t0_, @a tf] with initial value @a x, which
+       must be the same on all time ranks. On return, @a x contains the
+       solution at @a tf on all time ranks.
+
+       The iteration stops when the norm of the residual F(U_n) - U_{n+1} at
+       the C-points is below max(rel_tol * initial norm, abs_tol), or after
+       max_iter iterations. */
+   void Solve(Vector &x, real_t t0_, real_t tf);
+
+   /// Return the number of iterations (coarse-grid corrections).
+   int GetNumIterations() const { return final_iter; }
+   bool GetConverged() const { return converged; }
+   real_t GetFinalNorm() const { return final_norm; }
+
+   /// Return the range [first, first + num) of the local intervals.
+   void GetLocalIntervals(int &first, int &num) const
+   { first = first_interval; num = num_local; }
+
+   /** @brief Return the value at the start of the local interval @a i, or at
+       the end of the last local interval if @a i is the number of local
+       intervals. */
+   const Vector &GetCPointValue(int i) const { return U[i]; }
+};
+
+} // namespace mfem
+
+#endif
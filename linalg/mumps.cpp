@@ -11,6 +11,7 @@
 
 #include "../config/config.hpp"
 #include "../general/communication.hpp"
+#include "../general/hash.hpp"
 
 #ifdef MFEM_USE_MUMPS
 #ifdef MFEM_USE_MPI
@@ -62,6 +63,7 @@ void MUMPSSolver::Init(MPI_Comm comm_)
    print_level = 0;
    reorder_method = ReorderingStrategy::AUTOMATIC;
    reorder_reuse = false;
+   pattern_hash = 0;
    blr_tol = 0.0;
 
 #if MFEM_MUMPS_VERSION >= 530
@@ -190,8 +192,16 @@ void MUMPSSolver::SetOperator(const Operator &op)
       data = csr_op->data;
    }
 
+   // Reuse the analysis of the previous matrix if the sparsity pattern is
+   // unchanged on all ranks
+   const std::uint64_t hash =
+      HashInts64(J, nnz, HashInts64(I, nnz, parcsr_op->global_num_rows));
+   int same_pattern = (id && hash == pattern_hash);
+   MPI_Allreduce(MPI_IN_PLACE, &same_pattern, 1, MPI_INT, MPI_MIN, comm);
+   pattern_hash = hash;
+
    // New MUMPS object or reuse the one from a previous matrix
-   if (!id || !reorder_reuse)
+   if (!id || !(reorder_reuse || same_pattern))
    {
       if (id)
       {
@@ -20,6 +20,7 @@
 #include "operator.hpp"
 #include "hypre.hpp"
 #include <mpi.h>
+#include <cstdint>
 
 #ifdef MFEM_USE_SINGLE
 #include "smumps_c.h"
@@ -172,6 +173,11 @@ public:
     * @param reuse Flag to reuse symbolic factorization
     *
     * @note This method has to be called before repeated calls to SetOperator
+    *
+    * @note Even when this flag is not set, the symbolic factorization is
+    * reused if the sparsity pattern of the new operator is identical to the
+    * previous one, as detected by hashing the local I and J arrays. Setting
+    * the flag skips this check, assuming the patterns are compatible.
     */
    void SetReorderingReuse(bool reuse);
 
@@ -213,6 +219,10 @@ private:
    // for multiple calls to SetOperator
    bool reorder_reuse;
 
+   // Hash of the local sparsity pattern of the last analyzed operator, used to
+   // reuse the symbolic factorization when the pattern is unchanged
+   std::uint64_t pattern_hash;
+
 #if MFEM_MUMPS_VERSION >= 510
    // Parameter controlling the Block Low-Rank (BLR) feature in MUMPS
    double blr_tol;
@@ -10,9 +10,14 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/communication.hpp"
+#include "../general/forall.hpp"
+#include "../general/binaryio.hpp"
 #include "operator.hpp"
 #include "ode.hpp"
 
+#include <climits>
+#include <sstream>
+
 namespace mfem
 {
 
@@ -150,6 +155,42 @@ void ODEStateDataVector::Append(Vector &state)
    Increment();
 }
 
+// Binary I/O of the vectors of the ODE solver states
+static void WriteStateVector(std::ostream &os, const Vector &v)
+{
+   bin_io::write<int>(os, v.Size());
+   os.write(reinterpret_cast<const char*>(v.HostRead()),
+            v.Size()*sizeof(real_t));
+}
+
+static void ReadStateVector(std::istream &is, Vector &v)
+{
+   const int size = bin_io::read<int>(is);
+   MFEM_VERIFY(is && size == v.Size(), "Invalid ODE solver state: vector of "
+               "size " << size << ", expected " << v.Size());
+   is.read(reinterpret_cast<char*>(v.HostWrite()), size*sizeof(real_t));
+   MFEM_VERIFY(is, "Error reading the ODE solver state");
+}
+
+void ODEStateDataVector::Save(std::ostream &os) const
+{
+   bin_io::write<int>(os, smax);
+   bin_io::write<int>(os, ss);
+   // Some solvers use the stages beyond ss as workspace, so all of them are
+   // saved, in the logical order
+   for (int i = 0; i < smax; i++) { WriteStateVector(os, data[idx[i]]); }
+}
+
+void ODEStateDataVector::Load(std::istream &is)
+{
+   const int smax_ = bin_io::read<int>(is);
+   MFEM_VERIFY(is && smax_ == smax, "Invalid ODE solver state: " << smax_
+               << " stages, expected " << smax);
+   ss = bin_io::read<int>(is);
+   MFEM_VERIFY(ss >= 0 && ss <= smax, "Invalid ODE solver state");
+   for (int i = 0; i < smax; i++) { ReadStateVector(is, data[idx[i]]); }
+}
+
 void ODEStateDataVector::Print(std::ostream &os) const
 {
    os << ss <<"/" <<smax<<std::endl;
@@ -486,6 +527,366 @@ const real_t RK8Solver::c[] =
    1.,
 };
 
+EmbeddedRKSolver::EmbeddedRKSolver(int s_, const real_t *a_, const real_t *b_,
+                                   const real_t *d_, const real_t *c_,
+                                   int p_, int q_, bool fsal_)
+   : s(s_), p(p_), q(q_), a(a_), b(b_), d(d_), c(c_), fsal(fsal_)
+{
+   k = new Vector[s];
+   alpha = 0.7/(q + 1);
+   beta = 0.4/(q + 1);
+   dt_next = 0.0;
+   err_norm = 0.0;
+   err_prev = 1e-4;
+   t_k0 = 0.0;
+   k0_valid = false;
+   num_accepted = num_rejected = num_evals = 0;
+}
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   err.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   dt_next = 0.0;
+   err_norm = 0.0;
+   err_prev = 1e-4;
+   k0_valid = false;
+   num_accepted = num_rejected = num_evals = 0;
+}
+
+void EmbeddedRKSolver::SaveState(std::ostream &os) const
+{
+   bin_io::write<real_t>(os, dt_next);
+   bin_io::write<real_t>(os, err_norm);
+   bin_io::write<real_t>(os, err_prev);
+   bin_io::write<int>(os, k0_valid);
+   if (k0_valid)
+   {
+      bin_io::write<real_t>(os, t_k0);
+      WriteStateVector(os, k[0]);
+   }
+}
+
+void EmbeddedRKSolver::LoadState(std::istream &is)
+{
+   dt_next = bin_io::read<real_t>(is);
+   err_norm = bin_io::read<real_t>(is);
+   err_prev = bin_io::read<real_t>(is);
+   k0_valid = bin_io::read<int>(is);
+   if (k0_valid)
+   {
+      t_k0 = bin_io::read<real_t>(is);
+      ReadStateVector(is, k[0]);
+   }
+   MFEM_VERIFY(is, "Error reading the ODE solver state");
+}
+
+real_t EmbeddedRKSolver::ErrorNorm(const Vector &x0, const Vector &x1)
+{
+   const int n = err.Size();
+   const real_t rtol = rel_tol, atol = abs_tol;
+   auto X0 = x0.Read();
+   auto X1 = x1.Read();
+   auto E = err.ReadWrite();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      const real_t sc = atol + rtol*fmax(fabs(X0[i]), fabs(X1[i]));
+      E[i] /= sc;
+   });
+
+   real_t sums[2] = { err*err, real_t(n) };
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPITypeMap<real_t>::mpi_type,
+                    MPI_SUM, comm);
+   }
+#endif
+   return sqrt(sums[0]/sums[1]);
+}
+
+void EmbeddedRKSolver::Step(Vector &x, real_t &t, real_t &dt)
+{
+   real_t h = (dt_next > 0.0) ? dt_next : dt;
+   h = std::min(std::max(h, dt_min), dt_max);
+
+   // With FSAL, the first stage is the last stage of the previous step
+   if (!k0_valid || t != t_k0)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      num_evals++;
+   }
+
+   bool rejected = false;
+   while (true)
+   {
+      for (int l = 0, i = 1; i < s; i++)
+      {
+         add(x, a[l++]*h, k[0], y);
+         for (int j = 1; j < i; j++)
+         {
+            y.Add(a[l++]*h, k[j]);
+         }
+
+         f->SetTime(t + c[i-1]*h);
+         f->Mult(y, k[i]);
+         num_evals++;
+      }
+      // With FSAL, the last stage was evaluated at the new solution
+      if (!fsal)
+      {
+         add(x, b[0]*h, k[0], y);
+         for (int i = 1; i < s; i++)
+         {
+            y.Add(b[i]*h, k[i]);
+         }
+      }
+
+      err.Set((b[0] - d[0])*h, k[0]);
+      for (int i = 1; i < s; i++)
+      {
+         err.Add((b[i] - d[i])*h, k[i]);
+      }
+      err_norm = ErrorNorm(x, y);
+      if (err_norm <= 1.0 || h <= dt_min) { break; }
+
+      // Reject the step, k[0] remains valid
+      num_rejected++;
+      rejected = true;
+      h *= std::max(fac_min, real_t(0.9*pow(err_norm, -1.0/(q + 1))));
+      h = std::max(h, dt_min);
+   }
+
+   x = y;
+   t += h;
+   dt = h;
+   num_accepted++;
+
+   // PI step size controller, see Hairer and Wanner, "Solving Ordinary
+   // Differential Equations II", Section IV.2
+   real_t fac = 0.9*pow(std::max(err_norm, real_t(1e-10)), -alpha)*
+                pow(err_prev, beta);
+   fac = std::min(std::max(fac, fac_min), rejected ? real_t(1.0) : fac_max);
+   dt_next = std::min(std::max(h*fac, dt_min), dt_max);
+   err_prev = std::max(err_norm, real_t(1e-4));
+
+   if (fsal)
+   {
+      k[0].Swap(k[s-1]);
+      k0_valid = true;
+      t_k0 = t;
+   }
+}
+
+void EmbeddedRKSolver::Run(Vector &x, real_t &t, real_t &dt, real_t tf)
+{
+   while (t < tf)
+   {
+      // Shorten the step to end exactly at the final time. The step size
+      // proposed for the following steps is the one before shortening.
+      const real_t h = (dt_next > 0.0) ? dt_next : dt;
+      const real_t h_last = tf - t;
+      const bool last = (t + h >= tf);
+      if (last) { dt_next = h_last; }
+      Step(x, t, dt);
+      if (last && dt == h_last) { t = tf; dt_next = h; }
+   }
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const real_t DormandPrince54Solver::a[] =
+{
+   1./5.,
+   3./40., 9./40.,
+   44./45., -56./15., 32./9.,
+   19372./6561., -25360./2187., 64448./6561., -212./729.,
+   9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.,
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.
+};
+const real_t DormandPrince54Solver::b[] =
+{
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84., 0.
+};
+const real_t DormandPrince54Solver::d[] =
+{
+   5179./57600., 0., 7571./16695., 393./640., -92097./339200., 187./2100.,
+   1./40.
+};
+const real_t DormandPrince54Solver::c[] =
+{
+   1./5., 3./10., 4./5., 8./9., 1., 1.
+};
+
+const real_t BogackiShampine32Solver::a[] =
+{
+   1./2.,
+   0., 3./4.,
+   2./9., 1./3., 4./9.
+};
+const real_t BogackiShampine32Solver::b[] =
+{
+   2./9., 1./3., 4./9., 0.
+};
+const real_t BogackiShampine32Solver::d[] =
+{
+   7./24., 1./4., 1./3., 1./8.
+};
+const real_t BogackiShampine32Solver::c[] =
+{
+   1./2., 3./4., 1.
+};
+
+const real_t Verner65Solver::a[] =
+{
+   0.06,
+   0.01923996296296296296296296296296296296296,
+   0.07669337037037037037037037037037037037037,
+   0.035975,
+   0.,
+   0.107925,
+   1.318683415233148260919747276431735612861,
+   0.,
+   -5.042058063628562225427761634715637693344,
+   4.220674648395413964508014358283902080483,
+   -41.87259166432751461803757780644346812905,
+   0.,
+   159.4325621631374917700365669070346830453,
+   -122.1192135650100309202516203389242140663,
+   5.531743066200053768252631238332999150076,
+   -54.43015693531650433250642051294142461271,
+   0.,
+   207.0672513650184644273657173866509835987,
+   -158.6108137845899991828742424365058599469,
+   6.991816585950242321992597280791793907096,
+   -0.01859723106220323397765171799549294623692,
+   -54.66374178728197680241215648050386959351,
+   0.,
+   207.9528062553893734515824816699834244238,
+   -159.2889574744995071508959805871426654216,
+   7.018743740796944434698170760964252490817,
+   -0.01833878590504572306472782005141738268361,
+   -0.000511948499788209907787543249724516839584,
+   0.0343895786835703600927882012472832238652,
+   0.,
+   0.,
+   0.2582624555633503404659558098586120858767,
+   0.4209371189673537150642551514069801967032,
+   4.405396469669310170148836816197095664891,
+   -176.4831190242986576151740942499002125029,
+   172.3641334014150730294022582711902413315
+};
+const real_t Verner65Solver::b[] =
+{
+   0.0343895786835703600927882012472832238652,
+   0.,
+   0.,
+   0.2582624555633503404659558098586120858767,
+   0.4209371189673537150642551514069801967032,
+   4.405396469669310170148836816197095664891,
+   -176.4831190242986576151740942499002125029,
+   172.3641334014150730294022582711902413315,
+   0.
+};
+const real_t Verner65Solver::d[] =
+{
+   0.04085713189522099993131003467009508512171,
+   0.,
+   0.,
+   0.2436869330984858083260847052809187657940,
+   0.4422746734083822029950703235222794255859,
+   2.823113173870341832977951214314556242348,
+   -98.88921184932566858357332177879861556713,
+   96.31427993705323773934290550101075559642,
+   0.025
+};
+const real_t Verner65Solver::c[] =
+{
+   0.06,
+   0.09593333333333333333333333333333333333333,
+   0.1439,
+   0.4973,
+   0.9725,
+   0.9995,
+   1.,
+   1.
+};
+
+LowStorageRKSolver::LowStorageRKSolver(int s_, const real_t *A_,
+                                       const real_t *B_, const real_t *c_)
+   : s(s_), A(A_), B(B_), c(c_) { }
+
+void LowStorageRKSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   int n = f->Width();
+   dx.SetSize(n, mem_type);
+   if (use_add_mult) { k.Destroy(); }
+   else { k.SetSize(n, mem_type); }
+}
+
+void LowStorageRKSolver::Step(Vector &x, real_t &t, real_t &dt)
+{
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + c[i]*dt);
+      if (use_add_mult)
+      {
+         if (i == 0) { dx = 0.0; }
+         else { dx *= A[i]; }
+         f->AddMult(x, dx, dt);
+      }
+      else
+      {
+         f->Mult(x, k);
+         if (i == 0) { dx.Set(dt, k); }
+         else { add(A[i], dx, dt, k, dx); }
+      }
+      x.Add(B[i], dx);
+   }
+   t += dt;
+}
+
+const real_t LSRK4Solver::A[] =
+{
+   0.,
+   -567301805773./1357537059087.,
+   -2404267990393./2016746695238.,
+   -3550918686646./2091501179385.,
+   -1275806237668./842570457699.
+};
+const real_t LSRK4Solver::B[] =
+{
+   1432997174477./9575080441755.,
+   5161836677717./13612068292357.,
+   1720146321549./2090206949498.,
+   3134564353537./4481467310338.,
+   2277821191437./14882151754819.
+};
+const real_t LSRK4Solver::c[] =
+{
+   0.,
+   1432997174477./9575080441755.,
+   2526269341429./6820363962896.,
+   2006345519317./3224310063776.,
+   2802321613138./2924317926251.
+};
+
+const real_t LSRK3Solver::A[] = { 0., -5./9., -153./128. };
+const real_t LSRK3Solver::B[] = { 1./3., 15./16., 8./15. };
+const real_t LSRK3Solver::c[] = { 0., 1./3., 3./4. };
+
+
 
 AdamsBashforthSolver::AdamsBashforthSolver(int s_, const real_t *a_):
    stages(s_), state(s_)
@@ -518,6 +919,7 @@ void AdamsBashforthSolver::Step(Vector &x, real_t &t, real_t &dt)
    }
    else
    {
+      f->SetTime(t);
       f->Mult(x,state[0]);
       RKsolver->Step(x,t,dt);
       state.Increment();
@@ -596,6 +998,7 @@ void AdamsMoultonSolver::Step(Vector &x, real_t &t, real_t &dt)
 
    if ((state.Size() == 0)&&(stages>1))
    {
+      f->SetTime(t);
       f->Mult(x,state[0]);
       state.Increment();
    }
@@ -616,6 +1019,7 @@ void AdamsMoultonSolver::Step(Vector &x, real_t &t, real_t &dt)
    {
       state.ShiftStages();
       RKsolver->Step(x,t,dt);
+      f->SetTime(t);
       f->Mult(x,state[0]);
       state.Increment();
    }
@@ -630,6 +1034,349 @@ const real_t AM3Solver::a[] =
 const real_t AM4Solver::a[] =
 {251.0/720.0,646.0/720.0,-264.0/720.0, 106.0/720.0, -19.0/720.0};
 
+MultirateABSolver::MultirateABSolver(int order_) : order(order_)
+{
+   MFEM_VERIFY(order >= 1 && order <= 4, "MultirateABSolver: invalid order "
+               << order);
+   num_steps = 0;
+}
+
+void MultirateABSolver::SetLevels(const Array<int> &level_, int num_levels_)
+{
+   level = level_;
+   const int max_level = level.Size() ? level.Max() : 0;
+   MFEM_VERIFY(level.Size() == 0 || level.Min() >= 0,
+               "MultirateABSolver: negative level");
+   num_levels = (num_levels_ < 0) ? max_level + 1 : num_levels_;
+   MFEM_VERIFY(num_levels > max_level && num_levels <= 30,
+               "MultirateABSolver: invalid number of levels " << num_levels);
+}
+
+void MultirateABSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   const int n = f->Width();
+   MFEM_VERIFY(level.Size() == 0 || level.Size() == n,
+               "MultirateABSolver: the size of the levels array is "
+               << level.Size() << ", expected " << n);
+
+   // Unknowns of each level, in CSR format
+   level_offsets.SetSize(num_levels + 1);
+   level_offsets = 0;
+   for (int i = 0; i < n; i++)
+   {
+      level_offsets[(level.Size() ? level[i] : 0) + 1]++;
+   }
+   level_offsets.PartialSum();
+   level_dofs.SetSize(n);
+   Array<int> fill(num_levels);
+   for (int l = 0; l < num_levels; l++) { fill[l] = level_offsets[l]; }
+   for (int i = 0; i < n; i++)
+   {
+      level_dofs[fill[level.Size() ? level[i] : 0]++] = i;
+   }
+
+   K.resize(order);
+   for (int j = 0; j < order; j++) { K[j].SetSize(n, mem_type); }
+   hist_head.SetSize(num_levels);
+   hist_size.SetSize(num_levels);
+   step_start.SetSize(num_levels);
+   hist_head = 0;
+   hist_size = 0;
+   step_start = 0;
+   num_steps = 0;
+
+   xt.SetSize(n, mem_type);
+   k.SetSize(n, mem_type);
+   if (order > 1)
+   {
+      y.SetSize(n, mem_type);
+      z.SetSize(n, mem_type);
+   }
+}
+
+void MultirateABSolver::IntegrationWeights(int q, real_t theta, real_t *w)
+{
+   // Lagrange polynomial of node -j, in the monomial basis
+   for (int j = 0; j < q; j++)
+   {
+      real_t p[4] = {1.0, 0.0, 0.0, 0.0};
+      int deg = 0;
+      for (int i = 0; i < q; i++)
+      {
+         if (i == j) { continue; }
+         // Multiply by (s + i)/(i - j)
+         const real_t inv = 1.0/(i - j);
+         for (int r = deg + 1; r > 0; r--)
+         {
+            p[r] = (p[r-1] + i*p[r])*inv;
+         }
+         p[0] *= i*inv;
+         deg++;
+      }
+      real_t integral = 0.0, theta_pow = theta;
+      for (int r = 0; r <= deg; r++)
+      {
+         integral += p[r]*theta_pow/(r + 1);
+         theta_pow *= theta;
+      }
+      w[j] = integral;
+   }
+}
+
+void MultirateABSolver::AddLevelIncrement(int l, real_t h, real_t theta,
+                                          Vector &u) const
+{
+   const int q = hist_size[l];
+   real_t w[4];
+   IntegrationWeights(q, theta, w);
+
+   const int nl = level_offsets[l+1] - level_offsets[l];
+   const int *D = level_dofs.Read() + level_offsets[l];
+   auto U = u.ReadWrite();
+   for (int j = 0; j < q; j++)
+   {
+      const real_t c = h*w[j];
+      auto Kj = K[(hist_head[l] + j) % order].Read();
+      mfem::forall(nl, [=] MFEM_HOST_DEVICE (int i)
+      {
+         U[D[i]] += c*Kj[D[i]];
+      });
+   }
+}
+
+void MultirateABSolver::StoreDerivative(int min_level, int m)
+{
+   auto Kn = k.Read();
+   for (int l = min_level; l < num_levels; l++)
+   {
+      hist_head[l] = (hist_head[l] + order - 1) % order;
+      hist_size[l] = std::min(hist_size[l] + 1, order);
+      step_start[l] = m;
+
+      const int nl = level_offsets[l+1] - level_offsets[l];
+      const int *D = level_dofs.Read() + level_offsets[l];
+      auto H = K[hist_head[l]].ReadWrite();
+      mfem::forall(nl, [=] MFEM_HOST_DEVICE (int i)
+      {
+         H[D[i]] = Kn[D[i]];
+      });
+   }
+}
+
+int MultirateABSolver::MinActiveLevel(int m) const
+{
+   // Level l takes a step at substep m if m is a multiple of 2^(L-1-l)
+   if (m == 0) { return 0; }
+   int tz = 0;
+   while ((m & 1) == 0) { m >>= 1; tz++; }
+   return std::max(0, num_levels - 1 - tz);
+}
+
+void MultirateABSolver::Step(Vector &x, real_t &t, real_t &dt)
+{
+   const int M = 1 << (num_levels - 1);
+   const real_t h = dt/M;
+
+   if (num_steps < order - 1)
+   {
+      // Startup: RK4 steps with the finest step size, recording the time
+      // derivatives at the start of the steps of each level
+      for (int m = 0; m < M; m++)
+      {
+         const real_t tm = t + m*h;
+         f->SetTime(tm);
+         f->Mult(x, k);
+         StoreDerivative(MinActiveLevel(m), m);
+
+         z.Set(h/6, k);
+         add(x, h/2, k, y);
+         f->SetTime(tm + h/2);
+         f->Mult(y, k);
+         z.Add(h/3, k);
+         add(x, h/2, k, y);
+         f->Mult(y, k);
+         z.Add(h/3, k);
+         add(x, h, k, y);
+         f->SetTime(tm + h);
+         f->Mult(y, k);
+         z.Add(h/6, k);
+         x += z;
+      }
+   }
+   else
+   {
+      auto mf = dynamic_cast<MultirateTimeDependentOperator*>(f);
+      for (int m = 0; m <= M; m++)
+      {
+         const int min_level = (m == M) ? 0 : MinActiveLevel(m);
+
+         // Complete the steps of the levels which end at this substep
+         if (m > 0)
+         {
+            for (int l = min_level; l < num_levels; l++)
+            {
+               AddLevelIncrement(l, dt/(1 << l), 1.0, x);
+            }
+         }
+         if (m == M) { break; }
+
+         // Interpolate the unknowns of the coarser levels in time
+         xt = x;
+         for (int l = 0; l < min_level; l++)
+         {
+            const int nsub = 1 << (num_levels - 1 - l);
+            const real_t theta = real_t(m - step_start[l])/nsub;
+            AddLevelIncrement(l, dt/(1 << l), theta, xt);
+         }
+
+         f->SetTime(t + m*h);
+         if (mf) { mf->MultLevels(min_level, xt, k); }
+         else { f->Mult(xt, k); }
+         StoreDerivative(min_level, m);
+      }
+   }
+   t += dt;
+   num_steps++;
+}
+
+void MultirateABSolver::SaveState(std::ostream &os) const
+{
+   bin_io::write<int>(os, order);
+   bin_io::write<int>(os, num_levels);
+   bin_io::write<int>(os, num_steps);
+   for (int l = 0; l < num_levels; l++)
+   {
+      bin_io::write<int>(os, hist_head[l]);
+      bin_io::write<int>(os, hist_size[l]);
+      bin_io::write<int>(os, step_start[l]);
+   }
+   for (int j = 0; j < order; j++) { WriteStateVector(os, K[j]); }
+}
+
+void MultirateABSolver::LoadState(std::istream &is)
+{
+   const int order_ = bin_io::read<int>(is);
+   const int num_levels_ = bin_io::read<int>(is);
+   MFEM_VERIFY(is && order_ == order && num_levels_ == num_levels,
+               "Invalid multirate AB solver state");
+   num_steps = bin_io::read<int>(is);
+   for (int l = 0; l < num_levels; l++)
+   {
+      hist_head[l] = bin_io::read<int>(is);
+      hist_size[l] = bin_io::read<int>(is);
+      step_start[l] = bin_io::read<int>(is);
+   }
+   for (int j = 0; j < order; j++) { ReadStateVector(is, K[j]); }
+}
+
+BinomialCheckpointing::BinomialCheckpointing(int num_checkpoints_)
+   : num_checkpoints(num_checkpoints_)
+{
+   MFEM_VERIFY(num_checkpoints >= 1, "At least one checkpoint is required");
+}
+
+long long BinomialCheckpointing::Binomial(int n, int k)
+{
+   k = std::min(k, n - k);
+   if (k < 0) { return 0; }
+   long long b = 1;
+   for (int i = 1; i <= k; i++)
+   {
+      // b*(n-k+i) is divisible by i
+      if (b > LLONG_MAX/(n - k + i)) { return LLONG_MAX; }
+      b = b*(n - k + i)/i;
+   }
+   return b;
+}
+
+int BinomialCheckpointing::NumRepetitions(int num_steps, int num_checkpoints_)
+{
+   int r = 0;
+   while (Binomial(num_checkpoints_ + r, num_checkpoints_) < num_steps) { r++; }
+   return r;
+}
+
+void BinomialCheckpointing::Store(int slot)
+{
+   Checkpoint &cp = checkpoints[slot];
+   cp.t = t;
+   cp.x = x;
+   std::ostringstream os;
+   solver->SaveState(os);
+   cp.state = os.str();
+}
+
+void BinomialCheckpointing::Restore(int slot)
+{
+   const Checkpoint &cp = checkpoints[slot];
+   t = cp.t;
+   x = cp.x;
+   std::istringstream is(cp.state);
+   solver->LoadState(is);
+}
+
+void BinomialCheckpointing::Advance(int steps)
+{
+   for (int i = 0; i < steps; i++)
+   {
+      real_t h = dt;
+      solver->Step(x, t, h);
+      num_forward_steps++;
+   }
+}
+
+void BinomialCheckpointing::Reverse(int a, int b, int slot)
+{
+   const int l = b - a;
+   const int num_free = num_checkpoints - 1 - slot;
+   if (l == 1 || num_free == 0)
+   {
+      // Recompute each step from the checkpoint at a
+      for (int j = b - 1; j >= a; j--)
+      {
+         Restore(slot);
+         Advance(j - a);
+         reverse_step(j, t, x);
+      }
+      return;
+   }
+
+   // Split [a, b) into [a, a+m), reversed with the same checkpoints, and
+   // [a+m, b), reversed with one checkpoint less, such that the number of
+   // repetitions is minimal
+   const int c = num_free + 1;
+   const int r = NumRepetitions(l, c);
+   const long long lo = std::max(1LL, l - Binomial(c - 1 + r, c - 1));
+   const long long hi = std::min<long long>(l - 1, Binomial(c + r - 1, c));
+   const long long mid = (r >= 2) ? Binomial(c + r - 2, c) : 1;
+   const int m = (int) std::max(lo, std::min(hi, mid));
+
+   Restore(slot);
+   Advance(m);
+   Store(slot + 1);
+   Reverse(a + m, b, slot + 1);
+   Reverse(a, a + m, slot);
+}
+
+void BinomialCheckpointing::Run(ODESolver &solver_, const Vector &x0,
+                                real_t t0, real_t dt_, int num_steps,
+                                ReverseStepFunction reverse_step_)
+{
+   solver = &solver_;
+   reverse_step = reverse_step_;
+   dt = dt_;
+   num_forward_steps = 0;
+   if (num_steps <= 0) { return; }
+
+   checkpoints.resize(num_checkpoints);
+   x = x0;
+   t = t0;
+   Store(0);
+   Reverse(0, num_steps, 0);
+}
+
+
 
 void BackwardEulerSolver::Init(TimeDependentOperator &f_)
 {
@@ -874,6 +1621,198 @@ void ESDIRK33Solver::Step(Vector &x, real_t &t, real_t &dt)
    t += dt;
 }
 
+IMEXRKSolver::IMEXRKSolver(int s_, const real_t *aE_, const real_t *aI_,
+                           const real_t *bE_, const real_t *bI_,
+                           const real_t *c_)
+   : s(s_), aE(aE_), aI(aI_), bE(bE_), bI(bI_), c(c_)
+{
+   kE = new Vector[s];
+   kI = new Vector[s];
+
+   // A stage term is needed if it contributes to the solution or to the stage
+   // values of the following stages. Implicit terms with a nonzero diagonal
+   // entry are always computed, since they define their own stage value.
+   need_kE.SetSize(s);
+   need_kI.SetSize(s);
+   for (int j = 0; j < s; j++)
+   {
+      need_kE[j] = (bE[j] != 0.0);
+      need_kI[j] = (bI[j] != 0.0) || (aI[j*(j+1)/2 + j] != 0.0);
+      for (int i = j + 1; i < s; i++)
+      {
+         need_kE[j] = need_kE[j] || (aE[i*(i-1)/2 + j] != 0.0);
+         need_kI[j] = need_kI[j] || (aI[i*(i+1)/2 + j] != 0.0);
+      }
+   }
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &f_)
+{
+   ODESolver::Init(f_);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      kE[i].SetSize(n, mem_type);
+      kI[i].SetSize(n, mem_type);
+   }
+}
+
+void IMEXRKSolver::Step(Vector &x, real_t &t, real_t &dt)
+{
+   for (int i = 0; i < s; i++)
+   {
+      // y = x + dt sum_{j<i} (aE[i,j] kE[j] + aI[i,j] kI[j])
+      y = x;
+      for (int j = 0; j < i; j++)
+      {
+         const real_t ae = aE[i*(i-1)/2 + j], ai = aI[i*(i+1)/2 + j];
+         if (ae != 0.0) { y.Add(ae*dt, kE[j]); }
+         if (ai != 0.0) { y.Add(ai*dt, kI[j]); }
+      }
+
+      f->SetTime(t + c[i]*dt);
+      const real_t aii = aI[i*(i+1)/2 + i];
+      if (need_kI[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         if (aii != 0.0)
+         {
+            // Solve kI[i] = f_I(y + aii dt kI[i]), the stage value is then
+            // y + aii dt kI[i]
+            f->ImplicitSolve(aii*dt, y, kI[i]);
+            y.Add(aii*dt, kI[i]);
+         }
+         else
+         {
+            f->Mult(y, kI[i]);
+         }
+      }
+      if (need_kE[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+         f->Mult(y, kE[i]);
+      }
+   }
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+
+   for (int i = 0; i < s; i++)
+   {
+      if (bE[i] != 0.0) { x.Add(bE[i]*dt, kE[i]); }
+      if (bI[i] != 0.0) { x.Add(bI[i]*dt, kI[i]); }
+   }
+   t += dt;
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] kE;
+   delete [] kI;
+}
+
+// ARS(2,2,2) with gamma = 1 - 1/sqrt(2) and delta = 1 - 1/(2 gamma)
+const real_t ARS222Solver::aE[] =
+{
+   0.2928932188134524755991556378951509607152,
+   -0.7071067811865475244008443621048490392848,
+   1.7071067811865475244008443621048490392848
+};
+const real_t ARS222Solver::aI[] =
+{
+   0.,
+   0., 0.2928932188134524755991556378951509607152,
+   0., 0.7071067811865475244008443621048490392848,
+   0.2928932188134524755991556378951509607152
+};
+const real_t ARS222Solver::bE[] =
+{
+   -0.7071067811865475244008443621048490392848,
+   1.7071067811865475244008443621048490392848,
+   0.
+};
+const real_t ARS222Solver::bI[] =
+{
+   0.,
+   0.7071067811865475244008443621048490392848,
+   0.2928932188134524755991556378951509607152
+};
+const real_t ARS222Solver::c[] =
+{
+   0., 0.2928932188134524755991556378951509607152, 1.
+};
+
+const real_t ARK324Solver::aE[] =
+{
+   1767732205903./2027836641118.,
+   5535828885825./10492691773637.,
+   788022342437./10882634858940.,
+   6485989280629./16251701735622.,
+   -4246266847089./9704473918619.,
+   10755448449292./10357097424841.
+};
+const real_t ARK324Solver::aI[] =
+{
+   0.,
+   1767732205903./4055673282236.,
+   1767732205903./4055673282236.,
+   2746238789719./10658868560708.,
+   -640167445237./6845629431997.,
+   1767732205903./4055673282236.,
+   1471266399579./7840856788654.,
+   -4482444167858./7529755066697.,
+   11266239266428./11593286722821.,
+   1767732205903./4055673282236.
+};
+const real_t ARK324Solver::b[] =
+{
+   1471266399579./7840856788654.,
+   -4482444167858./7529755066697.,
+   11266239266428./11593286722821.,
+   1767732205903./4055673282236.
+};
+const real_t ARK324Solver::c[] =
+{
+   0., 1767732205903./2027836641118., 3./5., 1.
+};
+
+const real_t ARK436Solver::aE[] =
+{
+   1./2.,
+   13861./62500.,
+   6889./62500.,
+   -116923316275./2393684061468.,
+   -2731218467317./15368042101831.,
+   9408046702089./11113171139209.,
+   -451086348788./2902428689909.,
+   -2682348792572./7519795681897.,
+   12662868775082./11960479115383.,
+   3355817975965./11060851509271.,
+   647845179188./3216320057751.,
+   73281519250./8382639484533.,
+   552539513391./3454668386233.,
+   3354512671639./8306763924573.,
+   4040./17871.
+};
+const real_t ARK436Solver::aI[] =
+{
+   0.,
+   1./4., 1./4.,
+   8611./62500., -1743./31250., 1./4.,
+   5012029./34652500., -654441./2922500., 174375./388108., 1./4.,
+   15267082809./155376265600., -71443401./120774400.,
+   730878875./902184768., 2285395./8070912., 1./4.,
+   82889./524892., 0., 15625./83664., 69875./102672., -2260./8211., 1./4.
+};
+const real_t ARK436Solver::b[] =
+{
+   82889./524892., 0., 15625./83664., 69875./102672., -2260./8211., 1./4.
+};
+const real_t ARK436Solver::c[] =
+{
+   0., 1./2., 83./250., 31./50., 17./20., 1.
+};
+
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &f_)
 {
    ODESolver::Init(f_);
@@ -924,6 +1863,7 @@ void GeneralizedAlphaSolver::Step(Vector &x, real_t &t, real_t &dt)
 {
    if (state.Size() == 0)
    {
+      f->SetTime(t);
       f->Mult(x,state[0]);
       state.Increment();
    }
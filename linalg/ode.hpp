@@ -17,6 +17,9 @@
 #include "operator.hpp"
 #include <vector>
 #include <memory>
+#include <functional>
+#include <iostream>
+#include <string>
 
 namespace mfem
 {
@@ -46,6 +49,15 @@ public:
    /// Add state vector and increment state size
    virtual void Append(Vector &state) = 0;
 
+   /// Write the stored states to @a os in binary format.
+   virtual void Save(std::ostream &os) const
+   { MFEM_CONTRACT_VAR(os); MFEM_ABORT("Not implemented"); }
+
+   /** @brief Read the states written by Save() from @a is. The size of the
+       vectors and the maximum number of stored stages must be the same. */
+   virtual void Load(std::istream &is)
+   { MFEM_CONTRACT_VAR(is); MFEM_ABORT("Not implemented"); }
+
    /// Virtual destructor
    virtual ~ODEStateData() = default;
 };
@@ -102,6 +114,10 @@ public:
    void Set(int i, Vector &state) override;
 
    void Append(Vector &state) override;
+
+   void Save(std::ostream &os) const override;
+
+   void Load(std::istream &is) override;
 };
 
 
@@ -181,6 +197,21 @@ public:
    /// Returns how many State vectors the ODE requires
    virtual int GetStateSize() { return 0; };
 
+   /** @brief Write the internal state of the solver, e.g. the history of a
+       multistep method, to @a os in binary format.
+
+       Together with the solution and the time, the state allows restarting
+       the time stepping sequence exactly, see LoadState(). One-step methods
+       have no state, and the default implementation writes nothing. */
+   virtual void SaveState(std::ostream &os) const { MFEM_CONTRACT_VAR(os); }
+
+   /** @brief Restore the internal state written by SaveState() from @a is.
+
+       The solver must be initialized with Init() with an operator of the same
+       size. The next call to Step() must use the solution and the time at
+       which the state was saved. */
+   virtual void LoadState(std::istream &is) { MFEM_CONTRACT_VAR(is); }
+
    // Help info for ODESolver options
    static MFEM_EXPORT std::string ExplicitTypes;
    static MFEM_EXPORT std::string ImplicitTypes;
@@ -218,6 +249,10 @@ public:
 
    /// Returns how many State vectors the ODE requires
    virtual int GetStateSize() { return GetState().MaxSize(); };
+
+   void SaveState(std::ostream &os) const override { GetState().Save(os); }
+
+   void LoadState(std::istream &is) override { GetState().Load(is); }
 };
 
 
@@ -254,7 +289,9 @@ public:
 };
 
 
-/// Third-order, strong stability preserving (SSP) Runge-Kutta method
+/** Third-order, strong stability preserving (SSP) Runge-Kutta method. This is
+    a low-storage method: besides the solution, only two registers are
+    stored. */
 class RK3SSPSolver : public ODESolver
 {
 private:
@@ -332,6 +369,217 @@ public:
 };
 
 
+/** @brief An explicit embedded Runge-Kutta pair with adaptive time step
+    control, corresponding to a Butcher tableau with two sets of weights
+    +--------+----------------------+
+    | c[0]   | a[0]                 |
+    | c[1]   | a[1] a[2]            |
+    | ...    |    ...               |
+    | c[s-2] | ...   a[s(s-1)/2-1]  |
+    +--------+----------------------+
+    |        | b[0] b[1] ... b[s-1] |
+    |        | d[0] d[1] ... d[s-1] |
+    +--------+----------------------+
+    where the solution is advanced with the weights b and the local error is
+    estimated as the difference with the embedded solution given by the
+    weights d.
+
+    Each Step() performs one accepted step: a step whose weighted RMS error
+    norm (with the tolerances set by SetTolerances()) is larger than one is
+    rejected and repeated with a smaller step size. The step size proposed for
+    the next step is computed with a PI controller. The input @a dt of Step()
+    is only used as the initial step size, after Init(); on output @a dt is
+    the accepted step size. Run() adjusts the last step to end exactly at the
+    final time.
+
+    For methods with the "first same as last" (FSAL) property, the last stage
+    of an accepted step is reused as the first stage of the next step, saving
+    one evaluation of the operator per step. In this case, @a x must not be
+    changed between consecutive Step() calls, unless Init() is called. */
+class EmbeddedRKSolver : public ODESolver
+{
+private:
+   int s, p, q;
+   const real_t *a, *b, *d, *c;
+   bool fsal;
+   Vector y, err, *k;
+
+   real_t rel_tol = 1e-6, abs_tol = 1e-8;
+   real_t dt_min = 0.0, dt_max = infinity();
+   real_t fac_min = 0.2, fac_max = 5.0;
+   real_t alpha, beta;
+   real_t dt_next, err_norm, err_prev;
+   real_t t_k0;
+   bool k0_valid;
+   int num_accepted, num_rejected, num_evals;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm = MPI_COMM_NULL;
+#endif
+
+   /// Weighted RMS norm of the local error estimate.
+   real_t ErrorNorm(const Vector &x0, const Vector &x1);
+
+public:
+   /** @brief Construct an @a s-stage pair of order @a p_, with an embedded
+       method of order @a q_. If @a fsal_ is true, the last row of @a a_ must
+       be equal to @a b_ and the last entry of @a c_ must be one. */
+   EmbeddedRKSolver(int s_, const real_t *a_, const real_t *b_,
+                    const real_t *d_, const real_t *c_, int p_, int q_,
+                    bool fsal_);
+
+#ifdef MFEM_USE_MPI
+   /// Set the communicator used for the error norm of parallel vectors.
+   void SetComm(MPI_Comm comm_) { comm = comm_; }
+#endif
+
+   /// Set the relative and absolute tolerances of the local error.
+   void SetTolerances(real_t rtol, real_t atol)
+   { rel_tol = rtol; abs_tol = atol; }
+
+   /// Set the bounds of the step size.
+   void SetTimeStepBounds(real_t dtmin, real_t dtmax)
+   { dt_min = dtmin; dt_max = dtmax; }
+
+   /** @brief Set the exponents of the PI controller, dt_new = dt * 0.9 *
+       err^(-@a alpha_) * err_prev^(@a beta_). The default values are
+       alpha = 0.7/(q+1) and beta = 0.4/(q+1). With @a beta_ = 0, the
+       standard (I) controller is obtained. */
+   void SetPIParameters(real_t alpha_, real_t beta_)
+   { alpha = alpha_; beta = beta_; }
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, real_t &t, real_t &dt) override;
+
+   void Run(Vector &x, real_t &t, real_t &dt, real_t tf) override;
+
+   /// Save the step size controller state and the FSAL stage.
+   void SaveState(std::ostream &os) const override;
+
+   void LoadState(std::istream &is) override;
+
+   /// Return the order of the method used to advance the solution.
+   int GetOrder() const { return p; }
+
+   /// Return the error norm of the last accepted step.
+   real_t GetErrorNorm() const { return err_norm; }
+
+   /// Return the step size proposed by the controller for the next step.
+   real_t GetProposedTimeStep() const { return dt_next; }
+
+   /// Return the number of accepted steps since the last Init().
+   int GetNumAcceptedSteps() const { return num_accepted; }
+
+   /// Return the number of rejected steps since the last Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   /// Return the number of operator evaluations since the last Init().
+   int GetNumEvaluations() const { return num_evals; }
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/// The 7-stage, 5th order Dormand-Prince pair with a 4th order embedded
+/// method, FSAL.
+class DormandPrince54Solver : public EmbeddedRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t a[21], b[7], d[7], c[6];
+
+public:
+   DormandPrince54Solver() : EmbeddedRKSolver(7, a, b, d, c, 5, 4, true) { }
+};
+
+
+/// The 4-stage, 3rd order Bogacki-Shampine pair with a 2nd order embedded
+/// method, FSAL.
+class BogackiShampine32Solver : public EmbeddedRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t a[6], b[4], d[4], c[3];
+
+public:
+   BogackiShampine32Solver()
+      : EmbeddedRKSolver(4, a, b, d, c, 3, 2, true) { }
+};
+
+
+/** The 8-stage, 6th order method of RK6Solver, completed with the FSAL stage
+    of Verner's "efficient" 9-stage 6(5) pair. The weights of the embedded 5th
+    order method span the one-dimensional space of 5th order weights for this
+    tableau, normalized such that the weight of the FSAL stage is 1/40. */
+class Verner65Solver : public EmbeddedRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t a[36], b[9], d[9], c[8];
+
+public:
+   Verner65Solver() : EmbeddedRKSolver(9, a, b, d, c, 6, 5, true) { }
+};
+
+
+/** @brief An explicit low-storage Runge-Kutta method in the 2N form of
+    Williamson:
+    for i = 0, ..., s-1:
+       dx = A[i] dx + dt f(t + c[i] dt, x)
+       x  = x + B[i] dx
+    with A[0] = 0.
+
+    Besides the solution, only the register dx and a vector for the output of
+    the operator are stored, independently of the number of stages. If
+    SetUseAddMult() is enabled, the operator is applied with
+    TimeDependentOperator::AddMult() directly into dx, and only one register is
+    stored; this is beneficial only for operators that implement AddMult()
+    without a temporary vector. */
+class LowStorageRKSolver : public ODESolver
+{
+private:
+   int s;
+   const real_t *A, *B, *c;
+   bool use_add_mult = false;
+   Vector dx, k;
+
+public:
+   LowStorageRKSolver(int s_, const real_t *A_, const real_t *B_,
+                      const real_t *c_);
+
+   /// Use TimeDependentOperator::AddMult() to update the register. Must be
+   /// called before Init().
+   void SetUseAddMult(bool use) { use_add_mult = use; }
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, real_t &t, real_t &dt) override;
+};
+
+
+/** The 5-stage, 4th order low-storage Runge-Kutta method of Carpenter and
+    Kennedy, "Fourth-order 2N-storage Runge-Kutta schemes", 1994 (solution
+    3). */
+class LSRK4Solver : public LowStorageRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t A[5], B[5], c[5];
+
+public:
+   LSRK4Solver() : LowStorageRKSolver(5, A, B, c) { }
+};
+
+
+/** The 3-stage, 3rd order low-storage Runge-Kutta method of Williamson,
+    "Low-storage Runge-Kutta schemes", 1980. */
+class LSRK3Solver : public LowStorageRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t A[3], B[3], c[3];
+
+public:
+   LSRK3Solver() : LowStorageRKSolver(3, A, B, c) { }
+};
+
+
 /// Backward Euler ODE solver. L-stable.
 class BackwardEulerSolver : public ODESolver
 {
@@ -449,6 +697,82 @@ public:
 };
 
 
+/** @brief An implicit-explicit (IMEX) additive Runge-Kutta method for ODEs
+    with an additively split operator, dx/dt = f_E(x,t) + f_I(x,t), where f_E
+    is integrated explicitly and f_I implicitly. The method is defined by a
+    pair of s-stage Butcher tableaux with common nodes c: an explicit one,
+    whose coefficients aE are stored row-wise below the diagonal (s(s-1)/2
+    entries, as in ExplicitRKSolver), and a diagonally implicit one, whose
+    coefficients aI are stored row-wise up to and including the diagonal
+    (s(s+1)/2 entries). The weights bE and bI may be different.
+
+    The two terms are evaluated using the evaluation mode of the
+    TimeDependentOperator, as in the SUNDIALS ARKStepSolver: in mode
+    TimeDependentOperator::ADDITIVE_TERM_1, Mult() must compute the explicit
+    term f_E; in mode TimeDependentOperator::ADDITIVE_TERM_2, Mult() and
+    ImplicitSolve() must compute and solve with the implicit term f_I. The
+    explicit term is never solved with, and implicit solves are only performed
+    for stages with a nonzero diagonal entry in aI. Stage evaluations that do
+    not contribute to the solution are skipped. */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   const real_t *aE, *aI, *bE, *bI, *c;
+   Array<bool> need_kE, need_kI;
+   Vector y, *kE, *kI;
+
+public:
+   IMEXRKSolver(int s_, const real_t *aE_, const real_t *aI_,
+                const real_t *bE_, const real_t *bI_, const real_t *c_);
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, real_t &t, real_t &dt) override;
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The 3-stage, 2nd order ARS(2,2,2) IMEX method of Ascher, Ruuth and
+    Spiteri, "Implicit-explicit Runge-Kutta methods for time-dependent partial
+    differential equations", 1997. The implicit method is L-stable. */
+class ARS222Solver : public IMEXRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t aE[3], aI[6], bE[3], bI[3], c[3];
+
+public:
+   ARS222Solver() : IMEXRKSolver(3, aE, aI, bE, bI, c) { }
+};
+
+
+/** The 4-stage, 3rd order ARK3(2)4L[2]SA IMEX method of Kennedy and Carpenter,
+    "Additive Runge-Kutta schemes for convection-diffusion-reaction
+    equations", 2003. The implicit method is an L-stable ESDIRK. */
+class ARK324Solver : public IMEXRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t aE[6], aI[10], b[4], c[4];
+
+public:
+   ARK324Solver() : IMEXRKSolver(4, aE, aI, b, b, c) { }
+};
+
+
+/** The 6-stage, 4th order ARK4(3)6L[2]SA IMEX method of Kennedy and Carpenter,
+    "Additive Runge-Kutta schemes for convection-diffusion-reaction
+    equations", 2003. The implicit method is an L-stable ESDIRK. */
+class ARK436Solver : public IMEXRKSolver
+{
+private:
+   static MFEM_EXPORT const real_t aE[15], aI[21], b[6], c[6];
+
+public:
+   ARK436Solver() : IMEXRKSolver(6, aE, aI, b, b, c) { }
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier-Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
@@ -629,6 +953,175 @@ public:
    AM4Solver() : AdamsMoultonSolver(4, a) { RKsolver.reset(new SDIRK34Solver()); }
 };
 
+
+/** @brief A TimeDependentOperator that can restrict its evaluation to the
+    unknowns of the finest levels of a MultirateABSolver. */
+class MultirateTimeDependentOperator : public TimeDependentOperator
+{
+public:
+   using TimeDependentOperator::TimeDependentOperator;
+
+   /** @brief Compute the entries of k(u,t) for the unknowns of levels greater
+       than or equal to @a min_level. The other entries of @a k are not used.
+
+       The default implementation computes all entries with Mult(). */
+   virtual void MultLevels(int min_level, const Vector &u, Vector &k) const
+   { Mult(u, k); }
+};
+
+
+/** @brief Multirate (local time stepping) Adams-Bashforth method.
+
+    The unknowns are partitioned into levels, see SetLevels(): the unknowns of
+    level l are advanced with the step size dt/2^l, where dt is the (macro)
+    step size of Step(). Typically, the level of an unknown is the refinement
+    level of its element in an adaptively refined mesh, see
+    FiniteElementSpace::GetVDofLevels(), so that the step size of each element
+    is proportional to its size.
+
+    Within a macro step, the finest step size dt/2^(L-1) defines the substeps.
+    At each substep, the time derivative is evaluated only for the unknowns of
+    the levels whose step starts at the substep, using the values of the
+    unknowns of the other (coarser) levels interpolated in time with their
+    Adams-Bashforth polynomials. In a DG discretization, this provides the
+    time-interpolated states on the interfaces between elements of different
+    levels. If the operator is a MultirateTimeDependentOperator, the evaluation
+    uses MultirateTimeDependentOperator::MultLevels(), which allows the cost
+    of a macro step to scale with the number of steps of each level.
+
+    The first @a order - 1 macro steps are computed with the classical RK4
+    method using the finest step size. The macro step size must be constant,
+    otherwise Init() must be called when it changes. With a single level, the
+    method is equivalent to AdamsBashforthSolver with RK4 startup. */
+class MultirateABSolver : public ODESolver
+{
+private:
+   const int order;
+   int num_levels = 1;
+   Array<int> level;
+   /// Unknowns of each level, in CSR format
+   Array<int> level_offsets, level_dofs;
+
+   /// Time derivative history: K[j] contains the j-th most recent value for
+   /// the unknowns of each level, in the (cyclic) order given by hist_head
+   std::vector<Vector> K;
+   Array<int> hist_head, hist_size, step_start;
+   int num_steps;
+
+   Vector xt, k, y, z;
+
+   /// Compute the integrals w[j] over [0, theta] of the Lagrange polynomials
+   /// with nodes 0, -1, ..., -(q-1), for the newest q derivative values.
+   static void IntegrationWeights(int q, real_t theta, real_t *w);
+
+   /// Store the time derivative @a k in the history of the levels >=
+   /// @a min_level, whose steps start at substep @a m.
+   void StoreDerivative(int min_level, int m);
+
+   /// Add h_l sum_j w_j(theta) K_l^j to @a u for the unknowns of level @a l.
+   void AddLevelIncrement(int l, real_t h, real_t theta, Vector &u) const;
+
+   /// Return the coarsest level whose step starts at substep @a m.
+   int MinActiveLevel(int m) const;
+
+public:
+   /// Construct a multirate Adams-Bashforth method of order 1 to 4.
+   MultirateABSolver(int order_);
+
+   /** @brief Set the level of each unknown, 0 being the coarsest. Must be
+       called before Init(). Without levels, all unknowns are on level 0.
+
+       The number of levels is @a num_levels_, or the maximum level plus one
+       if @a num_levels_ is negative. In parallel, it must be the same on all
+       ranks, since each substep evaluates the operator. */
+   void SetLevels(const Array<int> &level_, int num_levels_ = -1);
+
+   /// Return the number of levels.
+   int GetNumLevels() const { return num_levels; }
+
+   void Init(TimeDependentOperator &f_) override;
+
+   void Step(Vector &x, real_t &t, real_t &dt) override;
+
+   /// Save the time derivative history of all levels.
+   void SaveState(std::ostream &os) const override;
+
+   void LoadState(std::istream &is) override;
+};
+
+/** @brief Binomial checkpointing (Revolve) for the reversal of a time stepping
+    sequence, e.g. in an adjoint solve.
+
+    Run() performs @a num_steps steps with an ODESolver and then calls a
+    reverse step function for the steps n = num_steps-1, ..., 0, in this order,
+    with the forward solution x_n at the start of step n. Only a fixed number
+    of checkpoints (the solution, the time and the solver state, see
+    ODESolver::SaveState()) are kept in memory, and the other solutions are
+    recomputed from the checkpoints. The checkpoints are placed according to
+    the binomial schedule of A. Griewank and A. Walther, "Algorithm 799:
+    Revolve", ACM Trans. Math. Softw. 26 (2000), which minimizes the number
+    of recomputed steps: with c checkpoints and N steps, each step is computed
+    at most r times, where r is the smallest integer with binomial(c+r, c) >=
+    N. In particular, O(log N) checkpoints give O(log N) recomputations. */
+class BinomialCheckpointing
+{
+public:
+   /** @brief Reverse step function, called with the step index @a n and the
+       forward solution @a x at the time @a t at the start of step n. */
+   typedef std::function<void(int n, real_t t, const Vector &x)>
+   ReverseStepFunction;
+
+private:
+   struct Checkpoint
+   {
+      real_t t;
+      Vector x;
+      std::string state;
+   };
+
+   const int num_checkpoints;
+   std::vector<Checkpoint> checkpoints;
+
+   ODESolver *solver = nullptr;
+   ReverseStepFunction reverse_step;
+   Vector x;
+   real_t t = 0.0, dt = 0.0;
+   long long num_forward_steps = 0;
+
+   void Store(int slot);
+   void Restore(int slot);
+   void Advance(int steps);
+
+   /// Reverse the steps [a, b), where the solution at step a is stored in
+   /// the checkpoint @a slot, and the following checkpoints are free.
+   void Reverse(int a, int b, int slot);
+
+public:
+   /// Construct a schedule with @a num_checkpoints_ >= 1 checkpoints, which
+   /// include the initial solution.
+   BinomialCheckpointing(int num_checkpoints_);
+
+   /** @brief Perform @a num_steps steps of size @a dt_ with @a solver_ from
+       the solution @a x0 at time @a t0, and reverse them with
+       @a reverse_step_.
+
+       The @a solver_ must be initialized with Init(), and must not change the
+       step size. */
+   void Run(ODESolver &solver_, const Vector &x0, real_t t0, real_t dt_,
+            int num_steps, ReverseStepFunction reverse_step_);
+
+   /// Return the number of forward steps of the last Run(), including the
+   /// recomputations.
+   long long GetNumForwardSteps() const { return num_forward_steps; }
+
+   /// Return binomial(n, k), saturated to the maximum long long value.
+   static long long Binomial(int n, int k);
+
+   /** @brief Return the number of times r each step is computed when
+       reversing @a num_steps steps with @a num_checkpoints_ checkpoints. */
+   static int NumRepetitions(int num_steps, int num_checkpoints_);
+};
+
 /// The SIASolver class is based on the Symplectic Integration Algorithm
 /// described in "A Symplectic Integration Algorithm for Separable Hamiltonian
 /// Functions" by J. Candy and W. Rozmus, Journal of Computational Physics,
@@ -14,11 +14,13 @@
 #include "../general/annotation.hpp"
 #include "../general/forall.hpp"
 #include "../general/globals.hpp"
+#include "../general/hash.hpp"
 #include "../fem/bilinearform.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <set>
 
 namespace mfem
@@ -531,6 +533,425 @@ void OperatorChebyshevSmoother::Mult(const Vector& x, Vector &y) const
    }
 }
 
+#ifdef MFEM_USE_MPI
+PolynomialSmoother::PolynomialSmoother(int order_, Type type_, MPI_Comm comm_)
+   : Solver(0), type(type_), order(order_), comm(comm_)
+#else
+PolynomialSmoother::PolynomialSmoother(int order_, Type type_)
+   : Solver(0), type(type_), order(order_)
+#endif
+{
+   MFEM_VERIFY(order >= 1, "PolynomialSmoother: invalid order " << order);
+
+   // Optimized weights of the 4th-kind Chebyshev polynomials, see Table 1 in
+   // J. Lottes, "Optimal polynomial smoothers for multigrid V-cycles"
+   static const real_t opt_betas[6][6] =
+   {
+      {1.12500000000000},
+      {1.02387287570313, 1.26408905371085},
+      {1.00842544782028, 1.08867839208730, 1.33753125909618},
+      {
+         1.00391310427285, 1.04035811188593, 1.14863498546254,
+         1.38268869241000
+      },
+      {
+         1.00212930146164, 1.02173711549260, 1.07872433192603,
+         1.19810065292663, 1.41322542791682
+      },
+      {
+         1.00128517255940, 1.01304293035233, 1.04678215124113,
+         1.11616489419675, 1.23829020218444, 1.43524297106744
+      }
+   };
+
+   betas.SetSize(order);
+   betas = 1.0;
+   if (type == OPT_CHEBYSHEV_4TH_KIND)
+   {
+      MFEM_VERIFY(order <= 6, "PolynomialSmoother: optimized weights are only "
+                  "available for orders up to 6, order = " << order);
+      for (int i = 0; i < order; i++) { betas[i] = opt_betas[order-1][i]; }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+PolynomialSmoother::PolynomialSmoother(const Operator &op, const Vector &diag,
+                                       const Array<int> &ess_tdofs,
+                                       int order_, Type type_, MPI_Comm comm_)
+   : PolynomialSmoother(order_, type_, comm_)
+#else
+PolynomialSmoother::PolynomialSmoother(const Operator &op, const Vector &diag,
+                                       const Array<int> &ess_tdofs,
+                                       int order_, Type type_)
+   : PolynomialSmoother(order_, type_)
+#endif
+{
+   SetEssentialTrueDofs(ess_tdofs);
+   SetOperator(op, diag);
+}
+
+real_t PolynomialSmoother::Dot(const Vector &x, const Vector &y) const
+{
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL) { return InnerProduct(comm, x, y); }
+#endif
+   return InnerProduct(x, y);
+}
+
+void PolynomialSmoother::ApplyM(const Vector &x, Vector &y) const
+{
+   oper->Mult(x, y);
+   const int n = height;
+   auto DI = dinv.Read();
+   auto Y = y.ReadWrite();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i) { Y[i] *= DI[i]; });
+}
+
+real_t PolynomialSmoother::RayleighQuotient(const Vector &v) const
+{
+   tmp.SetSize(height);
+   tmp.UseDevice(true);
+   ApplyM(v, tmp);
+   return Dot(v, tmp) / Dot(v, v);
+}
+
+void PolynomialSmoother::SetDiagonal(const Vector &diag)
+{
+   const int n = diag.Size();
+   dinv.SetSize(n);
+   dinv.UseDevice(true);
+   auto D = diag.Read();
+   auto X = dinv.Write();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i) { X[i] = 1.0 / D[i]; });
+   auto I = ess_tdof_list.Read();
+   mfem::forall(ess_tdof_list.Size(), [=] MFEM_HOST_DEVICE (int i)
+   {
+      X[I[i]] = 1.0;
+   });
+}
+
+void PolynomialSmoother::SetSpectralEstimate(real_t max_eig_)
+{
+   user_max_eig = (max_eig_ > 0.0);
+   max_eig = user_max_eig ? max_eig_ : 0.0;
+}
+
+void PolynomialSmoother::SetOperator(const Operator &op)
+{
+   MFEM_VERIFY(op.Height() == op.Width(),
+               "PolynomialSmoother: the operator must be square");
+   MFEM_VERIFY(dinv.Size() == op.Height(),
+               "PolynomialSmoother: the diagonal is not set or has a wrong "
+               "size");
+   if (op.Height() != height)
+   {
+      // The cached spectral information is not valid for a different size
+      eig_vec.Destroy();
+      gmres_vec.Destroy();
+      gmres_order = 0;
+      if (!user_max_eig) { max_eig = 0.0; }
+   }
+   height = width = op.Height();
+   oper = &op;
+   UpdateSpectralEstimate();
+}
+
+void PolynomialSmoother::UpdateSpectralEstimate()
+{
+   const bool chebyshev = (type != GMRES_POLYNOMIAL);
+   if (chebyshev && user_max_eig) { return; }
+
+   const bool cached = chebyshev ? (max_eig > 0.0 && eig_vec.Size() == height)
+                       : (gmres_order > 0);
+   if (cached && num_reuse < max_reuse)
+   {
+      // Validate the cached information with a single application of M: the
+      // Rayleigh quotient of the eigenvector estimate, or the first entry of
+      // the Hessenberg matrix for the GMRES polynomial
+      const real_t ref = chebyshev ? max_eig : hess(0,0);
+      const real_t rq = RayleighQuotient(chebyshev ? eig_vec : gmres_vec);
+      if (std::abs(rq - ref) <= reuse_tol*std::abs(ref))
+      {
+         if (chebyshev) { max_eig = rq; }
+         num_reuse++;
+         return;
+      }
+   }
+
+   num_reuse = 0;
+   num_estimates++;
+   if (chebyshev) { EstimateMaxEigenvalue(); }
+   else { ComputeGMRESPolynomial(); }
+
+   if (print_level > 0)
+   {
+      int rank = 0;
+#ifdef MFEM_USE_MPI
+      if (comm != MPI_COMM_NULL) { MPI_Comm_rank(comm, &rank); }
+#endif
+      if (rank == 0)
+      {
+         mfem::out << "PolynomialSmoother: ";
+         if (chebyshev)
+         {
+            mfem::out << "estimated largest eigenvalue = " << max_eig << '\n';
+         }
+         else
+         {
+            mfem::out << "GMRES polynomial of order " << gmres_order << '\n';
+         }
+      }
+   }
+}
+
+void PolynomialSmoother::EstimateMaxEigenvalue()
+{
+   // Power method, warm-started from the previous eigenvector estimate
+   if (eig_vec.Size() != height)
+   {
+      eig_vec.SetSize(height);
+      eig_vec.UseDevice(true);
+      eig_vec.Randomize(12345);
+   }
+   tmp.SetSize(height);
+   tmp.UseDevice(true);
+
+   real_t eig = 0.0;
+   for (int it = 0; it < power_iterations; it++)
+   {
+      eig_vec /= sqrt(Dot(eig_vec, eig_vec));
+      ApplyM(eig_vec, tmp);
+      const real_t eig_new = Dot(eig_vec, tmp);
+      eig_vec.Swap(tmp);
+      const bool done = (it > 0 &&
+                         std::abs(eig_new - eig) <= power_tolerance*eig_new);
+      eig = eig_new;
+      if (done) { break; }
+   }
+   eig_vec /= sqrt(Dot(eig_vec, eig_vec));
+   max_eig = eig;
+   MFEM_VERIFY(max_eig > 0.0, "PolynomialSmoother: the estimated largest "
+               "eigenvalue is not positive: " << max_eig);
+}
+
+void PolynomialSmoother::ComputeGMRESPolynomial()
+{
+   // Arnoldi process for M started from a random vector v_0
+   W.resize(order + 1);
+   for (int j = 0; j <= order; j++)
+   {
+      W[j].SetSize(height);
+      W[j].UseDevice(true);
+   }
+   if (gmres_vec.Size() != height)
+   {
+      gmres_vec.SetSize(height);
+      gmres_vec.UseDevice(true);
+      gmres_vec.Randomize(12345);
+      gmres_vec /= sqrt(Dot(gmres_vec, gmres_vec));
+   }
+   W[0] = gmres_vec;
+
+   hess.SetSize(order + 1, order);
+   hess = 0.0;
+   int k = order;
+   for (int j = 0; j < order; j++)
+   {
+      ApplyM(W[j], W[j+1]);
+      for (int i = 0; i <= j; i++)
+      {
+         hess(i,j) = Dot(W[j+1], W[i]);
+         W[j+1].Add(-hess(i,j), W[i]);
+      }
+      hess(j+1,j) = sqrt(Dot(W[j+1], W[j+1]));
+      if (hess(j+1,j) <= 1e-12*std::abs(hess(0,0)))
+      {
+         // Lucky breakdown: the Krylov space is invariant
+         hess(j+1,j) = 0.0;
+         k = j + 1;
+         break;
+      }
+      W[j+1] /= hess(j+1,j);
+   }
+   gmres_order = k;
+
+   // Solve the least squares problem min || e_0 - H c || with Givens rotations
+   DenseMatrix H(k + 1, k);
+   for (int j = 0; j < k; j++)
+   {
+      for (int i = 0; i <= k; i++) { H(i,j) = hess(i,j); }
+   }
+   Vector g(k + 1);
+   g = 0.0;
+   g(0) = 1.0;
+   for (int j = 0; j < k; j++)
+   {
+      const real_t a = H(j,j), b = H(j+1,j);
+      const real_t r = std::hypot(a, b);
+      const real_t cs = a / r, sn = b / r;
+      for (int l = j; l < k; l++)
+      {
+         const real_t h1 = H(j,l), h2 = H(j+1,l);
+         H(j,l) = cs*h1 + sn*h2;
+         H(j+1,l) = -sn*h1 + cs*h2;
+      }
+      const real_t g1 = g(j), g2 = g(j+1);
+      g(j) = cs*g1 + sn*g2;
+      g(j+1) = -sn*g1 + cs*g2;
+   }
+   gmres_coeffs.SetSize(k);
+   for (int i = k - 1; i >= 0; i--)
+   {
+      real_t s = g(i);
+      for (int l = i + 1; l < k; l++) { s -= H(i,l)*gmres_coeffs(l); }
+      gmres_coeffs(i) = s / H(i,i);
+   }
+}
+
+void PolynomialSmoother::ApplyChebyshev(const Array<const Vector *> &X,
+                                        const Array<Vector *> &Y) const
+{
+   // 4th-kind Chebyshev iteration, Algorithm 3 in Lottes: the update
+   // directions d_i follow the unweighted recurrence, while the solution is
+   // updated with the (optimized) weights beta_i
+   const int nvec = X.Size();
+   const int n = height;
+   R.resize(nvec);
+   D.resize(nvec);
+   W.resize(nvec);
+   Array<const Vector *> Dp(nvec);
+   Array<Vector *> Wp(nvec);
+   for (int j = 0; j < nvec; j++)
+   {
+      R[j].SetSize(n);
+      R[j].UseDevice(true);
+      D[j].SetSize(n);
+      D[j].UseDevice(true);
+      W[j].SetSize(n);
+      W[j].UseDevice(true);
+      Dp[j] = &D[j];
+      Wp[j] = &W[j];
+      Y[j]->UseDevice(true);
+   }
+
+   if (iterative_mode)
+   {
+      Array<const Vector *> Yc(nvec);
+      for (int j = 0; j < nvec; j++) { Yc[j] = Y[j]; }
+      oper->ArrayMult(Yc, Wp);
+      for (int j = 0; j < nvec; j++) { subtract(*X[j], W[j], R[j]); }
+   }
+   else
+   {
+      for (int j = 0; j < nvec; j++) { R[j] = *X[j]; *Y[j] = 0.0; }
+   }
+
+   const real_t lambda = safety_factor * max_eig;
+   auto DI = dinv.Read();
+   for (int i = 0; i < order; i++)
+   {
+      if (i > 0)
+      {
+         oper->ArrayMult(Dp, Wp);
+         for (int j = 0; j < nvec; j++) { R[j] -= W[j]; }
+      }
+      const real_t a = (i == 0) ? 0.0 : (2.0*i - 1.0) / (2.0*i + 3.0);
+      const real_t b = (i == 0) ? 4.0 / (3.0*lambda) :
+                       (8.0*i + 4.0) / ((2.0*i + 3.0)*lambda);
+      const real_t beta = betas[i];
+      for (int j = 0; j < nvec; j++)
+      {
+         auto Rj = R[j].Read();
+         auto Yj = Y[j]->ReadWrite();
+         if (i == 0)
+         {
+            // D[j] is not initialized, it must not be read
+            auto Dj = D[j].Write();
+            mfem::forall(n, [=] MFEM_HOST_DEVICE (int l)
+            {
+               Dj[l] = b*DI[l]*Rj[l];
+               Yj[l] += beta*Dj[l];
+            });
+            continue;
+         }
+         auto Dj = D[j].ReadWrite();
+         mfem::forall(n, [=] MFEM_HOST_DEVICE (int l)
+         {
+            Dj[l] = a*Dj[l] + b*DI[l]*Rj[l];
+            Yj[l] += beta*Dj[l];
+         });
+      }
+   }
+}
+
+void PolynomialSmoother::ApplyGMRES(const Vector &x, Vector &y) const
+{
+   // Apply q(M) D^{-1} using the Arnoldi recurrence of the basis vectors:
+   // w_{j+1} = (M w_j - sum_{i<=j} h_{ij} w_i) / h_{j+1,j}
+   const int k = gmres_order;
+   const int n = height;
+   W.resize(k + 1);
+   for (int j = 0; j <= k; j++)
+   {
+      W[j].SetSize(n);
+      W[j].UseDevice(true);
+   }
+   y.UseDevice(true);
+
+   Vector &w0 = W[0];
+   if (iterative_mode)
+   {
+      oper->Mult(y, w0);
+      subtract(x, w0, w0);
+   }
+   else
+   {
+      w0 = x;
+      y = 0.0;
+   }
+   auto DI = dinv.Read();
+   auto W0 = w0.ReadWrite();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int l) { W0[l] *= DI[l]; });
+
+   y.Add(gmres_coeffs(0), w0);
+   for (int j = 0; j + 1 < k; j++)
+   {
+      ApplyM(W[j], W[j+1]);
+      for (int i = 0; i <= j; i++) { W[j+1].Add(-hess(i,j), W[i]); }
+      W[j+1] /= hess(j+1,j);
+      y.Add(gmres_coeffs(j+1), W[j+1]);
+   }
+}
+
+void PolynomialSmoother::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(oper, "PolynomialSmoother: the operator is not set");
+   if (type == GMRES_POLYNOMIAL)
+   {
+      ApplyGMRES(x, y);
+      return;
+   }
+   Array<const Vector *> X(1);
+   Array<Vector *> Y(1);
+   X[0] = &x;
+   Y[0] = &y;
+   ApplyChebyshev(X, Y);
+}
+
+void PolynomialSmoother::ArrayMult(const Array<const Vector *> &X,
+                                   Array<Vector *> &Y) const
+{
+   MFEM_VERIFY(oper, "PolynomialSmoother: the operator is not set");
+   MFEM_VERIFY(X.Size() == Y.Size(), "PolynomialSmoother: incompatible "
+               "number of vectors");
+   if (type == GMRES_POLYNOMIAL)
+   {
+      for (int j = 0; j < X.Size(); j++) { ApplyGMRES(*X[j], *Y[j]); }
+      return;
+   }
+   ApplyChebyshev(X, Y);
+}
+
 void SLISolver::UpdateVectors()
 {
    r.SetSize(width);
@@ -946,6 +1367,507 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
    pcg.Mult(b, x);
 }
 
+// Cyclic Jacobi eigenvalue algorithm for the small symmetric matrix A, which is
+// overwritten. The eigenvalues are returned in ev (in no particular order) and
+// the corresponding orthonormal eigenvectors in the columns of V.
+static void JacobiEigensystem(DenseMatrix &A, Vector &ev, DenseMatrix &V)
+{
+   const int n = A.Height();
+   V.SetSize(n);
+   V = 0.0;
+   for (int i = 0; i < n; i++) { V(i,i) = 1.0; }
+
+   for (int sweep = 0; sweep < 100; sweep++)
+   {
+      real_t off = 0.0, nrm = 0.0;
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = 0; i < n; i++)
+         {
+            nrm += A(i,j)*A(i,j);
+            if (i != j) { off += A(i,j)*A(i,j); }
+         }
+      }
+      if (off <= std::numeric_limits<real_t>::epsilon()*
+          std::numeric_limits<real_t>::epsilon()*nrm) { break; }
+
+      for (int p = 0; p < n; p++)
+      {
+         for (int q = p + 1; q < n; q++)
+         {
+            const real_t apq = A(p,q);
+            if (apq == 0.0) { continue; }
+            const real_t theta = (A(q,q) - A(p,p))/(2.0*apq);
+            const real_t t = (theta >= 0.0 ? 1.0 : -1.0)/
+                             (fabs(theta) + sqrt(theta*theta + 1.0));
+            const real_t c = 1.0/sqrt(t*t + 1.0), s = t*c;
+            for (int k = 0; k < n; k++)
+            {
+               const real_t akp = A(k,p), akq = A(k,q);
+               A(k,p) = c*akp - s*akq;
+               A(k,q) = s*akp + c*akq;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const real_t apk = A(p,k), aqk = A(q,k);
+               A(p,k) = c*apk - s*aqk;
+               A(q,k) = s*apk + c*aqk;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const real_t vkp = V(k,p), vkq = V(k,q);
+               V(k,p) = c*vkp - s*vkq;
+               V(k,q) = s*vkp + c*vkq;
+            }
+         }
+      }
+   }
+
+   ev.SetSize(n);
+   for (int i = 0; i < n; i++) { ev(i) = A(i,i); }
+}
+
+void RecycledCGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   r.SetSize(width, mt);
+   r.UseDevice(true);
+
+   d.SetSize(width, mt);
+   d.UseDevice(true);
+
+   z.SetSize(width, mt);
+   z.UseDevice(true);
+
+   Ad.SetSize(width, mt);
+   Ad.UseDevice(true);
+}
+
+void RecycledCGSolver::SetRecycleDim(int dim)
+{
+   MFEM_VERIFY(dim >= 0, "invalid recycle dimension: " << dim);
+   recycle_dim = dim;
+   if ((int) W.size() > dim)
+   {
+      W.resize(dim);
+      AW.resize(dim);
+      DenseMatrix F_old(F_ww);
+      F_ww.SetSize(dim);
+      for (int j = 0; j < dim; j++)
+      {
+         for (int i = 0; i < dim; i++) { F_ww(i,j) = F_old(i,j); }
+      }
+      FactorCoarseMatrix();
+   }
+}
+
+void RecycledCGSolver::ClearRecycleSpace() const
+{
+   W.clear();
+   AW.clear();
+   E.SetSize(0);
+   E_fact.SetSize(0);
+   F_ww.SetSize(0);
+}
+
+void RecycledCGSolver::SetPreconditioner(Solver &pr)
+{
+   IterativeSolver::SetPreconditioner(pr);
+   if (oper && !W.empty()) { UpdateRecycleOperators(); }
+}
+
+void RecycledCGSolver::SetOperator(const Operator &op)
+{
+   const int old_width = width;
+   IterativeSolver::SetOperator(op);
+   UpdateVectors();
+   if (width != old_width) { ClearRecycleSpace(); }
+   else if (!W.empty()) { UpdateRecycleOperators(); }
+}
+
+void RecycledCGSolver::UpdateRecycleOperators() const
+{
+   const int k = (int) W.size();
+   for (int i = 0; i < k; i++)
+   {
+      oper->Mult(W[i], AW[i]);
+   }
+   F_ww.SetSize(k);
+   for (int j = 0; j < k; j++)
+   {
+      if (prec) { prec->Mult(AW[j], z); }
+      const Vector &BAw = prec ? z : AW[j];
+      for (int i = 0; i <= j; i++)
+      {
+         F_ww(i,j) = F_ww(j,i) = Dot(AW[i], BAw);
+      }
+   }
+   FactorCoarseMatrix();
+}
+
+void RecycledCGSolver::FactorCoarseMatrix() const
+{
+   const int k = (int) W.size();
+   E.SetSize(k);
+   for (int j = 0; j < k; j++)
+   {
+      for (int i = 0; i < j; i++)
+      {
+         E(i,j) = E(j,i) = 0.5*(Dot(W[i], AW[j]) + Dot(W[j], AW[i]));
+      }
+      E(j,j) = Dot(W[j], AW[j]);
+      if (!(E(j,j) > 0.0))
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "RecycledCG: The operator is not positive definite"
+                      " on the recycle space, discarding it.\n";
+         }
+         ClearRecycleSpace();
+         return;
+      }
+   }
+   E_fact = E;
+   E_factors.data = E_fact.Data();
+   if (!E_factors.Factor(k))
+   {
+      ClearRecycleSpace();
+   }
+}
+
+void RecycledCGSolver::ProjectCoarse(const Vector &v, real_t *h) const
+{
+   const int k = (int) W.size();
+   mu.SetSize(k);
+   for (int i = 0; i < k; i++)
+   {
+      h[i] = mu(i) = Dot(AW[i], v);
+   }
+   E_factors.Solve(k, 1, mu.GetData());
+}
+
+void RecycledCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   int i;
+   real_t r0, den, nom, nom0, betanom, alpha, beta;
+
+   const int k = (int) W.size();
+   const int max_np = std::min(recycle_dim > 0 ? num_retained : 0, max_iter);
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   int np = 0;
+   if ((int) P.size() < max_np)
+   {
+      P.resize(max_np);
+      AP.resize(max_np);
+   }
+   alphas.SetSize(max_np);
+   rhos.SetSize(max_np + 1);
+   dens.SetSize(max_np);
+   H.SetSize(k, max_np + 1);
+   Vector h(k);
+
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   if (k > 0)
+   {
+      // Galerkin projection of the initial error onto the recycle space:
+      // x = x + W (W^t A W)^{-1} W^t r, r = r - A W (W^t A W)^{-1} W^t r
+      mu.SetSize(k);
+      for (int j = 0; j < k; j++) { mu(j) = Dot(W[j], r); }
+      E_factors.Solve(k, 1, mu.GetData());
+      for (int j = 0; j < k; j++)
+      {
+         x.Add(mu(j), W[j]);
+         r.Add(-mu(j), AW[j]);
+      }
+   }
+
+   if (prec)
+   {
+      prec->Mult(r, z); // z = B r
+   }
+   Vector &Br = prec ? z : r;
+   nom0 = nom = Dot(Br, r);
+   if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
+   MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_options.first_and_last ? " ...\n" : "\n");
+   }
+
+   if (nom < 0.0)
+   {
+      if (print_options.warnings)
+      {
+         mfem::out << "RecycledCG: The preconditioner is not positive definite."
+                   " (Br, r) = " << nom << '\n';
+      }
+      converged = false;
+      final_iter = 0;
+      initial_norm = nom;
+      final_norm = nom;
+
+      Monitor(0, nom, r, x, true);
+      return;
+   }
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (Monitor(0, nom, r, x) || nom <= r0)
+   {
+      converged = true;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+
+      Monitor(0, nom, r, x, true);
+      return;
+   }
+
+   // d = B r - W (W^t A W)^{-1} (A W)^t B r
+   d = Br;
+   if (k > 0)
+   {
+      ProjectCoarse(Br, H.GetColumn(0));
+      for (int j = 0; j < k; j++) { d.Add(-mu(j), W[j]); }
+   }
+   rhos(0) = nom;
+
+   oper->Mult(d, Ad);  // Ad = A d
+   den = Dot(Ad, d);
+   MFEM_VERIFY(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
+   {
+      if (Dot(d, d) > 0.0 && print_options.warnings)
+      {
+         mfem::out << "RecycledCG: The operator is not positive definite."
+                   " (Ad, d) = " << den << '\n';
+      }
+      if (den == 0.0)
+      {
+         converged = false;
+         final_iter = 0;
+         final_norm = sqrt(nom);
+
+         Monitor(0, nom, r, x, true);
+         return;
+      }
+   }
+
+   // start iteration
+   converged = false;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      alpha = nom/den;
+      if (np == i - 1 && np < max_np && den > 0.0)
+      {
+         // Retain the search direction for the update of the recycle space
+         P[np].SetSize(width, mt);
+         P[np].UseDevice(true);
+         P[np] = d;
+         AP[np].SetSize(width, mt);
+         AP[np].UseDevice(true);
+         AP[np] = Ad;
+         alphas(np) = alpha;
+         dens(np) = den;
+         np++;
+      }
+      add(x,  alpha, d, x);     //  x = x + alpha d
+      add(r, -alpha, Ad, r);    //  r = r - alpha A d
+
+      if (prec)
+      {
+         prec->Mult(r, z);      //  z = B r
+      }
+      betanom = Dot(r, Br);
+      MFEM_VERIFY(IsFinite(betanom), "betanom = " << betanom);
+      if (np > 0 && np == i) { rhos(np) = betanom; }
+      if (betanom < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "RecycledCG: The preconditioner is not positive"
+                      " definite. (Br, r) = " << betanom << '\n';
+         }
+         converged = false;
+         final_iter = i;
+         break;
+      }
+
+      if (print_options.iterations)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << std::endl;
+      }
+
+      if (Monitor(i, betanom, r, x) || betanom <= r0)
+      {
+         converged = true;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      add(Br, beta, d, d);      //  d = B r + beta d
+      if (k > 0)
+      {
+         // Keep d A-conjugate to the recycle space, saving (A W)^t B r which is
+         // needed in the Ritz extraction
+         real_t *hcol = (i - 1 <= max_np) ? H.GetColumn(i - 1) : h.GetData();
+         ProjectCoarse(Br, hcol);
+         for (int j = 0; j < k; j++) { d.Add(-mu(j), W[j]); }
+      }
+      oper->Mult(d, Ad);        //  Ad = A d
+      den = Dot(d, Ad);
+      MFEM_VERIFY(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (Dot(d, d) > 0.0 && print_options.warnings)
+         {
+            mfem::out << "RecycledCG: The operator is not positive definite."
+                      " (Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      nom = betanom;
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << betanom << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "RecycledCG: Number of iterations: " << final_iter
+                << ", recycle dimension: " << k << '\n';
+   }
+   if (print_options.summary || print_options.iterations ||
+       print_options.first_and_last)
+   {
+      const auto arf = pow (betanom/nom0, 0.5/final_iter);
+      mfem::out << "Average reduction factor = " << arf << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "RecycledCG: No convergence!" << '\n';
+   }
+
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+
+   if (np > 0 && betanom >= 0.0)
+   {
+      if (k > 0 && final_iter == np)
+      {
+         // The loop stopped before (A W)^t B r was computed for the last
+         // retained direction
+         for (int j = 0; j < k; j++) { H(j,np) = Dot(AW[j], Br); }
+      }
+      UpdateRecycleSpace(np);
+   }
+}
+
+void RecycledCGSolver::UpdateRecycleSpace(int np) const
+{
+   const int k = (int) W.size();
+   const int m = k + np;
+
+   // Projected matrices of the generalized eigenproblem F y = theta G y with
+   // F = Z^t A B A Z, G = Z^t A Z, Z = [W, P], using the Lanczos relations
+   // A p_i = (r_i - r_{i+1})/alpha_i and the B-orthogonality of the residuals:
+   //   F_ww = (A W)^t B A W (stored), F_wp_i = (h_i - h_{i+1})/alpha_i,
+   //   F_pp tridiagonal, G = diag(W^t A W, (p_i, A p_i)).
+   DenseMatrix F(m), G(m);
+   F = 0.0;
+   G = 0.0;
+   for (int j = 0; j < k; j++)
+   {
+      for (int i = 0; i < k; i++)
+      {
+         F(i,j) = F_ww(i,j);
+         G(i,j) = E(i,j);
+      }
+      for (int l = 0; l < np; l++)
+      {
+         F(j,k+l) = F(k+l,j) = (H(j,l) - H(j,l+1))/alphas(l);
+      }
+   }
+   for (int l = 0; l < np; l++)
+   {
+      F(k+l,k+l) = (rhos(l) + rhos(l+1))/(alphas(l)*alphas(l));
+      if (l + 1 < np)
+      {
+         F(k+l,k+l+1) = F(k+l+1,k+l) = -rhos(l+1)/(alphas(l)*alphas(l+1));
+      }
+      G(k+l,k+l) = dens(l);
+   }
+
+   // Reduce to a standard eigenproblem with G = L L^t: C = L^{-1} F L^{-t}
+   CholeskyFactors G_factors(G.Data());
+   if (!G_factors.Factor(m)) { return; }
+   G_factors.LSolve(m, m, F.Data());
+   F.Transpose();
+   G_factors.LSolve(m, m, F.Data());
+   F.Symmetrize();
+   Vector theta;
+   DenseMatrix V;
+   JacobiEigensystem(F, theta, V);
+   G_factors.USolve(m, m, V.Data()); // columns of V are G-orthonormal
+
+   // Select the Ritz vectors with the smallest Ritz values
+   Array<int> order(m);
+   for (int i = 0; i < m; i++) { order[i] = i; }
+   std::sort(order.begin(), order.end(),
+             [&theta](int a, int b) { return theta(a) < theta(b); });
+   const int nk = std::min(recycle_dim, m);
+
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   std::vector<Vector> W_new(nk), AW_new(nk);
+   for (int c = 0; c < nk; c++)
+   {
+      const int col = order[c];
+      W_new[c].SetSize(width, mt);
+      W_new[c].UseDevice(true);
+      W_new[c] = 0.0;
+      AW_new[c].SetSize(width, mt);
+      AW_new[c].UseDevice(true);
+      AW_new[c] = 0.0;
+      for (int i = 0; i < m; i++)
+      {
+         W_new[c].Add(V(i,col), i < k ? W[i] : P[i-k]);
+         AW_new[c].Add(V(i,col), i < k ? AW[i] : AP[i-k]);
+      }
+   }
+   W.swap(W_new);
+   AW.swap(AW_new);
+
+   // With G-orthonormal Ritz vectors, (A W)^t B A W = diag(theta)
+   F_ww.SetSize(nk);
+   F_ww = 0.0;
+   for (int c = 0; c < nk; c++) { F_ww(c,c) = theta(order[c]); }
+   FactorCoarseMatrix();
+}
+
 
 inline void GeneratePlaneRotation(real_t &dx, real_t &dy,
                                   real_t &cs, real_t &sn)
@@ -3187,8 +4109,9 @@ void ResidualBCMonitor::MonitorResidual(
 void UMFPackSolver::Init()
 {
    mat = NULL;
-   Numeric = NULL;
+   Symbolic = Numeric = NULL;
    AI = AJ = NULL;
+   pattern_hash = 0;
    if (!use_long_ints)
    {
       umfpack_di_defaults(Control);
@@ -3201,8 +4124,6 @@ void UMFPackSolver::Init()
 
 void UMFPackSolver::SetOperator(const Operator &op)
 {
-   void *Symbolic;
-
    if (Numeric)
    {
       if (!use_long_ints)
@@ -3231,16 +4152,36 @@ void UMFPackSolver::SetOperator(const Operator &op)
    const int * Ai = mat->HostReadJ();
    const real_t * Ax = mat->HostReadData();
 
+   // Reuse the symbolic factorization if the sparsity pattern is unchanged
+   const std::uint64_t hash = HashInts64(Ai, Ap[width],
+                                         HashInts64(Ap, width + 1));
+   if (Symbolic && hash != pattern_hash)
+   {
+      if (!use_long_ints)
+      {
+         umfpack_di_free_symbolic(&Symbolic);
+      }
+      else
+      {
+         umfpack_dl_free_symbolic(&Symbolic);
+      }
+   }
+   pattern_hash = hash;
+
    if (!use_long_ints)
    {
-      int status = umfpack_di_symbolic(width, width, Ap, Ai, Ax, &Symbolic,
-                                       Control, Info);
-      if (status < 0)
+      int status;
+      if (!Symbolic)
       {
-         umfpack_di_report_info(Control, Info);
-         umfpack_di_report_status(Control, status);
-         mfem_error("UMFPackSolver::SetOperator :"
-                    " umfpack_di_symbolic() failed!");
+         status = umfpack_di_symbolic(width, width, Ap, Ai, Ax, &Symbolic,
+                                      Control, Info);
+         if (status < 0)
+         {
+            umfpack_di_report_info(Control, Info);
+            umfpack_di_report_status(Control, status);
+            mfem_error("UMFPackSolver::SetOperator :"
+                       " umfpack_di_symbolic() failed!");
+         }
       }
 
       status = umfpack_di_numeric(Ap, Ai, Ax, Symbolic, &Numeric,
@@ -3252,7 +4193,6 @@ void UMFPackSolver::SetOperator(const Operator &op)
          mfem_error("UMFPackSolver::SetOperator :"
                     " umfpack_di_numeric() failed!");
       }
-      umfpack_di_free_symbolic(&Symbolic);
    }
    else
    {
@@ -3271,14 +4211,17 @@ void UMFPackSolver::SetOperator(const Operator &op)
          AJ[i] = (SuiteSparse_long)(Ai[i]);
       }
 
-      status = umfpack_dl_symbolic(width, width, AI, AJ, Ax, &Symbolic,
-                                   Control, Info);
-      if (status < 0)
+      if (!Symbolic)
       {
-         umfpack_dl_report_info(Control, Info);
-         umfpack_dl_report_status(Control, status);
-         mfem_error("UMFPackSolver::SetOperator :"
-                    " umfpack_dl_symbolic() failed!");
+         status = umfpack_dl_symbolic(width, width, AI, AJ, Ax, &Symbolic,
+                                      Control, Info);
+         if (status < 0)
+         {
+            umfpack_dl_report_info(Control, Info);
+            umfpack_dl_report_status(Control, status);
+            mfem_error("UMFPackSolver::SetOperator :"
+                       " umfpack_dl_symbolic() failed!");
+         }
       }
 
       status = umfpack_dl_numeric(AI, AJ, Ax, Symbolic, &Numeric,
@@ -3290,7 +4233,6 @@ void UMFPackSolver::SetOperator(const Operator &op)
          mfem_error("UMFPackSolver::SetOperator :"
                     " umfpack_dl_numeric() failed!");
       }
-      umfpack_dl_free_symbolic(&Symbolic);
    }
 }
 
@@ -3381,6 +4323,17 @@ UMFPackSolver::~UMFPackSolver()
          umfpack_dl_free_numeric(&Numeric);
       }
    }
+   if (Symbolic)
+   {
+      if (!use_long_ints)
+      {
+         umfpack_di_free_symbolic(&Symbolic);
+      }
+      else
+      {
+         umfpack_dl_free_symbolic(&Symbolic);
+      }
+   }
 }
 
 void KLUSolver::Init()
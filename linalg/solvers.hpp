@@ -15,7 +15,9 @@
 #include "../config/config.hpp"
 #include "densemat.hpp"
 #include "handle.hpp"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #ifdef MFEM_USE_MPI
 #include <mpi.h>
@@ -495,6 +497,188 @@ private:
 };
 
 
+/** @brief Diagonally scaled polynomial smoother/preconditioner B = q(M) D^{-1},
+    where M = D^{-1} A.
+
+    The following polynomials q are supported:
+    - CHEBYSHEV_4TH_KIND: Chebyshev polynomials of the 4th kind, which only
+      require an upper bound of the spectrum of M, see J. Lottes, "Optimal
+      polynomial smoothers for multigrid V-cycles", 2023.
+    - OPT_CHEBYSHEV_4TH_KIND: the 4th-kind polynomials with the optimized
+      weights from the same reference, available for orders up to 6.
+    - GMRES_POLYNOMIAL: the polynomial computed by @a order steps of GMRES for
+      M applied to a random vector, which does not require the operator to be
+      symmetric positive definite.
+
+    Both Chebyshev variants are well-suited as multigrid smoothers with the
+    l1-Jacobi scaling D_ii = sum_j |A_ij|, in which case the spectrum of M is
+    bounded by 1 and the estimate can be set with SetSpectralEstimate().
+
+    The spectral information (the largest eigenvalue of M and its eigenvector
+    for the Chebyshev polynomials, the Arnoldi relation for the GMRES
+    polynomial) is computed in the first SetOperator() call. In subsequent
+    calls the cached information is validated with a single application of the
+    new operator, and recomputed only if the validation fails or after a given
+    number of reuses, see SetSpectralEstimateReuse(). Recomputations of the
+    largest eigenvalue are warm-started from the cached eigenvector.
+
+    The operator is assumed to act as the identity on the entries of
+    @a ess_tdof_list, as in OperatorChebyshevSmoother. */
+class PolynomialSmoother : public Solver
+{
+public:
+   /// Type of the polynomial
+   enum Type
+   {
+      CHEBYSHEV_4TH_KIND,     ///< Chebyshev polynomials of the 4th kind
+      OPT_CHEBYSHEV_4TH_KIND, ///< 4th kind with optimized weights, order <= 6
+      GMRES_POLYNOMIAL        ///< GMRES polynomial
+   };
+
+protected:
+   const Type type;
+   const int order;
+   const Operator *oper = nullptr;
+   Array<int> ess_tdof_list;
+   Vector dinv;
+
+   /// Largest eigenvalue estimate of M and the corresponding eigenvector
+   real_t max_eig = 0.0;
+   Vector eig_vec;
+   /// Whether the largest eigenvalue was set by the user
+   bool user_max_eig = false;
+
+   /// Arnoldi relation for the GMRES polynomial: Hessenberg matrix, the
+   /// coefficients of q in the Arnoldi basis, and the starting vector
+   DenseMatrix hess;
+   Vector gmres_coeffs, gmres_vec;
+   int gmres_order = 0;
+
+   /// Optimized weights of the OPT_CHEBYSHEV_4TH_KIND polynomial
+   Array<real_t> betas;
+
+   /// Spectral estimate reuse parameters and statistics
+   int max_reuse = 10, num_reuse = 0, num_estimates = 0;
+   real_t reuse_tol = 0.05;
+   real_t safety_factor = 1.1;
+   int power_iterations = 10;
+   real_t power_tolerance = 1e-8;
+   int print_level = 0;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm = MPI_COMM_NULL;
+#endif
+
+   mutable std::vector<Vector> R, D, W;
+   mutable Vector tmp;
+
+   real_t Dot(const Vector &x, const Vector &y) const;
+
+   /// Compute y = M x = D^{-1} A x
+   void ApplyM(const Vector &x, Vector &y) const;
+
+   /// Return the Rayleigh quotient (v, M v) / (v, v) of the current operator
+   real_t RayleighQuotient(const Vector &v) const;
+
+   /// Validate the cached spectral information, recomputing it if needed.
+   void UpdateSpectralEstimate();
+
+   /// Estimate the largest eigenvalue of M with the power method.
+   void EstimateMaxEigenvalue();
+
+   /// Compute the Arnoldi relation and the coefficients of the GMRES
+   /// polynomial.
+   void ComputeGMRESPolynomial();
+
+   void ApplyChebyshev(const Array<const Vector *> &X,
+                       const Array<Vector *> &Y) const;
+
+   void ApplyGMRES(const Vector &x, Vector &y) const;
+
+public:
+   /** @brief Construct a smoother with the given @a order and @a type. The
+       operator and the diagonal must be set with SetOperator(). */
+#ifdef MFEM_USE_MPI
+   PolynomialSmoother(int order, Type type = CHEBYSHEV_4TH_KIND,
+                      MPI_Comm comm = MPI_COMM_NULL);
+#else
+   PolynomialSmoother(int order, Type type = CHEBYSHEV_4TH_KIND);
+#endif
+
+   /** @brief Construct a smoother for @a op scaled by the inverse of @a diag
+       with the given @a order and @a type. The spectral information is
+       computed immediately. */
+#ifdef MFEM_USE_MPI
+   PolynomialSmoother(const Operator &op, const Vector &diag,
+                      const Array<int> &ess_tdof_list, int order,
+                      Type type = CHEBYSHEV_4TH_KIND,
+                      MPI_Comm comm = MPI_COMM_NULL);
+#else
+   PolynomialSmoother(const Operator &op, const Vector &diag,
+                      const Array<int> &ess_tdof_list, int order,
+                      Type type = CHEBYSHEV_4TH_KIND);
+#endif
+
+   /** @brief Set the list of essential true dofs, on which the scaling is set
+       to one. Must be called before SetDiagonal(). */
+   void SetEssentialTrueDofs(const Array<int> &ess_tdofs)
+   { ess_tdof_list = ess_tdofs; }
+
+   /// Set the diagonal scaling D, e.g. the diagonal or the l1 row sums of A.
+   void SetDiagonal(const Vector &diag);
+
+   /** @brief Set the operator and update the cached spectral information.
+       The diagonal must be set with SetDiagonal(), or with the overload
+       below. */
+   void SetOperator(const Operator &op) override;
+
+   /// Set the diagonal scaling and the operator.
+   void SetOperator(const Operator &op, const Vector &diag)
+   { SetDiagonal(diag); SetOperator(op); }
+
+   /** @brief Reuse the cached spectral information in at most @a max_reuse
+       consecutive SetOperator() calls, as long as the relative change of the
+       validation Rayleigh quotient is below @a tol. With @a max_reuse = 0 the
+       spectral information is recomputed in each SetOperator() call. */
+   void SetSpectralEstimateReuse(int max_reuse_, real_t tol = 0.05)
+   { max_reuse = max_reuse_; reuse_tol = tol; }
+
+   /// Set the parameters of the power method used for the Chebyshev variants.
+   void SetPowerIterations(int iterations, real_t tol = 1e-8)
+   { power_iterations = iterations; power_tolerance = tol; }
+
+   /** @brief Set the factor by which the estimated largest eigenvalue is
+       multiplied to obtain the upper bound of the spectrum (default 1.1). */
+   void SetSafetyFactor(real_t factor) { safety_factor = factor; }
+
+   /** @brief Set the largest eigenvalue of M, e.g. 1 for l1-Jacobi scaling,
+       which disables its estimation. A non-positive value re-enables it. */
+   void SetSpectralEstimate(real_t max_eig_);
+
+   /// Print the spectral estimates when @a level > 0.
+   void SetPrintLevel(int level) { print_level = level; }
+
+   /// Return the estimate of the largest eigenvalue of M.
+   real_t GetSpectralEstimate() const { return max_eig; }
+
+   /// Return the number of times the spectral information was computed.
+   int GetNumSpectralEstimates() const { return num_estimates; }
+
+   /// Apply the smoother, supports iterative mode.
+   void Mult(const Vector &x, Vector &y) const override;
+
+   /** @brief Same as Mult(), since B is symmetric when A is symmetric. */
+   void MultTranspose(const Vector &x, Vector &y) const override
+   { Mult(x, y); }
+
+   /** @brief Apply the smoother to multiple vectors. For the Chebyshev variants
+       the operator is applied to all vectors at once with
+       Operator::ArrayMult(). */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
+};
+
+
 /// Stationary linear iteration: x <- x + B (b - A x)
 class SLISolver : public IterativeSolver
 {
@@ -562,6 +746,97 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
          real_t RTOLERANCE = 1e-12, real_t ATOLERANCE = 1e-24);
 
 
+/// Deflated conjugate gradient method with Krylov subspace recycling
+/** The solver maintains a recycle space W of dimension up to SetRecycleDim()
+    which is used to deflate each solve: the initial guess is corrected by a
+    Galerkin projection onto W and the search directions are kept A-conjugate
+    to W, following Saad, Yeung, Erhel and Guyomarc'h, "A deflated version of
+    the conjugate gradient algorithm", SIAM J. Sci. Comput. 21 (2000).
+
+    After every call to Mult(), W is replaced by the Ritz vectors associated
+    with the smallest Ritz values of the preconditioned operator B A, computed
+    from span{W, p_0, ..., p_{s-1}} where p_i are the first s search directions
+    of the solve (see SetNumRetainedDirections()). The recycle space persists
+    across SetOperator() calls as long as the size of the operator does not
+    change, so sequences of linear systems with slowly varying matrices (e.g.
+    implicit time stepping) converge in fewer iterations than with CGSolver.
+
+    Both the operator and the preconditioner must be symmetric positive
+    definite. The memory overhead is 2 (k + s) vectors, where k is the recycle
+    dimension and s the number of retained search directions. The projected
+    matrices needed by the Ritz extraction are obtained from the CG scalars
+    via the Lanczos relations, so the update requires no additional operator
+    or preconditioner applications. */
+class RecycledCGSolver : public IterativeSolver
+{
+protected:
+   int recycle_dim, num_retained;
+
+   mutable Vector r, d, z, Ad;
+
+   /// Recycle space W and A W.
+   mutable std::vector<Vector> W, AW;
+   /// Coarse matrix W^t A W, its Cholesky factors and (A W)^t B (A W), where
+   /// B is the preconditioner.
+   mutable DenseMatrix E, E_fact, F_ww;
+   mutable CholeskyFactors E_factors;
+   /// Search directions p_i and A p_i retained from the last solve.
+   mutable std::vector<Vector> P, AP;
+   /// CG scalars of the retained directions: alpha_i, (r_i, B r_i) and
+   /// (p_i, A p_i); the columns of H are (A W)^t B r_i.
+   mutable Vector alphas, rhos, dens;
+   mutable DenseMatrix H;
+   mutable Vector mu;
+
+   void UpdateVectors();
+
+   /// Recompute A W and the coarse matrices for the current operator and
+   /// preconditioner.
+   void UpdateRecycleOperators() const;
+
+   /// Factor the coarse matrix W^t A W, drop W if it is not SPD.
+   void FactorCoarseMatrix() const;
+
+   /// Set @a h = (A W)^t @a v and @a mu = (W^t A W)^{-1} @a h.
+   void ProjectCoarse(const Vector &v, real_t *h) const;
+
+   /// Replace W with the Ritz vectors extracted from span{W, P}, where P
+   /// holds the first @a np search directions of the last solve.
+   void UpdateRecycleSpace(int np) const;
+
+public:
+   RecycledCGSolver() : recycle_dim(8), num_retained(16) { }
+
+#ifdef MFEM_USE_MPI
+   RecycledCGSolver(MPI_Comm comm_)
+      : IterativeSolver(comm_), recycle_dim(8), num_retained(16) { }
+#endif
+
+   /// Set the maximal dimension of the recycle space, default is 8.
+   void SetRecycleDim(int dim);
+
+   /** @brief Set the number of search directions of each solve used to
+       update the recycle space, default is 16. */
+   void SetNumRetainedDirections(int num) { num_retained = num; }
+
+   /// Return the current dimension of the recycle space.
+   int GetRecycleDim() const { return (int) W.size(); }
+
+   /// Discard the recycle space; the next solve is a standard PCG solve.
+   void ClearRecycleSpace() const;
+
+   void SetPreconditioner(Solver &pr) override;
+
+   /** @brief Set the operator, keeping the recycle space if the size of the
+       operator is unchanged. */
+   void SetOperator(const Operator &op) override;
+
+   /** @brief Iterative solution of the linear system using the deflated
+       Conjugate Gradient method. */
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
+
 /// GMRES method
 class GMRESSolver : public IterativeSolver
 {
@@ -1117,9 +1392,12 @@ class UMFPackSolver : public Solver
 protected:
    bool use_long_ints;
    SparseMatrix *mat;
-   void *Numeric;
+   void *Symbolic, *Numeric;
    SuiteSparse_long *AI, *AJ;
 
+   /// Hash of the sparsity pattern of the matrix used to compute #Symbolic
+   std::uint64_t pattern_hash;
+
    void Init();
 
 public:
@@ -1139,6 +1417,9 @@ public:
    /** @brief Factorize the given Operator @a op which must be a SparseMatrix.
 
        The factorization uses the parameters set in the #Control data member.
+       The symbolic factorization (ordering and analysis) is reused if the
+       sparsity pattern of @a op is the same as the one of the previous call,
+       as detected by hashing its I and J arrays.
        @note This method calls SparseMatrix::SortColumnIndices() with @a op,
        modifying the matrix if the column indices are not already sorted. */
    void SetOperator(const Operator &op) override;
@@ -15,6 +15,7 @@
 #ifdef MFEM_USE_MPI
 
 #include "strumpack.hpp"
+#include "../general/hash.hpp"
 
 namespace mfem
 {
@@ -41,6 +42,9 @@ STRUMPACKRowLocMatrix::STRUMPACKRowLocMatrix(MPI_Comm comm,
    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
                  dist.GetData() + 1, 1, HYPRE_MPI_BIG_INT, comm);
 
+   pattern_hash_ = HashInts64(J, I[num_loc_rows],
+                              HashInts64(I, num_loc_rows + 1, first_loc_row));
+
 #if !(defined(HYPRE_BIGINT) || defined(HYPRE_MIXEDINT))
    A_ = new strumpack::CSRMatrixMPI<double, HYPRE_BigInt>(
       (HYPRE_BigInt)num_loc_rows, I, J, data, dist.GetData(),
@@ -95,6 +99,9 @@ STRUMPACKRowLocMatrix::STRUMPACKRowLocMatrix(const Operator &op,
    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
                  dist.GetData() + 1, 1, HYPRE_MPI_BIG_INT, comm);
 
+   pattern_hash_ = HashInts64(Jptr, csr_op->num_nonzeros,
+                              HashInts64(Iptr, m_loc + 1, fst_row));
+
 #if !defined(HYPRE_MIXEDINT)
    A_ = new strumpack::CSRMatrixMPI<double, HYPRE_BigInt>(
       (HYPRE_BigInt)m_loc, Iptr, Jptr, data, dist.GetData(),
@@ -123,6 +130,7 @@ STRUMPACKSolverBase(MPI_Comm comm, int argc, char *argv[])
      factor_verbose_(false),
      solve_verbose_(false),
      reorder_reuse_(false),
+     pattern_hash_(0),
      nrhs_(-1)
 {
    solver_ = new STRUMPACKSolverType(comm, argc, argv, false);
@@ -135,6 +143,7 @@ STRUMPACKSolverBase(STRUMPACKRowLocMatrix &A, int argc, char *argv[])
      factor_verbose_(false),
      solve_verbose_(false),
      reorder_reuse_(false),
+     pattern_hash_(0),
      nrhs_(-1)
 {
    solver_ = new STRUMPACKSolverType(A.GetComm(), argc, argv, false);
@@ -313,7 +322,14 @@ SetOperator(const Operator &op)
    height = op.Height();
    width  = op.Width();
 
-   if (first_mat || !reorder_reuse_)
+   // Reuse the reordering and symbolic factorization of the previous matrix
+   // if the sparsity pattern is unchanged on all ranks
+   int same_pattern = !first_mat && (APtr_->GetPatternHash() == pattern_hash_);
+   MPI_Allreduce(MPI_IN_PLACE, &same_pattern, 1, MPI_INT, MPI_MIN,
+                 APtr_->GetComm());
+   pattern_hash_ = APtr_->GetPatternHash();
+
+   if (first_mat || !(reorder_reuse_ || same_pattern))
    {
       solver_->set_matrix(*(APtr_->GetA()));
    }
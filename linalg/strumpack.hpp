@@ -20,6 +20,7 @@
 #include "operator.hpp"
 #include "hypre.hpp"
 #include <mpi.h>
+#include <cstdint>
 
 // STRUMPACK headers
 #include "StrumpackSparseSolverMPIDist.hpp"
@@ -64,8 +65,12 @@ public:
    /// Get access to the internal CSR matrix.
    strumpack::CSRMatrixMPI<double, HYPRE_BigInt> *GetA() const { return A_; }
 
+   /// Get the hash of the local sparsity pattern (I and J arrays).
+   std::uint64_t GetPatternHash() const { return pattern_hash_; }
+
 private:
    strumpack::CSRMatrixMPI<double, HYPRE_BigInt> *A_;
+   std::uint64_t pattern_hash_;
 };
 
 /** The MFEM STRUMPACK Direct Solver class.
@@ -131,7 +136,10 @@ public:
    /** @brief Set the flag controlling reuse of the symbolic factorization for
        multiple operators.
 
-       This method must be called before repeated calls to SetOperator. */
+       This method must be called before repeated calls to SetOperator. Even
+       when this flag is not set, the symbolic factorization is reused if the
+       sparsity pattern of the new operator is identical to the previous one,
+       as detected by hashing the local I and J arrays. */
    void SetReorderingReuse(bool reuse);
 
    /** @brief Enable GPU off-loading available if STRUMPACK was compiled with
@@ -276,6 +284,10 @@ protected:
    bool solve_verbose_;
    bool reorder_reuse_;
 
+   // Hash of the local sparsity pattern of the last operator, used to reuse the
+   // reordering and symbolic factorization when it is unchanged
+   std::uint64_t pattern_hash_;
+
    mutable Vector rhs_, sol_;
    mutable int    nrhs_;
 };
@@ -15,6 +15,7 @@
 #ifdef MFEM_USE_MPI
 
 #include "superlu.hpp"
+#include "../general/hash.hpp"
 
 // SuperLU header
 #include "superlu_ddefs.h"
@@ -167,6 +168,8 @@ SuperLURowLocMatrix::SuperLURowLocMatrix(MPI_Comm comm,
    // Save global number of rows and columns of the matrix
    num_global_rows_ = m;
    num_global_cols_ = n;
+   pattern_hash_ = HashInts64(colind, nnz_loc,
+                              HashInts64(rowptr, m_loc + 1, fst_row));
 }
 
 SuperLURowLocMatrix::SuperLURowLocMatrix(const Operator &op)
@@ -250,6 +253,8 @@ SuperLURowLocMatrix::SuperLURowLocMatrix(const Operator &op)
    // Save global number of rows and columns of the matrix
    num_global_rows_ = m;
    num_global_cols_ = n;
+   pattern_hash_ = HashInts64(colind, nnz_loc,
+                              HashInts64(rowptr, m_loc + 1, fst_row));
 }
 
 SuperLURowLocMatrix::~SuperLURowLocMatrix()
@@ -264,7 +269,8 @@ SuperLUSolver::SuperLUSolver(MPI_Comm comm, int npdep)
      npcol_(GetGridCols(comm, npdep, nprow_)),
      npdep_(npdep),
      APtr_(NULL),
-     nrhs_(0)
+     nrhs_(0),
+     pattern_hash_(0)
 {
    Init(comm);
 }
@@ -506,6 +512,14 @@ void SuperLUSolver::SetOperator(const Operator &op)
    height = op.Height();
    width  = op.Width();
 
+   // Check if the sparsity pattern is the same as the one of the previous
+   // matrix on all ranks
+   int same_pattern = LUStructInitialized &&
+                      (APtr_->GetPatternHash() == pattern_hash_);
+   MPI_Allreduce(MPI_IN_PLACE, &same_pattern, 1, MPI_INT, MPI_MIN,
+                 APtr_->GetComm());
+   pattern_hash_ = APtr_->GetPatternHash();
+
    if (!LUStructInitialized)
    {
       // Initialize ScalePermstruct and LUstruct once for all operators (must
@@ -580,7 +594,12 @@ void SuperLUSolver::SetOperator(const Operator &op)
                        "options->Fact!");
             break;
       }
-      if (options->Fact == FACTORED) { options->Fact = DOFACT; }
+      if (options->Fact == FACTORED)
+      {
+         // Reuse the column permutation and the elimination tree of the
+         // previous matrix if the sparsity pattern is unchanged
+         options->Fact = (same_pattern && npdep_ == 1) ? SamePattern : DOFACT;
+      }
    }
 }
 
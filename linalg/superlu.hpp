@@ -20,6 +20,7 @@
 #include "operator.hpp"
 #include "hypre.hpp"
 #include <mpi.h>
+#include <cstdint>
 
 namespace mfem
 {
@@ -145,10 +146,14 @@ public:
    /// Get the number of global columns in this matrix
    HYPRE_BigInt GetGlobalNumColumns() const { return num_global_cols_; }
 
+   /// Get the hash of the local sparsity pattern (I and J arrays)
+   std::uint64_t GetPatternHash() const { return pattern_hash_; }
+
 private:
    MPI_Comm     comm_;
    void        *rowLocPtr_;
    HYPRE_BigInt num_global_rows_, num_global_cols_;
+   std::uint64_t pattern_hash_;
 };
 
 /** The MFEM wrapper around the SuperLU Direct Solver class.
@@ -278,6 +283,10 @@ protected:
    mutable Vector             sol_;
    mutable int                nrhs_;
 
+   // Hash of the local sparsity pattern of the last operator, used to reuse the
+   // column permutation and symbolic factorization when it is unchanged
+   std::uint64_t pattern_hash_;
+
    /** The actual types of the following pointers are hidden to avoid exposing
        the SuperLU header files to the entire library. Their types are given in
        the trailing comments. The reason that this is necessary is that SuperLU
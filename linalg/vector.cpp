@@ -14,6 +14,7 @@
 #include "kernels.hpp"
 #include "vector.hpp"
 #include "../general/forall.hpp"
+#include "../general/binaryio.hpp"
 
 #ifdef MFEM_USE_OPENMP
 #include <omp.h>
@@ -23,6 +24,7 @@
 #include <iomanip>
 #include <cmath>
 #include <ctime>
+#include <climits>
 #include <limits>
 
 namespace mfem
@@ -92,6 +94,24 @@ void Vector::Load(std::istream &in, int Size)
    }
 }
 
+void Vector::LoadBinary(std::istream &in)
+{
+   std::string ident;
+   std::getline(in, ident);
+   MFEM_VERIFY(ident == "MFEM binary vector v1.0",
+               "invalid binary vector header: " << ident);
+   int64_t hdr[3];
+   in.read(reinterpret_cast<char*>(hdr), sizeof(hdr));
+   MFEM_VERIFY(in, "unexpected end of binary data");
+   MFEM_VERIFY(hdr[0] == 0x0102030405060708,
+               "binary vector written with a different byte order");
+   MFEM_VERIFY(hdr[1] == sizeof(real_t),
+               "binary vector written with a different real_t type");
+   MFEM_VERIFY(hdr[2] >= 0 && hdr[2] <= INT_MAX, "invalid vector size");
+   SetSize(int(hdr[2]));
+   bin_io::ReadBlocks(in, HostWrite(), size*sizeof(real_t));
+}
+
 real_t &Vector::Elem(int i)
 {
    return operator()(i);
@@ -826,6 +846,15 @@ void Vector::PrintMathematica(std::ostream & os) const
    os.flags(old_fmt);
 }
 
+void Vector::PrintBinary(std::ostream &os, int compression_level) const
+{
+   os << "MFEM binary vector v1.0\n";
+   const int64_t hdr[3] = { 0x0102030405060708, sizeof(real_t), size };
+   os.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+   bin_io::WriteBlocks(os, HostRead(), size*sizeof(real_t),
+                       compression_level);
+}
+
 void Vector::PrintHash(std::ostream &os) const
 {
    os << "size: " << size << '\n';
@@ -155,6 +155,10 @@ public:
    /// Load a vector from an input stream, reading the size from the stream.
    void Load(std::istream &in) { int s; in >> s; Load(in, s); }
 
+   /** @brief Load a vector, written with PrintBinary(), from an input stream,
+       reading the size from the stream. */
+   void LoadBinary(std::istream &in);
+
    /// @brief Resize the vector to size @a s.
    /** If the new size is less than or equal to Capacity() then the internal
        data array remains the same. Otherwise, the old array is deleted, if
@@ -437,6 +441,12 @@ public:
    void Print(adios2stream & out, const std::string& variable_name) const;
 #endif
 
+   /// Prints vector to the binary stream out, without loss of precision.
+   /** The data is compressed with zlib when @a compression_level is not zero,
+       see bin_io::WriteBlocks(). The vector can be read back with
+       LoadBinary(). */
+   void PrintBinary(std::ostream &out, int compression_level = 0) const;
+
    /// Prints vector to stream out in HYPRE_Vector format.
    void Print_HYPRE(std::ostream &out) const;
 
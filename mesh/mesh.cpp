@@ -34,6 +34,13 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
 #if defined(MFEM_USE_METIS) && defined(MFEM_USE_METIS_5)
@@ -4459,6 +4466,33 @@ Mesh Mesh::LoadFromFile(const std::string &filename, int generate_edges,
    return mesh;
 }
 
+Mesh Mesh::LoadFromBinaryFile(const std::string &filename, int refine,
+                              bool fix_orientation)
+{
+   Mesh mesh;
+#ifndef _WIN32
+   const int fd = open(filename.c_str(), O_RDONLY);
+   MFEM_VERIFY(fd >= 0, "Mesh file not found: " << filename);
+   struct stat st;
+   const bool stat_ok = (fstat(fd, &st) == 0 && st.st_size > 0);
+   void *data = stat_ok ?
+                mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) :
+                MAP_FAILED;
+   close(fd);
+   MFEM_VERIFY(data != MAP_FAILED, "Error mapping mesh file: " << filename);
+   mesh.ReadMFEMBinaryMesh(static_cast<const char*>(data), st.st_size);
+   munmap(data, st.st_size);
+#else
+   std::ifstream ifs(filename, std::ios::binary);
+   MFEM_VERIFY(ifs, "Mesh file not found: " << filename);
+   std::vector<char> buf((std::istreambuf_iterator<char>(ifs)),
+                         std::istreambuf_iterator<char>());
+   mesh.ReadMFEMBinaryMesh(buf.data(), buf.size());
+#endif
+   mesh.Finalize(refine, fix_orientation);
+   return mesh;
+}
+
 Mesh Mesh::MakeCartesian1D(int n, real_t sx)
 {
    Mesh mesh;
@@ -4868,6 +4902,12 @@ void Mesh::Loader(std::istream &input, int generate_edges,
          ncmesh = NULL;
       }
    }
+   else if (mesh_type == "MFEM binary mesh v1.0")
+   {
+      // the topology and the nodes are set up by the reader
+      ReadMFEMBinaryMesh(input);
+      finalize_topo = false;
+   }
    else if (mesh_type == "linemesh") // 1D mesh
    {
       ReadLineMesh(input);
@@ -9387,6 +9427,58 @@ void Mesh::UpdateNodes()
    }
 }
 
+// Return in @a edge_vert the two vertices of each of the @a nedges edges of
+// @a elems, numbered as in @a elem_to_edge.
+static void GetEdgeVertexPairs(const Array<Element*> &elems,
+                               const Table &elem_to_edge, int nedges,
+                               Array<int> &edge_vert)
+{
+   edge_vert.SetSize(2*nedges);
+   for (int i = 0; i < elems.Size(); i++)
+   {
+      const int *v = elems[i]->GetVertices();
+      const int *e = elem_to_edge.GetRow(i);
+      for (int k = 0; k < elems[i]->GetNEdges(); k++)
+      {
+         const int *ev = elems[i]->GetEdgeVertices(k);
+         edge_vert[2*e[k]] = v[ev[0]];
+         edge_vert[2*e[k]+1] = v[ev[1]];
+      }
+   }
+}
+
+// Return in @a e2v the position of each edge, given by its vertices
+// @a edge_vert, in the order of the pairs (smaller vertex, larger vertex).
+// The edges are sorted by their smaller vertex with a counting sort, using a
+// prefix sum over the @a nv vertices.
+static void GetEdgeOrder(const Array<int> &edge_vert, int nv, Array<int> &e2v)
+{
+   const int nedges = edge_vert.Size()/2;
+   Array<int> row(nv + 1);
+   row = 0;
+   for (int ei = 0; ei < nedges; ei++)
+   {
+      row[std::min(edge_vert[2*ei], edge_vert[2*ei+1]) + 1]++;
+   }
+   row.PartialSum();
+   Array<int> pos(row);
+   Array<Pair<int,int> > col(nedges); // (larger vertex, edge)
+   for (int ei = 0; ei < nedges; ei++)
+   {
+      const int v0 = edge_vert[2*ei], v1 = edge_vert[2*ei+1];
+      col[pos[std::min(v0, v1)]++] = Pair<int,int>(std::max(v0, v1), ei);
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nv; i++)
+   {
+      std::sort(col.GetData() + row[i], col.GetData() + row[i+1]);
+   }
+   e2v.SetSize(nedges);
+   for (int k = 0; k < nedges; k++) { e2v[col[k].two] = k; }
+}
+
 void Mesh::UniformRefinement2D_base(bool update_nodes)
 {
    ResetLazyData();
@@ -9397,13 +9489,14 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
       NumOfEdges = GetElementToEdgeTable(*el_to_edge);
    }
 
-   int quad_counter = 0;
+   // The center vertices of the quadrilaterals are numbered in the order of
+   // the elements, using a prefix sum of the quadrilateral counts.
+   Array<int> quad_offset(NumOfElements + 1);
+   quad_offset[0] = 0;
    for (int i = 0; i < NumOfElements; i++)
    {
-      if (elements[i]->GetType() == Element::QUADRILATERAL)
-      {
-         quad_counter++;
-      }
+      const bool quad = (elements[i]->GetType() == Element::QUADRILATERAL);
+      quad_offset[i+1] = quad_offset[i] + quad;
    }
 
    const int oedge = NumOfVertices;
@@ -9412,9 +9505,29 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
    Array<Element*> new_elements;
    Array<Element*> new_boundary;
 
-   vertices.SetSize(oelem + quad_counter);
+   vertices.SetSize(oelem + quad_offset[NumOfElements]);
    new_elements.SetSize(4 * NumOfElements);
-   quad_counter = 0;
+
+   // Each new vertex is computed once, so that these loops can run in parallel
+   Array<int> edge_vert;
+   GetEdgeVertexPairs(elements, *el_to_edge, NumOfEdges, edge_vert);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int ei = 0; ei < NumOfEdges; ei++)
+   {
+      AverageVertices(&edge_vert[2*ei], 2, oedge + ei);
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      if (elements[i]->GetType() == Element::QUADRILATERAL)
+      {
+         AverageVertices(elements[i]->GetVertices(), 4, oelem + quad_offset[i]);
+      }
+   }
 
    for (int i = 0, j = 0; i < NumOfElements; i++)
    {
@@ -9422,19 +9535,9 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
       const int attr = elements[i]->GetAttribute();
       int *v = elements[i]->GetVertices();
       const int *e = el_to_edge->GetRow(i);
-      int vv[2];
 
       if (el_type == Element::TRIANGLE)
       {
-         for (int ei = 0; ei < 3; ei++)
-         {
-            for (int k = 0; k < 2; k++)
-            {
-               vv[k] = v[tri_t::Edges[ei][k]];
-            }
-            AverageVertices(vv, 2, oedge+e[ei]);
-         }
-
          new_elements[j++] =
             new Triangle(v[0], oedge+e[0], oedge+e[2], attr);
          new_elements[j++] =
@@ -9446,18 +9549,7 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
       }
       else if (el_type == Element::QUADRILATERAL)
       {
-         const int qe = quad_counter;
-         quad_counter++;
-         AverageVertices(v, 4, oelem+qe);
-
-         for (int ei = 0; ei < 4; ei++)
-         {
-            for (int k = 0; k < 2; k++)
-            {
-               vv[k] = v[quad_t::Edges[ei][k]];
-            }
-            AverageVertices(vv, 2, oedge+e[ei]);
-         }
+         const int qe = quad_offset[i];
 
          new_elements[j++] =
             new Quadrilateral(v[0], oedge+e[0], oelem+qe, oedge+e[3], attr);
@@ -9546,7 +9638,123 @@ static inline real_t sqr(const real_t &x)
    return x*x;
 }
 
-void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
+// Return the refinement type of the tetrahedron with the Jacobian @a J at its
+// center, i.e. the diagonal of its interior octahedron:
+// 0: (v0,v1)-(v2,v3), 1: (v0,v2)-(v1,v3), 2: (v0,v3)-(v1,v2)
+// 0:      e0-e5,      1:      e1-e4,      2:      e2-e3
+static int GetTetRefinementType(const DenseMatrix &J)
+{
+   // Algorithm for choosing refinement type:
+   // 0: smallest octahedron diagonal
+   // 1: best aspect ratio
+   const int rt_algo = 1;
+   int rt;
+   if (rt_algo == 0)
+   {
+      // smallest octahedron diagonal
+      real_t len_sqr, min_len;
+
+      min_len = sqr(J(0,0)-J(0,1)-J(0,2)) +
+                sqr(J(1,0)-J(1,1)-J(1,2)) +
+                sqr(J(2,0)-J(2,1)-J(2,2));
+      rt = 0;
+
+      len_sqr = sqr(J(0,1)-J(0,0)-J(0,2)) +
+                sqr(J(1,1)-J(1,0)-J(1,2)) +
+                sqr(J(2,1)-J(2,0)-J(2,2));
+      if (len_sqr < min_len) { min_len = len_sqr; rt = 1; }
+
+      len_sqr = sqr(J(0,2)-J(0,0)-J(0,1)) +
+                sqr(J(1,2)-J(1,0)-J(1,1)) +
+                sqr(J(2,2)-J(2,0)-J(2,1));
+      if (len_sqr < min_len) { rt = 2; }
+   }
+   else
+   {
+      // best aspect ratio
+      real_t Em_data[18], Js_data[9], Jp_data[9];
+      DenseMatrix Em(Em_data, 3, 6);
+      DenseMatrix Js(Js_data, 3, 3), Jp(Jp_data, 3, 3);
+      real_t ar1, ar2, kappa, kappa_min;
+
+      for (int s = 0; s < 3; s++)
+      {
+         for (int t = 0; t < 3; t++)
+         {
+            Em(t,s) = 0.5*J(t,s);
+         }
+      }
+      for (int t = 0; t < 3; t++)
+      {
+         Em(t,3) = 0.5*(J(t,0)+J(t,1));
+         Em(t,4) = 0.5*(J(t,0)+J(t,2));
+         Em(t,5) = 0.5*(J(t,1)+J(t,2));
+      }
+
+      // rt = 0; Em: {0,5,1,2}, {0,5,2,4}
+      for (int t = 0; t < 3; t++)
+      {
+         Js(t,0) = Em(t,5)-Em(t,0);
+         Js(t,1) = Em(t,1)-Em(t,0);
+         Js(t,2) = Em(t,2)-Em(t,0);
+      }
+      Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
+      ar1 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
+      for (int t = 0; t < 3; t++)
+      {
+         Js(t,0) = Em(t,5)-Em(t,0);
+         Js(t,1) = Em(t,2)-Em(t,0);
+         Js(t,2) = Em(t,4)-Em(t,0);
+      }
+      Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
+      ar2 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
+      kappa_min = std::max(ar1, ar2);
+      rt = 0;
+
+      // rt = 1; Em: {1,0,4,2}, {1,2,4,5}
+      for (int t = 0; t < 3; t++)
+      {
+         Js(t,0) = Em(t,0)-Em(t,1);
+         Js(t,1) = Em(t,4)-Em(t,1);
+         Js(t,2) = Em(t,2)-Em(t,1);
+      }
+      Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
+      ar1 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
+      for (int t = 0; t < 3; t++)
+      {
+         Js(t,0) = Em(t,2)-Em(t,1);
+         Js(t,1) = Em(t,4)-Em(t,1);
+         Js(t,2) = Em(t,5)-Em(t,1);
+      }
+      Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
+      ar2 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
+      kappa = std::max(ar1, ar2);
+      if (kappa < kappa_min) { kappa_min = kappa; rt = 1; }
+
+      // rt = 2; Em: {2,0,1,3}, {2,1,5,3}
+      for (int t = 0; t < 3; t++)
+      {
+         Js(t,0) = Em(t,0)-Em(t,2);
+         Js(t,1) = Em(t,1)-Em(t,2);
+         Js(t,2) = Em(t,3)-Em(t,2);
+      }
+      Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
+      ar1 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
+      for (int t = 0; t < 3; t++)
+      {
+         Js(t,0) = Em(t,1)-Em(t,2);
+         Js(t,1) = Em(t,5)-Em(t,2);
+         Js(t,2) = Em(t,3)-Em(t,2);
+      }
+      Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
+      ar2 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
+      kappa = std::max(ar1, ar2);
+      if (kappa < kappa_min) { rt = 2; }
+   }
+   return rt;
+}
+
+void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, Array<int> *e2v_ptr,
                                     bool update_nodes)
 {
    ResetLazyData();
@@ -9587,17 +9795,16 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       }
    }
 
-   int hex_counter = 0;
-   if (HasGeometry(Geometry::CUBE))
+   // The center vertices of the hexahedra are numbered in the order of the
+   // elements, using a prefix sum of the hexahedron counts.
+   Array<int> hex_offset(NumOfElements + 1);
+   hex_offset[0] = 0;
+   for (int i = 0; i < NumOfElements; i++)
    {
-      for (int i = 0; i < elements.Size(); i++)
-      {
-         if (elements[i]->GetType() == Element::HEXAHEDRON)
-         {
-            hex_counter++;
-         }
-      }
+      const bool hex = (elements[i]->GetType() == Element::HEXAHEDRON);
+      hex_offset[i+1] = hex_offset[i] + hex;
    }
+   const int hex_counter = hex_offset[NumOfElements];
 
    int pyr_counter = 0;
    if (HasGeometry(Geometry::PYRAMID))
@@ -9611,53 +9818,20 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       }
    }
 
+   // The two vertices of each edge
+   Array<int> edge_vert;
+   GetEdgeVertexPairs(elements, *el_to_edge, NumOfEdges, edge_vert);
+
    // Map from edge-index to vertex-index, needed for ReorientTetMesh() for
    // parallel meshes.
    // Note: with the removal of ReorientTetMesh() this may no longer
    // be needed.  Unfortunately, it's hard to be sure.
-   Array<int> e2v;
+   Array<int> e2v_loc;
+   Array<int> &e2v = e2v_ptr ? *e2v_ptr : e2v_loc;
+   e2v.SetSize(0);
    if (HasGeometry(Geometry::TETRAHEDRON))
    {
-      e2v.SetSize(NumOfEdges);
-
-      DSTable *v_to_v_ptr = v_to_v_p;
-      if (!v_to_v_p)
-      {
-         v_to_v_ptr = new DSTable(NumOfVertices);
-         GetVertexToVertexTable(*v_to_v_ptr);
-      }
-
-      Array<Pair<int,int> > J_v2v(NumOfEdges); // (second vertex id, edge id)
-      J_v2v.SetSize(0);
-      for (int i = 0; i < NumOfVertices; i++)
-      {
-         Pair<int,int> *row_start = J_v2v.end();
-         for (DSTable::RowIterator it(*v_to_v_ptr, i); !it; ++it)
-         {
-            J_v2v.Append(Pair<int,int>(it.Column(), it.Index()));
-         }
-         std::sort(row_start, J_v2v.end());
-      }
-
-      for (int i = 0; i < J_v2v.Size(); i++)
-      {
-         e2v[J_v2v[i].two] = i;
-      }
-
-      if (!v_to_v_p)
-      {
-         delete v_to_v_ptr;
-      }
-      else
-      {
-         for (int i = 0; i < NumOfVertices; i++)
-         {
-            for (DSTable::RowIterator it(*v_to_v_ptr, i); !it; ++it)
-            {
-               it.SetIndex(e2v[it.Index()]);
-            }
-         }
-      }
+      GetEdgeOrder(edge_vert, NumOfVertices, e2v);
    }
 
    // Offsets for new vertices from edges, faces (quads only), and elements
@@ -9673,14 +9847,73 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
    new_elements.SetSize(8 * NumOfElements + 2 * pyr_counter);
    CoarseFineTr.embeddings.SetSize(new_elements.Size());
 
-   hex_counter = 0;
+   // The vertices of each quadrilateral face, as ordered in the last element
+   // that contains it.
+   Array<int> quad_vert(4*NumOfQuadFaces);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int *f = el_to_face->GetRow(i);
+      for (int fi = 0; fi < elements[i]->GetNFaces(); fi++)
+      {
+         if (elements[i]->GetNFaceVertices(fi) != 4) { continue; }
+         const int qf = f2qf.Size() ? f2qf[f[fi]] : f[fi];
+         const int *fv = elements[i]->GetFaceVertices(fi);
+         for (int k = 0; k < 4; k++) { quad_vert[4*qf+k] = v[fv[k]]; }
+      }
+   }
+
+   // Each new vertex is computed once, and the refinement type of the
+   // tetrahedra is chosen before the new elements are created, so that these
+   // loops can run in parallel.
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int ei = 0; ei < NumOfEdges; ei++)
+   {
+      const int ind = e2v.Size() ? e2v[ei] : ei;
+      AverageVertices(&edge_vert[2*ei], 2, oedge + ind);
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int qf = 0; qf < NumOfQuadFaces; qf++)
+   {
+      AverageVertices(&quad_vert[4*qf], 4, oface + qf);
+   }
+   Array<int> tet_rt(NumOfElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel if (Nodes == NULL)
+#endif
+   {
+      IsoparametricTransformation T;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for
+#endif
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const Element::Type el_type = elements[i]->GetType();
+         if (el_type == Element::HEXAHEDRON)
+         {
+            AverageVertices(elements[i]->GetVertices(), 8,
+                            oelem + hex_offset[i]);
+         }
+         else if (el_type == Element::TETRAHEDRON)
+         {
+            GetElementTransformation(i, &T);
+            T.SetIntPoint(&Geometries.GetCenter(Geometry::TETRAHEDRON));
+            tet_rt[i] = GetTetRefinementType(T.Jacobian());
+         }
+      }
+   }
+
    for (int i = 0, j = 0; i < NumOfElements; i++)
    {
       const Element::Type el_type = elements[i]->GetType();
       const int attr = elements[i]->GetAttribute();
       int *v = elements[i]->GetVertices();
       const int *e = el_to_edge->GetRow(i);
-      int vv[4], ev[12];
+      int ev[12];
 
       if (e2v.Size())
       {
@@ -9693,128 +9926,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       {
          case Element::TETRAHEDRON:
          {
-            for (int ei = 0; ei < 6; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[tet_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
-
-            // Algorithm for choosing refinement type:
-            // 0: smallest octahedron diagonal
-            // 1: best aspect ratio
-            const int rt_algo = 1;
-            // Refinement type:
-            // 0: (v0,v1)-(v2,v3), 1: (v0,v2)-(v1,v3), 2: (v0,v3)-(v1,v2)
-            // 0:      e0-e5,      1:      e1-e4,      2:      e2-e3
-            int rt;
-            ElementTransformation *T = GetElementTransformation(i);
-            T->SetIntPoint(&Geometries.GetCenter(Geometry::TETRAHEDRON));
-            const DenseMatrix &J = T->Jacobian();
-            if (rt_algo == 0)
-            {
-               // smallest octahedron diagonal
-               real_t len_sqr, min_len;
-
-               min_len = sqr(J(0,0)-J(0,1)-J(0,2)) +
-                         sqr(J(1,0)-J(1,1)-J(1,2)) +
-                         sqr(J(2,0)-J(2,1)-J(2,2));
-               rt = 0;
-
-               len_sqr = sqr(J(0,1)-J(0,0)-J(0,2)) +
-                         sqr(J(1,1)-J(1,0)-J(1,2)) +
-                         sqr(J(2,1)-J(2,0)-J(2,2));
-               if (len_sqr < min_len) { min_len = len_sqr; rt = 1; }
-
-               len_sqr = sqr(J(0,2)-J(0,0)-J(0,1)) +
-                         sqr(J(1,2)-J(1,0)-J(1,1)) +
-                         sqr(J(2,2)-J(2,0)-J(2,1));
-               if (len_sqr < min_len) { rt = 2; }
-            }
-            else
-            {
-               // best aspect ratio
-               real_t Em_data[18], Js_data[9], Jp_data[9];
-               DenseMatrix Em(Em_data, 3, 6);
-               DenseMatrix Js(Js_data, 3, 3), Jp(Jp_data, 3, 3);
-               real_t ar1, ar2, kappa, kappa_min;
-
-               for (int s = 0; s < 3; s++)
-               {
-                  for (int t = 0; t < 3; t++)
-                  {
-                     Em(t,s) = 0.5*J(t,s);
-                  }
-               }
-               for (int t = 0; t < 3; t++)
-               {
-                  Em(t,3) = 0.5*(J(t,0)+J(t,1));
-                  Em(t,4) = 0.5*(J(t,0)+J(t,2));
-                  Em(t,5) = 0.5*(J(t,1)+J(t,2));
-               }
-
-               // rt = 0; Em: {0,5,1,2}, {0,5,2,4}
-               for (int t = 0; t < 3; t++)
-               {
-                  Js(t,0) = Em(t,5)-Em(t,0);
-                  Js(t,1) = Em(t,1)-Em(t,0);
-                  Js(t,2) = Em(t,2)-Em(t,0);
-               }
-               Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
-               ar1 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
-               for (int t = 0; t < 3; t++)
-               {
-                  Js(t,0) = Em(t,5)-Em(t,0);
-                  Js(t,1) = Em(t,2)-Em(t,0);
-                  Js(t,2) = Em(t,4)-Em(t,0);
-               }
-               Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
-               ar2 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
-               kappa_min = std::max(ar1, ar2);
-               rt = 0;
-
-               // rt = 1; Em: {1,0,4,2}, {1,2,4,5}
-               for (int t = 0; t < 3; t++)
-               {
-                  Js(t,0) = Em(t,0)-Em(t,1);
-                  Js(t,1) = Em(t,4)-Em(t,1);
-                  Js(t,2) = Em(t,2)-Em(t,1);
-               }
-               Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
-               ar1 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
-               for (int t = 0; t < 3; t++)
-               {
-                  Js(t,0) = Em(t,2)-Em(t,1);
-                  Js(t,1) = Em(t,4)-Em(t,1);
-                  Js(t,2) = Em(t,5)-Em(t,1);
-               }
-               Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
-               ar2 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
-               kappa = std::max(ar1, ar2);
-               if (kappa < kappa_min) { kappa_min = kappa; rt = 1; }
-
-               // rt = 2; Em: {2,0,1,3}, {2,1,5,3}
-               for (int t = 0; t < 3; t++)
-               {
-                  Js(t,0) = Em(t,0)-Em(t,2);
-                  Js(t,1) = Em(t,1)-Em(t,2);
-                  Js(t,2) = Em(t,3)-Em(t,2);
-               }
-               Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
-               ar1 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
-               for (int t = 0; t < 3; t++)
-               {
-                  Js(t,0) = Em(t,1)-Em(t,2);
-                  Js(t,1) = Em(t,5)-Em(t,2);
-                  Js(t,2) = Em(t,3)-Em(t,2);
-               }
-               Geometries.JacToPerfJac(Geometry::TETRAHEDRON, Js, Jp);
-               ar2 = Jp.CalcSingularvalue(0)/Jp.CalcSingularvalue(2);
-               kappa = std::max(ar1, ar2);
-               if (kappa < kappa_min) { rt = 2; }
-            }
+            const int rt = tet_rt[i];
 
             static const int mv_all[3][4][4] =
             {
@@ -9880,24 +9992,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
          {
             const int *f = el_to_face->GetRow(i);
 
-            for (int fi = 2; fi < 5; fi++)
-            {
-               for (int k = 0; k < 4; k++)
-               {
-                  vv[k] = v[pri_t::FaceVert[fi][k]];
-               }
-               AverageVertices(vv, 4, oface + f2qf[f[fi]]);
-            }
-
-            for (int ei = 0; ei < 9; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[pri_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
-
             const int qf2 = f2qf[f[2]];
             const int qf3 = f2qf[f[3]];
             const int qf4 = f2qf[f[4]];
@@ -9939,25 +10033,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
          case Element::PYRAMID:
          {
             const int *f = el_to_face->GetRow(i);
-            // pyr_counter++;
-
-            for (int fi = 0; fi < 1; fi++)
-            {
-               for (int k = 0; k < 4; k++)
-               {
-                  vv[k] = v[pyr_t::FaceVert[fi][k]];
-               }
-               AverageVertices(vv, 4, oface + f2qf[f[fi]]);
-            }
-
-            for (int ei = 0; ei < 8; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[pyr_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
 
             const int qf0 = f2qf[f[0]];
 
@@ -10025,8 +10100,7 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
          case Element::HEXAHEDRON:
          {
             const int *f = el_to_face->GetRow(i);
-            const int he = hex_counter;
-            hex_counter++;
+            const int he = hex_offset[i];
 
             const int *qf;
             int qf_data[6];
@@ -10040,26 +10114,6 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
                qf = qf_data;
             }
 
-            AverageVertices(v, 8, oelem+he);
-
-            for (int fi = 0; fi < 6; fi++)
-            {
-               for (int k = 0; k < 4; k++)
-               {
-                  vv[k] = v[hex_t::FaceVert[fi][k]];
-               }
-               AverageVertices(vv, 4, oface + qf[fi]);
-            }
-
-            for (int ei = 0; ei < 12; ei++)
-            {
-               for (int k = 0; k < 2; k++)
-               {
-                  vv[k] = v[hex_t::Edges[ei][k]];
-               }
-               AverageVertices(vv, 2, oedge+e[ei]);
-            }
-
             new_elements[j++] =
                new Hexahedron(v[0], oedge+e[0], oface+qf[0],
                               oedge+e[3], oedge+e[8], oface+qf[1],
@@ -11796,6 +11850,89 @@ void Mesh::Save(const std::string &fname, int precision) const
    Print(ofs);
 }
 
+void Mesh::PrintBinary(std::ostream &os) const
+{
+   MFEM_VERIFY(!ncmesh && !NURBSext, "nonconforming and NURBS meshes are not"
+               " supported by the binary mesh format");
+   const FiniteElementSpace *nodes_fes = Nodes ? Nodes->FESpace() : NULL;
+   MFEM_VERIFY(!nodes_fes || !nodes_fes->IsVariableOrder(),
+               "variable order nodes are not supported");
+   static_assert(sizeof(Vertex) == 3*sizeof(real_t), "unexpected Vertex size");
+
+   Array<int> geom[2], attr[2], conn[2];
+   for (int b = 0; b < 2; b++)
+   {
+      const Array<Element*> &elems = b ? boundary : elements;
+      const int num_elems = b ? NumOfBdrElements : NumOfElements;
+      geom[b].SetSize(num_elems);
+      attr[b].SetSize(num_elems);
+      for (int i = 0; i < num_elems; i++)
+      {
+         geom[b][i] = elems[i]->GetGeometryType();
+         attr[b][i] = elems[i]->GetAttribute();
+         conn[b].Append(elems[i]->GetVertices(), elems[i]->GetNVertices());
+      }
+   }
+
+   std::ostringstream sets[2];
+   if (attribute_sets.SetsExist() || bdr_attribute_sets.SetsExist())
+   {
+      attribute_sets.Print(sets[0]);
+      bdr_attribute_sets.Print(sets[1]);
+   }
+   const std::string sets_str[2] = { sets[0].str(), sets[1].str() };
+   const std::string fec_name = nodes_fes ? nodes_fes->FEColl()->Name() : "";
+
+   const size_t align = bin_io::array_alignment;
+   const std::string tag = "MFEM binary mesh v1.0\n";
+   std::vector<char> buf(tag.begin(), tag.end());
+   const size_t hdr_pos = (tag.size() + align - 1) / align * align;
+   const int64_t hdr[16] =
+   {
+      0x0102030405060708, // byte order
+      0, // total size, set below
+      sizeof(real_t), Dim, spaceDim,
+      NumOfVertices, NumOfElements, NumOfBdrElements,
+      conn[0].Size(), conn[1].Size(),
+      (int64_t) fec_name.size(),
+      nodes_fes ? nodes_fes->GetVDim() : 0,
+      nodes_fes ? (int64_t) nodes_fes->GetOrdering() : 0,
+      Nodes ? Nodes->Size() : 0,
+      (int64_t) sets_str[0].size(), (int64_t) sets_str[1].size()
+   };
+   bin_io::AppendArray(buf, hdr, 16);
+   bin_io::AppendArray(buf, reinterpret_cast<const real_t*>(vertices.GetData()),
+                       3*NumOfVertices);
+   for (int b = 0; b < 2; b++)
+   {
+      bin_io::AppendArray(buf, geom[b].GetData(), geom[b].Size());
+      bin_io::AppendArray(buf, attr[b].GetData(), attr[b].Size());
+      bin_io::AppendArray(buf, conn[b].GetData(), conn[b].Size());
+   }
+   for (int b = 0; b < 2; b++)
+   {
+      bin_io::AppendArray(buf, sets_str[b].data(), sets_str[b].size());
+   }
+   bin_io::AppendArray(buf, fec_name.data(), fec_name.size());
+   if (Nodes)
+   {
+      bin_io::AppendArray(buf, Nodes->HostRead(), Nodes->Size());
+   }
+   // pad the end, so that data appended by ParMesh is aligned, too
+   buf.resize((buf.size() + align - 1) / align * align, 0);
+
+   const int64_t size = buf.size();
+   std::memcpy(buf.data() + hdr_pos + sizeof(int64_t), &size, sizeof(int64_t));
+   os.write(buf.data(), buf.size());
+}
+
+void Mesh::SaveBinary(const std::string &fname) const
+{
+   ofstream ofs(fname, std::ios::binary);
+   MFEM_VERIFY(ofs, "Error opening file: " << fname);
+   PrintBinary(ofs);
+}
+
 #ifdef MFEM_USE_ADIOS2
 void Mesh::Print(adios2stream &os) const
 {
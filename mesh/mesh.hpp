@@ -327,6 +327,13 @@ protected:
    // Readers for different mesh formats, used in the Load() method.
    // The implementations of these methods are in mesh_readers.cpp.
    void ReadMFEMMesh(std::istream &input, int version, int &curved);
+   /** Read the MFEM binary mesh format, see PrintBinary(), from the buffer
+       @a buf of size @a size. The topology is finalized and the nodes, if any,
+       are constructed. Returns the size of the mesh data, which may be
+       followed by the shared entities of a ParMesh. */
+   size_t ReadMFEMBinaryMesh(const char *buf, size_t size);
+   /// Same as above, for a stream positioned after the first line.
+   void ReadMFEMBinaryMesh(std::istream &input);
    void ReadLineMesh(std::istream &input);
    void ReadNetgen2DMesh(std::istream &input, int &curved);
    void ReadNetgen3DMesh(std::istream &input);
@@ -448,9 +455,12 @@ protected:
 
    /* If @a f2qf is not NULL, adds all quadrilateral faces to @a f2qf which
       represents a "face-to-quad-face" index map. When all faces are quads, the
-      array @a f2qf is kept empty since it is not needed. */
+      array @a f2qf is kept empty since it is not needed. Similarly, if @a e2v
+      is not NULL, it is set to the map from the old edges to their midpoints,
+      numbered from the old number of vertices, which is kept empty when the
+      midpoints follow the edge numbering. */
    void UniformRefinement3D_base(Array<int> *f2qf = NULL,
-                                 DSTable *v_to_v_p = NULL,
+                                 Array<int> *e2v = NULL,
                                  bool update_nodes = true);
 
    /// Refine a mixed 3D mesh uniformly.
@@ -784,6 +794,14 @@ public:
                             int generate_edges = 0, int refine = 1,
                             bool fix_orientation = true);
 
+   /** Creates mesh by reading a file in the MFEM binary mesh format, see
+       PrintBinary(). The file is memory-mapped, when supported by the system,
+       and its arrays are copied directly into the mesh data structures. See
+       Mesh::Finalize for the meaning of @a refine. Binary files can also be
+       read with LoadFromFile(), through a stream. */
+   static Mesh LoadFromBinaryFile(const std::string &filename, int refine = 1,
+                                  bool fix_orientation = true);
+
    /// Creates 1D mesh, divided into n equal intervals.
    static Mesh MakeCartesian1D(int n, real_t sx = 1.0);
 
@@ -2438,6 +2456,23 @@ public:
    /// used for ASCII output.
    virtual void Save(const std::string &fname, int precision=16) const;
 
+   /** @brief Print the mesh to the given stream using the MFEM binary mesh
+       format, which is not portable between systems with different byte
+       order or size of real_t.
+
+       The first line is "MFEM binary mesh v1.0", followed by 16 int64_t
+       header entries and the arrays of vertex coordinates (3 per vertex),
+       element geometries, attributes and vertex indices, the same for the
+       boundary elements, the element and then the boundary attribute sets, the
+       name of the nodal FiniteElementCollection and, if the mesh is curved, the
+       nodal values. Each array is contiguous and aligned to 8 bytes from the
+       beginning of the data, so the data can be memory-mapped. Nonconforming
+       and NURBS meshes are not supported. */
+   void PrintBinary(std::ostream &os) const;
+
+   /// Save the mesh to a file using Mesh::PrintBinary.
+   virtual void SaveBinary(const std::string &fname) const;
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &os) const;
@@ -21,6 +21,7 @@
 #include <vector>
 #include <algorithm>
 #include <map>
+#include <limits>
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
@@ -130,6 +131,116 @@ void Mesh::ReadMFEMMesh(std::istream &input, int version, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+size_t Mesh::ReadMFEMBinaryMesh(const char *buf, size_t size)
+{
+   // Read MFEM binary mesh v1.0 format, see Mesh::PrintBinary
+   const std::string tag = "MFEM binary mesh v1.0\n";
+   MFEM_VERIFY(size >= tag.size() && std::equal(tag.begin(), tag.end(), buf),
+               "invalid binary mesh data");
+   size_t pos = tag.size();
+   int64_t hdr[16];
+   bin_io::ReadArray(buf, size, pos, hdr, 16);
+   MFEM_VERIFY(hdr[0] == 0x0102030405060708,
+               "binary mesh data with different byte order");
+   MFEM_VERIFY(hdr[1] >= int64_t(pos) && size_t(hdr[1]) <= size,
+               "invalid binary mesh data");
+   MFEM_VERIFY(hdr[2] == sizeof(real_t),
+               "binary mesh data with different size of real_t");
+   size = hdr[1];
+
+   Dim = hdr[3];
+   spaceDim = hdr[4];
+   NumOfVertices = hdr[5];
+   NumOfElements = hdr[6];
+   NumOfBdrElements = hdr[7];
+
+   vertices.SetSize(NumOfVertices);
+   bin_io::ReadArray(buf, size, pos,
+                     reinterpret_cast<real_t*>(vertices.GetData()),
+                     3*NumOfVertices);
+
+   Array<int> geom, attr, conn;
+   for (int b = 0; b < 2; b++)
+   {
+      Array<Element*> &elems = b ? boundary : elements;
+      const int num_elems = b ? NumOfBdrElements : NumOfElements;
+      geom.SetSize(num_elems);
+      attr.SetSize(num_elems);
+      conn.SetSize(hdr[8 + b]);
+      bin_io::ReadArray(buf, size, pos, geom.GetData(), num_elems);
+      bin_io::ReadArray(buf, size, pos, attr.GetData(), num_elems);
+      bin_io::ReadArray(buf, size, pos, conn.GetData(), conn.Size());
+
+      elems.SetSize(num_elems);
+      int offset = 0;
+      for (int i = 0; i < num_elems; i++)
+      {
+         elems[i] = NewElement(geom[i]);
+         MFEM_VERIFY(offset + elems[i]->GetNVertices() <= conn.Size(),
+                     "invalid binary mesh data");
+         elems[i]->SetVertices(conn.GetData() + offset);
+         elems[i]->SetAttribute(attr[i]);
+         offset += elems[i]->GetNVertices();
+      }
+      MFEM_VERIFY(offset == conn.Size(), "invalid binary mesh data");
+   }
+
+   for (int b = 0; b < 2; b++)
+   {
+      std::string sets_str(hdr[14 + b], '\0');
+      bin_io::ReadArray(buf, size, pos, &sets_str[0], sets_str.size());
+      if (sets_str.empty()) { continue; }
+      std::istringstream sets_in(sets_str);
+      AttributeSets &sets = b ? bdr_attribute_sets : attribute_sets;
+      sets.attr_sets.Load(sets_in);
+      sets.attr_sets.SortAll();
+      sets.attr_sets.UniqueAll();
+   }
+
+   std::string fec_name(hdr[10], '\0');
+   bin_io::ReadArray(buf, size, pos, &fec_name[0], fec_name.size());
+
+   // don't generate any boundary elements, see Mesh::Loader
+   FinalizeTopology(false);
+
+   if (!fec_name.empty())
+   {
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fec_name.c_str());
+      FiniteElementSpace *fes = new FiniteElementSpace(this, fec, hdr[11],
+                                                       int(hdr[12]));
+      MFEM_VERIFY(fes->GetVSize() == hdr[13], "invalid binary mesh data");
+      Nodes = new GridFunction(fes);
+      Nodes->MakeOwner(fec);
+      own_nodes = 1;
+      bin_io::ReadArray(buf, size, pos, Nodes->HostWrite(), Nodes->Size());
+   }
+
+   return size;
+}
+
+void Mesh::ReadMFEMBinaryMesh(std::istream &input)
+{
+   // the first line was already read by the caller; read the header to get
+   // the size of the data, and then the rest of the data
+   const std::string tag = "MFEM binary mesh v1.0\n";
+   const size_t align = bin_io::array_alignment;
+   std::vector<char> buf(tag.begin(), tag.end());
+   size_t pos = (tag.size() + align - 1) / align * align;
+   buf.resize(pos + 2*sizeof(int64_t));
+   input.read(buf.data() + tag.size(), buf.size() - tag.size());
+   int64_t hdr[2];
+   bin_io::ReadArray(buf.data(), buf.size(), pos, hdr, 2);
+   MFEM_VERIFY(input && hdr[0] == 0x0102030405060708 &&
+               hdr[1] >= int64_t(buf.size()), "invalid binary mesh data");
+
+   pos = buf.size();
+   buf.resize(hdr[1]);
+   input.read(buf.data() + pos, buf.size() - pos);
+   MFEM_VERIFY(input, "unexpected end of binary mesh data");
+   ReadMFEMBinaryMesh(buf.data(), buf.size());
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
@@ -1064,14 +1175,35 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
 
    static const char *erstr = "XML parsing error";
 
-   // Create buffer beginning with xml_prefix, then read the rest of the stream
+   // Create buffer beginning with xml_prefix, then read the rest of the stream.
+   // When the stream is seekable, e.g. an uncompressed std::ifstream or a
+   // std::stringstream, the buffer is allocated with the remaining size of the
+   // stream and filled with a single read. In text mode, the number of
+   // characters read can be smaller than the size, e.g. with CRLF line endings
+   // on Windows.
    std::vector<char> buf(xml_prefix.begin(), xml_prefix.end());
-   std::istreambuf_iterator<char> eos;
-   buf.insert(buf.end(), std::istreambuf_iterator<char>(input), eos);
-   buf.push_back('\0'); // null-terminate buffer
+   const std::streampos start = input.tellg();
+   if (start != std::streampos(-1) && input.seekg(0, std::ios::end))
+   {
+      const std::streamoff size = input.tellg() - start;
+      input.seekg(start);
+      buf.resize(xml_prefix.size() + size + 1);
+      input.read(buf.data() + xml_prefix.size(), size);
+      buf.resize(xml_prefix.size() + input.gcount() + 1);
+      buf.back() = '\0'; // null-terminate buffer
+   }
+   else
+   {
+      input.clear();
+      std::istreambuf_iterator<char> eos;
+      buf.insert(buf.end(), std::istreambuf_iterator<char>(input), eos);
+      buf.push_back('\0'); // null-terminate buffer
+   }
 
    XMLDocument xml;
    xml.Parse(buf.data(), buf.size());
+   // The XML document keeps its own copy of the data
+   std::vector<char>().swap(buf);
    if (xml.ErrorID() != XML_SUCCESS)
    {
       MFEM_ABORT("Error parsing XML VTK file.\n" << xml.ErrorStr());
@@ -1520,6 +1652,74 @@ void Mesh::ReadInlineMesh(std::istream &input, bool generate_edges)
    }
 }
 
+namespace gmsh
+{
+
+/// Map from the Gmsh vertex numbers (there may be gaps in the numbering, and
+/// Gmsh enumerates vertices starting from 1, not 0) to the MFEM vertex indices.
+/// When the numbering is compact, which is the common case, the map is a dense
+/// array indexed by the vertex number; otherwise it is a sorted array of
+/// (number, index) pairs. Either way, it only needs a few integers per vertex.
+class VertexMap
+{
+   int min_id = 0;
+   std::vector<int> dense; // dense[id - min_id] = index, or -1
+   std::vector<std::pair<int,int>> sorted; // (id, index), sorted by id
+
+public:
+   /// Build the map from the vertex numbers @a ids, given in file order. The
+   /// array @a ids is released. Returns false if the numbers are not unique.
+   bool Build(std::vector<int> &ids)
+   {
+      const int nv = static_cast<int>(ids.size());
+      dense.clear();
+      sorted.clear();
+      if (nv == 0) { return true; }
+      const auto mm = std::minmax_element(ids.begin(), ids.end());
+      min_id = *mm.first;
+      const int64_t range = int64_t(*mm.second) - min_id + 1;
+      bool unique = true;
+      if (range <= 2*int64_t(nv))
+      {
+         dense.assign(range, -1);
+         for (int i = 0; i < nv && unique; i++)
+         {
+            int &index = dense[ids[i] - min_id];
+            unique = (index < 0);
+            index = i;
+         }
+      }
+      else
+      {
+         sorted.resize(nv);
+         for (int i = 0; i < nv; i++) { sorted[i] = std::make_pair(ids[i], i); }
+         std::sort(sorted.begin(), sorted.end());
+         for (int i = 1; i < nv && unique; i++)
+         {
+            unique = (sorted[i-1].first != sorted[i].first);
+         }
+      }
+      std::vector<int>().swap(ids);
+      return unique;
+   }
+
+   /// Return the index of the vertex with number @a id, or -1 if not found.
+   int Find(int id) const
+   {
+      if (!dense.empty())
+      {
+         const int64_t k = int64_t(id) - min_id;
+         return (k >= 0 && k < int64_t(dense.size())) ? dense[k] : -1;
+      }
+      const auto it =
+         std::lower_bound(sorted.begin(), sorted.end(),
+                          std::make_pair(id, std::numeric_limits<int>::min()));
+      return (it != sorted.end() && it->first == id) ? it->second : -1;
+   }
+};
+
+} // namespace gmsh
+
 void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
 {
    string buff;
@@ -1547,9 +1747,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
    }
 
    // A map between a serial number of the vertex and its number in the file
-   // (there may be gaps in the numbering, and also Gmsh enumerates vertices
-   // starting from 1, not 0)
-   map<int, int> vertices_map;
+   gmsh::VertexMap vertices_map;
 
    // A map containing names of physical curves, surfaces, and volumes.
    // The first index is the dimension of the physical manifold, the second
@@ -1557,6 +1755,9 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
    // the assigned name.
    map<int,map<int,std::string> > phys_names_by_dim;
 
+   // Number of vertices or elements read at once from the binary blocks
+   const int gmsh_chunk_size = 1 << 16;
+
    // Gmsh always outputs coordinates in 3D, but MFEM distinguishes between the
    // mesh element dimension (Dim) and the dimension of the space in which the
    // mesh is embedded (spaceDim). For example, a 2D MFEM mesh has Dim = 2 and
@@ -1589,15 +1790,30 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
          input >> NumOfVertices;
          getline(input, buff);
          vertices.SetSize(NumOfVertices);
+         std::vector<int> serial_numbers(NumOfVertices);
          int serial_number;
          const int gmsh_dim = 3; // Gmsh always outputs 3 coordinates
          real_t coord[gmsh_dim];
+         // Binary vertex records are read in chunks of gmsh_chunk_size
+         const size_t rec_size = sizeof(int) + gmsh_dim*sizeof(double);
+         std::vector<char> records;
+         if (binary)
+         {
+            records.resize(std::min(NumOfVertices, gmsh_chunk_size)*rec_size);
+         }
          for (int ver = 0; ver < NumOfVertices; ++ver)
          {
             if (binary)
             {
-               input.read(reinterpret_cast<char*>(&serial_number), sizeof(int));
-               input.read(reinterpret_cast<char*>(coord), gmsh_dim*sizeof(double));
+               const int c = ver % gmsh_chunk_size;
+               if (c == 0)
+               {
+                  const int n = std::min(NumOfVertices - ver, gmsh_chunk_size);
+                  input.read(records.data(), n*rec_size);
+               }
+               const char *rec = records.data() + c*rec_size;
+               memcpy(&serial_number, rec, sizeof(int));
+               memcpy(coord, rec + sizeof(int), gmsh_dim*sizeof(double));
             }
             else // ASCII
             {
@@ -1608,7 +1824,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                }
             }
             vertices[ver] = Vertex(coord, gmsh_dim);
-            vertices_map[serial_number] = ver;
+            serial_numbers[ver] = serial_number;
 
             for (int ci = 0; ci < gmsh_dim; ++ci)
             {
@@ -1631,7 +1847,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
             spaceDim++;
          }
 
-         if (static_cast<int>(vertices_map.size()) != NumOfVertices)
+         if (!vertices_map.Build(serial_numbers))
          {
             MFEM_ABORT("Gmsh file : vertices indices are not unique");
          }
@@ -1905,23 +2121,17 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                         29,23,19,24,17,10,14,20,18,4
                        };
 
+         // The elements are split by dimension as they are read. We do not
+         // know the dimension of the mesh in advance, so the arrays below are
+         // not reserved: reserving num_of_all_elements entries in each of them
+         // costs more memory than the elements themselves.
          vector<Element*> elements_0D, elements_1D, elements_2D, elements_3D;
-         elements_0D.reserve(num_of_all_elements);
-         elements_1D.reserve(num_of_all_elements);
-         elements_2D.reserve(num_of_all_elements);
-         elements_3D.reserve(num_of_all_elements);
 
          // Temporary storage for high order vertices, if present
          vector<Array<int>*> ho_verts_1D, ho_verts_2D, ho_verts_3D;
-         ho_verts_1D.reserve(num_of_all_elements);
-         ho_verts_2D.reserve(num_of_all_elements);
-         ho_verts_3D.reserve(num_of_all_elements);
 
          // Temporary storage for order of elements
          vector<int> ho_el_order_1D, ho_el_order_2D, ho_el_order_3D;
-         ho_el_order_1D.reserve(num_of_all_elements);
-         ho_el_order_2D.reserve(num_of_all_elements);
-         ho_el_order_3D.reserve(num_of_all_elements);
 
          // Vertex order mappings
          Array<int*> ho_lin(11); ho_lin = NULL;
@@ -1964,11 +2174,23 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                n_elem_part += n_elem_one_type;
 
                const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> data(1+n_tags+n_elem_nodes);
+               // The elements of the block are read in chunks of
+               // gmsh_chunk_size elements, n_data integers each
+               const size_t n_data = 1+n_tags+n_elem_nodes;
+               vector<int> block(
+                  std::min(n_elem_one_type, gmsh_chunk_size)*n_data);
+               vector<int> vert_indices(n_elem_nodes);
                for (int el = 0; el < n_elem_one_type; ++el)
                {
-                  input.read(reinterpret_cast<char*>(&data[0]),
-                             data.size()*sizeof(int));
+                  const int c = el % gmsh_chunk_size;
+                  if (c == 0)
+                  {
+                     const int n = std::min(n_elem_one_type - el,
+                                            gmsh_chunk_size);
+                     input.read(reinterpret_cast<char*>(block.data()),
+                                n*n_data*sizeof(int));
+                  }
+                  const int *data = block.data() + c*n_data;
                   int dd = 0; // index for data array
                   serial_number = data[dd++];
                   // physical domain - the most important value (to distinguish
@@ -1982,16 +2204,13 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                   n_partitions = (n_tags > 2) ? data[dd++] : 0;
                   // we currently just skip the partitions if they exist, and go
                   // directly to vertices describing the mesh element
-                  vector<int> vert_indices(n_elem_nodes);
                   for (int vi = 0; vi < n_elem_nodes; ++vi)
                   {
-                     map<int, int>::const_iterator it =
-                        vertices_map.find(data[1+n_tags+vi]);
-                     if (it == vertices_map.end())
+                     vert_indices[vi] = vertices_map.Find(data[1+n_tags+vi]);
+                     if (vert_indices[vi] < 0)
                      {
                         MFEM_ABORT("Gmsh file : vertex index doesn't exist");
                      }
-                     vert_indices[vi] = it->second;
                   }
 
                   // Non-positive attributes are not allowed in MFEM. However,
@@ -2190,10 +2409,11 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
          } // if binary
          else // ASCII
          {
+            vector<int> data, vert_indices;
             for (int el = 0; el < num_of_all_elements; ++el)
             {
                input >> serial_number >> type_of_element >> n_tags;
-               vector<int> data(n_tags);
+               data.resize(n_tags);
                for (int i = 0; i < n_tags; ++i) { input >> data[i]; }
                // physical domain - the most important value (to distinguish
                // materials with different properties)
@@ -2207,17 +2427,16 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                // we currently just skip the partitions if they exist, and go
                // directly to vertices describing the mesh element
                const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> vert_indices(n_elem_nodes);
+               vert_indices.resize(n_elem_nodes);
                int index;
                for (int vi = 0; vi < n_elem_nodes; ++vi)
                {
                   input >> index;
-                  map<int, int>::const_iterator it = vertices_map.find(index);
-                  if (it == vertices_map.end())
+                  vert_indices[vi] = vertices_map.Find(index);
+                  if (vert_indices[vi] < 0)
                   {
                      MFEM_ABORT("Gmsh file : vertex index doesn't exist");
                   }
-                  vert_indices[vi] = it->second;
                }
 
                // Non-positive attributes are not allowed in MFEM. However,
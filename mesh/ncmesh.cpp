@@ -2433,6 +2433,100 @@ void NCMesh::CollectLeafElements(int elem, int state, Array<int> &ghosts,
             CollectLeafElements(el.child[ch], st, ghosts, counter);
          }
       }
+      else if (el.Geom() == Geometry::SQUARE || el.Geom() == Geometry::CUBE)
+      {
+         // anisotropic refinement: visit the children in the order in which
+         // the curve of the parent visits its corners, and orient the curve
+         // in each child so that it continues from the previous child
+         const bool quad = (el.Geom() == Geometry::SQUARE);
+         const int nv = quad ? 4 : 8, dim = quad ? 2 : 3;
+         const int nstates = quad ? 8 : 24;
+         auto order = [quad](int st, int i) -> int
+         {
+            return quad ? quad_hilbert_child_order[st][i]
+                   : hex_hilbert_child_order[st][i];
+         };
+         auto corner = [](int k, int d) -> int
+         {
+            return (d == 0) ? ((k + 1) >> 1) & 1 :
+                   (d == 1) ? (k >> 1) & 1 : k >> 2;
+         };
+
+         int pos[8];
+         for (int i = 0; i < nv; i++) { pos[order(state, i)] = i; }
+
+         // sort the children by the first parent corner they contain, and
+         // find their extents in the reference coordinates of the parent
+         int nch = 0, ch[4], first[4];
+         real_t lo[4][3], hi[4][3];
+         for (int i = 0; i < MaxElemChildren && el.child[i] >= 0; i++)
+         {
+            const signed char *cp = aniso_child_pos[(int) el.ref_type][i];
+            int f = nv;
+            for (int j = 0; j < nv; j++)
+            {
+               bool inside = true;
+               for (int d = 0; d < dim; d++)
+               {
+                  if (cp[d] >= 0 && cp[d] != corner(j, d)) { inside = false; }
+               }
+               if (inside) { f = std::min(f, pos[j]); }
+            }
+            int k = nch++;
+            for (; k > 0 && first[k-1] > f; k--)
+            {
+               ch[k] = ch[k-1];
+               first[k] = first[k-1];
+               for (int d = 0; d < dim; d++)
+               {
+                  lo[k][d] = lo[k-1][d];
+                  hi[k][d] = hi[k-1][d];
+               }
+            }
+            ch[k] = el.child[i];
+            first[k] = f;
+            for (int d = 0; d < dim; d++)
+            {
+               lo[k][d] = (cp[d] == 1) ? 0.5 : 0.0;
+               hi[k][d] = (cp[d] == 0) ? 0.5 : 1.0;
+            }
+         }
+
+         // the curve enters the parent at its corner order(state, 0) and
+         // leaves it at its corner order(state, nv-1)
+         real_t prev[3], target[3];
+         for (int d = 0; d < dim; d++) { prev[d] = corner(order(state, 0), d); }
+         for (int i = 0; i < nch; i++)
+         {
+            for (int d = 0; d < dim; d++)
+            {
+               target[d] = (i + 1 < nch) ? 0.5*(lo[i+1][d] + hi[i+1][d])
+                           : corner(order(state, nv-1), d);
+            }
+            int best = 0;
+            real_t best_cost = infinity(), best_out[3] = {0.0, 0.0, 0.0};
+            for (int st = 0; st < nstates; st++)
+            {
+               const int in = order(st, 0), out = order(st, nv-1);
+               real_t cost = 0.0, x_out[3];
+               for (int d = 0; d < dim; d++)
+               {
+                  const real_t x_in = corner(in, d) ? hi[i][d] : lo[i][d];
+                  x_out[d] = corner(out, d) ? hi[i][d] : lo[i][d];
+                  cost += (x_in - prev[d])*(x_in - prev[d]) +
+                          (x_out[d] - target[d])*(x_out[d] - target[d]);
+               }
+               if (cost < best_cost)
+               {
+                  best_cost = cost;
+                  best = st;
+                  for (int d = 0; d < dim; d++) { best_out[d] = x_out[d]; }
+               }
+            }
+            for (int d = 0; d < dim; d++) { prev[d] = best_out[d]; }
+            CollectLeafElements(ch[i], best, ghosts, counter);
+         }
+      }
       else // no space filling curve tables yet for remaining cases
       {
          for (int i = 0; i < MaxElemChildren; i++)
@@ -2784,9 +2878,6 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
    }
    mesh.boundary.SetSize(0);
 
-   // Save off boundary face vertices to make boundary elements later.
-   std::map<int, mfem::Array<int>> unique_boundary_faces;
-
    // create an mfem::Element for each leaf Element
    for (int i = 0; i < NElements; i++)
    {
@@ -2803,81 +2894,89 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
       {
          elem->GetVertices()[j] = nodes[node[j]].vert_index;
       }
+   }
+
+   // Create the boundary elements. Instead of looking up all faces of all
+   // leaf elements in the hash table, visit the (relatively few) boundary
+   // faces in the order of their IDs and find the leaf elements using them.
+   for (auto face = faces.cbegin(); face != faces.cend(); ++face)
+   {
+      if (!face->Boundary()) { continue; }
 
-      // Loop over faces and collect those marked as boundaries
-      for (int k = 0; k < gi.nf; ++k)
+      // If a face is used by two elements, the vertex order is given by the
+      // one with the larger index.
+      const Element *bdr_elem = nullptr;
+      const int *fv = nullptr;
+      int nfv = 0;
+      for (int e : face->elem)
       {
-         const int nfv = gi.nfv[k];
-         const int * const fv = gi.faces[k];
-         const auto id = faces.FindId(node[fv[0]], node[fv[1]], node[fv[2]],
-                                      node[fv[3]]);
-         if (id >= 0 && faces[id].Boundary())
+         if (e < 0) { continue; }
+         const Element &nc_elem = elements[e];
+         if (nc_elem.ref_type || nc_elem.index < 0 ||
+             nc_elem.index >= NElements) { continue; }
+
+         if (face->elem[0] >= 0 && face->elem[1] >= 0 &&
+             nc_elem.rank != std::min(elements[face->elem[0]].rank,
+                                      elements[face->elem[1]].rank))
          {
-            const auto &face = faces[id];
-            if (face.elem[0] >= 0 && face.elem[1] >= 0 &&
-                nc_elem.rank != std::min(elements[face.elem[0]].rank,
-                                         elements[face.elem[1]].rank))
-            {
-               // This is a conformal internal face, but this element is not the
-               // lowest ranking attached processor, thus not the owner of the
-               // face. Consequently, we do not add this face to avoid double
-               // counting.
-               continue;
-            }
+            // This is a conformal internal face, but this element is not the
+            // lowest ranking attached processor, thus not the owner of the
+            // face. Consequently, we do not add this face to avoid double
+            // counting.
+            continue;
+         }
 
-            // Add in all boundary faces that are actual boundaries or not
-            // masters of another face. The fv[2] in the edge split is on
-            // purpose. A point cannot have a split level, thus do not check for
-            // master/slave relation.
-            if ((nfv == 4 &&
-                 !QuadFaceIsMaster(node[fv[0]], node[fv[1]], node[fv[2]], node[fv[3]]))
-                || (nfv == 3 && !TriFaceIsMaster(node[fv[0]], node[fv[1]], node[fv[2]]))
-                || (nfv == 2 && EdgeSplitLevel(node[fv[0]], node[fv[2]]) == 0) || (nfv == 1))
+         if (bdr_elem && bdr_elem->index > nc_elem.index) { continue; }
+
+         const int* node = nc_elem.node;
+         GeomInfo& gi = GI[(int) nc_elem.geom];
+         for (int k = 0; k < gi.nf; k++)
+         {
+            const int *kv = gi.faces[k];
+            if (faces.FindId(node[kv[0]], node[kv[1]], node[kv[2]],
+                             node[kv[3]]) == face.index())
             {
-               // This face has no split faces below, it is conformal or a
-               // slave.
-               unique_boundary_faces[id].SetSize(nfv);
-               for (int v = 0; v < nfv; ++v)
-               {
-                  // Using a map overwrites if a face is visited twice. The
-                  // nfv==2 is necessary because faces of 2D are storing the
-                  // second index in the 2 slot, not the 1 slot.
-                  unique_boundary_faces[id][v] = nodes[node[fv[(nfv==2) ? 2*v : v]]].vert_index;
-               }
+               bdr_elem = &nc_elem;
+               fv = kv;
+               nfv = gi.nfv[k];
+               break;
             }
          }
+         MFEM_ASSERT(bdr_elem == &nc_elem, "face not found in its element");
       }
-   }
+      if (!bdr_elem) { continue; }
 
-   auto geom_from_nfv = [](int nfv)
-   {
-      switch (nfv)
+      // Add in all boundary faces that are actual boundaries or not masters
+      // of another face. The fv[2] in the edge split is on purpose. A point
+      // cannot have a split level, thus do not check for master/slave
+      // relation.
+      const int* node = bdr_elem->node;
+      if ((nfv == 4 && QuadFaceIsMaster(node[fv[0]], node[fv[1]],
+                                        node[fv[2]], node[fv[3]])) ||
+          (nfv == 3 && TriFaceIsMaster(node[fv[0]], node[fv[1]],
+                                       node[fv[2]])) ||
+          (nfv == 2 && EdgeSplitLevel(node[fv[0]], node[fv[2]]) > 0))
       {
-         case 1: return Geometry::POINT;
-         case 2: return Geometry::SEGMENT;
-         case 3: return Geometry::TRIANGLE;
-         case 4: return Geometry::SQUARE;
+         continue;
       }
-      return Geometry::INVALID;
-   };
-
-   for (const auto &fv : unique_boundary_faces)
-   {
-      const auto f = fv.first;
-      const auto &v = fv.second;
-      const auto &face = faces.At(f);
 
-      auto geom = geom_from_nfv(v.Size());
+      // This face has no split faces below, it is conformal or a slave. Add a
+      // new boundary element, with matching attribute and vertices. The
+      // nfv==2 is necessary because faces of 2D are storing the second index
+      // in the 2 slot, not the 1 slot.
+      const Geometry::Type geom =
+         (nfv == 1) ? Geometry::POINT :
+         (nfv == 2) ? Geometry::SEGMENT :
+         (nfv == 3) ? Geometry::TRIANGLE : Geometry::SQUARE;
 
-      MFEM_ASSERT(geom != Geometry::INVALID,
-                  "nfv: " << v.Size() <<
-                  " does not match a valid face geometry: Quad, Tri, Segment, Point");
-
-      // Add a new boundary element, with matching attribute and vertices
-      mesh.boundary.Append(mesh.NewElement(geom));
-      auto * const be = mesh.boundary.Last();
-      be->SetAttribute(face.attribute);
-      be->SetVertices(v);
+      mfem::Element *be = mesh.NewElement(geom);
+      mesh.boundary.Append(be);
+      be->SetAttribute(face->attribute);
+      for (int v = 0; v < nfv; v++)
+      {
+         const int fn = node[fv[(nfv == 2) ? 2*v : v]];
+         be->GetVertices()[v] = nodes[fn].vert_index;
+      }
    }
 }
 
@@ -3789,6 +3888,10 @@ void NCMesh::TraverseEdge(int vn0, int vn1, real_t t0, real_t t1, int flags,
       if (v0index > v1index) { sl.edge_flags |= 2; }
    }
 
+   // an edge without a mid-edge vertex is not split, there are no edges below
+   // it and we can skip the hash table lookups of the two halves
+   if (!nd.HasVertex()) { return; }
+
    // recurse deeper
    const real_t scale = GetScale(nd.GetScale(), vn0 > vn1);
 
@@ -3839,17 +3942,7 @@ void NCMesh::BuildEdgeList()
          edge_local[nd.edge_index] = j;
 
          // skip slave edges here, they will be reached from their masters
-         if (GetEdgeMaster(enode) >= 0)
-         {
-            // (2D only, store internal boundary faces)
-            if (Dim <= 2)
-            {
-               int face = faces.FindId(node[0], node[0], node[1], node[1]);
-               MFEM_ASSERT(face >= 0, "face not found!");
-               if (faces[face].Boundary()) { boundary_faces.Append(face); }
-            }
-            continue;
-         }
+         if (GetEdgeMaster(enode) >= 0) { continue; }
 
          // have we already processed this edge? skip if yes
          if (processed_edges[enode]) { continue; }
@@ -3877,22 +3970,37 @@ void NCMesh::BuildEdgeList()
             {
                edge_list.slaves[ii].master = nd.edge_index;
             }
+            processed_edges[enode] = 2;
          }
          else
          {
             // no slaves, this is a conforming edge
             edge_list.conforming.Append(MeshId(nd.edge_index, elem, j));
-            // (2D only, store boundary faces)
-            if (Dim <= 2)
-            {
-               int face = faces.FindId(node[0], node[0], node[1], node[1]);
-               MFEM_ASSERT(face >= 0, "face not found!");
-               if (faces[face].Boundary()) { boundary_faces.Append(face); }
-            }
          }
       }
    }
 
+   // (2D only) store the boundary faces of conforming and slave edges; instead
+   // of looking up the face of each edge, visit the boundary faces directly
+   if (Dim == 2)
+   {
+      for (auto face = faces.cbegin(); face != faces.cend(); ++face)
+      {
+         if (!face->Boundary()) { continue; }
+
+         // skip faces not used by any leaf element (including ghosts)
+         const int e0 = face->elem[0], e1 = face->elem[1];
+         if ((e0 < 0 || elements[e0].index < 0) &&
+             (e1 < 0 || elements[e1].index < 0)) { continue; }
+
+         const int enode = nodes.FindId(face->p1, face->p3);
+         MFEM_ASSERT(enode >= 0, "edge node not found!");
+         if (processed_edges[enode] == 2) { continue; } // master edge
+
+         boundary_faces.Append(face.index());
+      }
+   }
+
    // fix up slave edge element/local
    for (int i = 0; i < edge_list.slaves.Size(); i++)
    {
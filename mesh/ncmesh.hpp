@@ -538,11 +538,17 @@ protected: // implementation
        off" its nodes by decrementing the ref counts. */
    struct Node : public Hashed2
    {
+   private:
+      // NOTE: the data members are ordered to minimize padding
+      real_t scale;  ///< Scale from struct Refinement, default 0.5
+      bool scaleSet; ///< Indicates whether scale is set and cannot be changed
+
+   public:
       char vert_refc, edge_refc;
       int vert_index, edge_index;
 
-      Node() : vert_refc(0), edge_refc(0), vert_index(-1), edge_index(-1),
-         scale(0.5), scaleSet(false) {}
+      Node() : scale(0.5), scaleSet(false), vert_refc(0), edge_refc(0),
+         vert_index(-1), edge_index(-1) {}
       ~Node();
 
       bool HasVertex() const { return vert_refc > 0; }
@@ -556,8 +562,6 @@ protected: // implementation
       void SetScale(real_t s, bool overwrite = false);
 
    private:
-      real_t scale;  ///< Scale from struct Refinement, default 0.5
-      bool scaleSet; ///< Indicates whether scale is set and cannot be changed
 #ifdef MFEM_USE_DOUBLE
       static constexpr real_t scaleTol = 1.0e-8; ///< Scale comparison tolerance
 #else
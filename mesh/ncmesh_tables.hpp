@@ -101,6 +101,20 @@ static constexpr char hex_hilbert_child_state[24][8] =
    {23,22,22,8,8,17,17,0},   {21,23,23,1,1,7,7,15},    {22,21,21,16,16,2,2,6}
 };
 
+// position of the children of anisotropically refined quads and hexes in the
+// parent, for each ref_type: 0 = lower half, 1 = upper half, -1 = not split
+
+static constexpr signed char aniso_child_pos[7][4][3] =
+{
+   {{-1,-1,-1}, {-1,-1,-1}, {-1,-1,-1}, {-1,-1,-1}}, // 0 - not refined
+   {{ 0,-1,-1}, { 1,-1,-1}, {-1,-1,-1}, {-1,-1,-1}}, // 1 - X
+   {{-1, 0,-1}, {-1, 1,-1}, {-1,-1,-1}, {-1,-1,-1}}, // 2 - Y
+   {{ 0, 0,-1}, { 1, 0,-1}, { 1, 1,-1}, { 0, 1,-1}}, // 3 - XY
+   {{-1,-1, 0}, {-1,-1, 1}, {-1,-1,-1}, {-1,-1,-1}}, // 4 - Z
+   {{ 0,-1, 0}, { 1,-1, 0}, { 1,-1, 1}, { 0,-1, 1}}, // 5 - XZ
+   {{-1, 0, 0}, {-1, 1, 0}, {-1, 0, 1}, {-1, 1, 1}}  // 6 - YZ
+};
+
 
 // child/parent reference domain transforms
 using RefCoord = NCMesh::RefCoord;
@@ -19,9 +19,13 @@
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
+#include "../general/binaryio.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <climits>
+#include <limits>
+#include <memory>
 
 using namespace std;
 
@@ -930,6 +934,95 @@ void ParMesh::FinalizeParTopo()
    }
 }
 
+// Return the edge with the vertices @a a and @a b of the element @a el, whose
+// edges are @a el_edges.
+static int FindElementEdge(const Element *el, const int *el_edges, int a,
+                           int b)
+{
+   const int *v = el->GetVertices();
+   for (int k = 0; k < el->GetNEdges(); k++)
+   {
+      const int *ev = el->GetEdgeVertices(k);
+      if ((v[ev[0]] == a && v[ev[1]] == b) || (v[ev[0]] == b && v[ev[1]] == a))
+      {
+         return el_edges[k];
+      }
+   }
+   MFEM_ABORT("edge (" << a << ", " << b << ") not found in the element");
+   return -1;
+}
+
+void ParMesh::FindSharedEntityIndices()
+{
+   // Only the edges and the faces whose vertices are all shared are looked up,
+   // in hash tables of the shared entities, so the memory used is
+   // proportional to the number of shared entities.
+   Array<bool> shared_vert(NumOfVertices);
+   shared_vert = false;
+   for (int i = 0; i < svert_lvert.Size(); i++)
+   {
+      shared_vert[svert_lvert[i]] = true;
+   }
+
+   sedge_ledge.SetSize(shared_edges.Size());
+   if (shared_edges.Size())
+   {
+      HashTable<Hashed2> sedges;
+      for (int se = 0; se < shared_edges.Size(); se++)
+      {
+         const int *v = shared_edges[se]->GetVertices();
+         const int id = sedges.GetId(v[0], v[1]);
+         MFEM_VERIFY(id == se, "duplicate shared edge");
+      }
+      sedge_ledge = -1;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int *v = elements[i]->GetVertices();
+         const int *e = el_to_edge->GetRow(i);
+         for (int k = 0; k < elements[i]->GetNEdges(); k++)
+         {
+            const int *ev = elements[i]->GetEdgeVertices(k);
+            const int v0 = v[ev[0]], v1 = v[ev[1]];
+            if (!shared_vert[v0] || !shared_vert[v1]) { continue; }
+            const int se = sedges.FindId(v0, v1);
+            if (se >= 0) { sedge_ledge[se] = e[k]; }
+         }
+      }
+      MFEM_VERIFY(sedge_ledge.Min() >= 0, "invalid shared edge");
+   }
+
+   const int nst = shared_trias.Size();
+   sface_lface.SetSize(nst + shared_quads.Size());
+   if (sface_lface.Size())
+   {
+      HashTable<Hashed4> sfaces;
+      for (int st = 0; st < nst; st++)
+      {
+         const int *v = shared_trias[st].v;
+         const int id = sfaces.GetId(v[0], v[1], v[2]);
+         MFEM_VERIFY(id == st, "duplicate shared face");
+      }
+      for (int sq = 0; sq < shared_quads.Size(); sq++)
+      {
+         const int *v = shared_quads[sq].v;
+         const int id = sfaces.GetId(v[0], v[1], v[2], v[3]);
+         MFEM_VERIFY(id == nst + sq, "duplicate shared face");
+      }
+      sface_lface = -1;
+      for (int f = 0; f < NumOfFaces; f++)
+      {
+         const int *v = faces[f]->GetVertices();
+         const int nv = faces[f]->GetNVertices();
+         bool shared = true;
+         for (int k = 0; k < nv; k++) { shared = shared && shared_vert[v[k]]; }
+         if (!shared) { continue; }
+         const int sf = sfaces.FindId(v[0], v[1], v[2], (nv == 4) ? v[3] : -1);
+         if (sf >= 0) { sface_lface[sf] = f; }
+      }
+      MFEM_VERIFY(sface_lface.Min() >= 0, "invalid shared face");
+   }
+}
+
 ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine, int generate_edges,
                  bool fix_orientation)
    : glob_elem_offset(-1)
@@ -989,6 +1082,28 @@ void ParMesh::LoadSharedEntities(istream &input)
 
    // read the group topology
    input >> ident;
+   if (ident == "mfem_binary_shared_entities")
+   {
+      // binary format, see ParPrintBinary(): read the rest of the line, the
+      // header with the size of the data, and the rest of the data
+      input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      const std::string tag = ident + '\n';
+      const size_t align = bin_io::array_alignment;
+      std::vector<char> buf(tag.begin(), tag.end());
+      size_t pos = (tag.size() + align - 1) / align * align;
+      buf.resize(pos + 2*sizeof(int64_t));
+      input.read(buf.data() + tag.size(), buf.size() - tag.size());
+      int64_t hdr[2];
+      bin_io::ReadArray(buf.data(), buf.size(), pos, hdr, 2);
+      MFEM_VERIFY(input && hdr[0] == 0x0102030405060708 &&
+                  hdr[1] >= int64_t(buf.size()), "invalid binary mesh data");
+      pos = buf.size();
+      buf.resize(hdr[1]);
+      input.read(buf.data() + pos, buf.size() - pos);
+      MFEM_VERIFY(input, "unexpected end of binary mesh data");
+      LoadSharedEntities(buf.data(), buf.size());
+      return;
+   }
    MFEM_VERIFY(ident == "communication_groups",
                "input stream is not a parallel MFEM mesh");
    gtopo.Load(input);
@@ -1131,6 +1246,830 @@ void ParMesh::LoadSharedEntities(istream &input)
    }
 }
 
+void ParMesh::LoadSharedEntities(const char *buf, size_t size)
+{
+   const std::string tag = "mfem_binary_shared_entities\n";
+   MFEM_VERIFY(size >= tag.size() && std::equal(tag.begin(), tag.end(), buf),
+               "input is not a parallel MFEM binary mesh");
+   size_t pos = tag.size();
+   int64_t hdr[8];
+   bin_io::ReadArray(buf, size, pos, hdr, 8);
+   MFEM_VERIFY(hdr[0] == 0x0102030405060708 && size_t(hdr[1]) <= size,
+               "invalid binary mesh data");
+   size = hdr[1];
+
+   std::string gtopo_str(hdr[2], '\0');
+   bin_io::ReadArray(buf, size, pos, &gtopo_str[0], gtopo_str.size());
+   std::istringstream gtopo_in(gtopo_str);
+   std::string ident;
+   gtopo_in >> ident;
+   MFEM_VERIFY(ident == "communication_groups", "invalid binary mesh data");
+   gtopo.Load(gtopo_in);
+   const int ngroups = GetNGroups();
+   MFEM_VERIFY(ngroups == hdr[3], "invalid binary mesh data");
+
+   // The shared entities are stored group by group, so the J arrays of the
+   // group tables contain consecutive numbers, as in the text format.
+   Array<int> v;
+   for (int t = 0; t < 4; t++)
+   {
+      Table &group_ent = (t == 0) ? group_svert : (t == 1) ? group_sedge :
+                         (t == 2) ? group_stria : group_squad;
+      const int nent = hdr[4 + t], nv = (t == 0) ? 1 : t + 1;
+      group_ent.SetDims(ngroups - 1, nent);
+      bin_io::ReadArray(buf, size, pos, group_ent.GetI(), ngroups);
+      MFEM_VERIFY(group_ent.GetI()[0] == 0 &&
+                  group_ent.GetI()[ngroups - 1] == nent,
+                  "invalid binary mesh data");
+      for (int i = 0; i < nent; i++) { group_ent.GetJ()[i] = i; }
+
+      v.SetSize(nv*nent);
+      bin_io::ReadArray(buf, size, pos, v.GetData(), v.Size());
+      switch (t)
+      {
+         case 0:
+            svert_lvert = v;
+            break;
+         case 1:
+            sedge_ledge.SetSize(nent);
+            shared_edges.SetSize(nent);
+            for (int i = 0; i < nent; i++)
+            {
+               shared_edges[i] = new Segment(v[2*i], v[2*i+1], 1);
+            }
+            break;
+         case 2:
+            shared_trias.SetSize(nent);
+            for (int i = 0; i < nent; i++)
+            {
+               for (int j = 0; j < 3; j++) { shared_trias[i].v[j] = v[3*i+j]; }
+            }
+            break;
+         case 3:
+            shared_quads.SetSize(nent);
+            for (int i = 0; i < nent; i++)
+            {
+               for (int j = 0; j < 4; j++) { shared_quads[i].v[j] = v[4*i+j]; }
+            }
+            break;
+      }
+   }
+   sface_lface.SetSize(shared_trias.Size() + shared_quads.Size());
+}
+
+ParMesh ParMesh::LoadFromBinaryFile(MPI_Comm comm, const std::string &filename,
+                                    bool refine, bool fix_orientation)
+{
+   ParMesh mesh;
+   mesh.MyComm = comm;
+   MPI_Comm_size(comm, &mesh.NRanks);
+   MPI_Comm_rank(comm, &mesh.MyRank);
+   mesh.gtopo.SetComm(comm);
+
+   MPI_File fh;
+   MFEM_VERIFY(MPI_File_open(comm, filename.c_str(), MPI_MODE_RDONLY,
+                             MPI_INFO_NULL, &fh) == MPI_SUCCESS,
+               "Mesh file not found: " << filename);
+
+   // read the header and the range of the part of this rank, see SaveBinary()
+   const std::string tag = "MFEM binary parallel mesh v1.0\n";
+   const size_t align = bin_io::array_alignment;
+   const size_t hdr_pos = (tag.size() + align - 1) / align * align;
+   std::vector<char> hdr_buf(hdr_pos + 2*sizeof(int64_t));
+   MPI_File_read_at_all(fh, 0, hdr_buf.data(), int(hdr_buf.size()), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+   const std::string serial_tag = "MFEM binary mesh v1.0\n";
+   if (std::equal(serial_tag.begin(), serial_tag.end(), hdr_buf.data()))
+   {
+      mesh.DistributeBinaryMesh(fh);
+      MPI_File_close(&fh);
+      mesh.Finalize(refine, fix_orientation);
+      mesh.EnsureParNodes();
+      return mesh;
+   }
+   MFEM_VERIFY(std::equal(tag.begin(), tag.end(), hdr_buf.data()),
+               "input is not a parallel MFEM binary mesh: " << filename);
+   int64_t hdr[2], range[2];
+   std::memcpy(hdr, hdr_buf.data() + hdr_pos, sizeof(hdr));
+   MFEM_VERIFY(hdr[0] == 0x0102030405060708,
+               "binary mesh data with different byte order");
+   MFEM_VERIFY(hdr[1] == mesh.NRanks, "the mesh file " << filename
+               << " was written with " << hdr[1] << " MPI ranks");
+   const MPI_Offset range_pos = hdr_pos + (2 + mesh.MyRank)*sizeof(int64_t);
+   MPI_File_read_at_all(fh, range_pos, range, int(sizeof(range)), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+   MFEM_VERIFY(range[1] >= range[0] && range[1] - range[0] <= INT_MAX,
+               "invalid binary mesh data");
+
+   std::vector<char> buf(range[1] - range[0]);
+   MPI_File_read_at_all(fh, range[0], buf.data(), int(buf.size()), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+   MPI_File_close(&fh);
+
+   const size_t serial_size = mesh.ReadMFEMBinaryMesh(buf.data(), buf.size());
+   mesh.ReduceMeshGen();
+   mesh.LoadSharedEntities(buf.data() + serial_size,
+                           buf.size() - serial_size);
+   mesh.Finalize(refine, fix_orientation);
+   mesh.EnsureParNodes();
+   return mesh;
+}
+
+// Send the messages @a send[r] to all ranks r of @a comm. On return, @a recv
+// holds the messages from all ranks, in the order of the ranks, with sizes
+// @a recv_count.
+template <typename T>
+static void ExchangeAll(MPI_Comm comm, const std::vector<std::vector<T>> &send,
+                        Array<int> &recv_count, Array<T> &recv)
+{
+   const int nranks = int(send.size());
+   Array<int> send_count(nranks), send_displ(nranks), recv_displ(nranks);
+   Array<T> send_buf;
+   for (int r = 0; r < nranks; r++)
+   {
+      send_count[r] = int(send[r].size());
+      send_displ[r] = send_buf.Size();
+      send_buf.Append(send[r].data(), send_count[r]);
+   }
+   recv_count.SetSize(nranks);
+   MPI_Alltoall(send_count.GetData(), 1, MPI_INT, recv_count.GetData(), 1,
+                MPI_INT, comm);
+   int recv_size = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      recv_displ[r] = recv_size;
+      recv_size += recv_count[r];
+   }
+   recv.SetSize(recv_size);
+   MPI_Alltoallv(send_buf.GetData(), send_count.GetData(),
+                 send_displ.GetData(), MPITypeMap<T>::mpi_type, recv.GetData(),
+                 recv_count.GetData(), recv_displ.GetData(),
+                 MPITypeMap<T>::mpi_type, comm);
+}
+
+// Read @a n values of type T at the position @a pos of the file @a fh.
+template <typename T>
+static void ReadAtAll(MPI_File fh, MPI_Offset pos, T *data, long long n)
+{
+   MFEM_VERIFY(n*sizeof(T) <= INT_MAX, "the mesh part is too large");
+   MPI_File_read_at_all(fh, pos, data, int(n*sizeof(T)), MPI_BYTE,
+                        MPI_STATUS_IGNORE);
+}
+
+// Return the index along the Hilbert curve of the point with the integer
+// coordinates @a x[0..n-1], of @a b bits each, see J. Skilling, "Programming
+// the Hilbert curve", AIP Conf. Proc. 707, 2004. The array @a x is modified.
+static unsigned long long HilbertIndex(unsigned *x, int n, int b)
+{
+   const unsigned m = 1u << (b - 1);
+   // inverse undo excess work
+   for (unsigned q = m; q > 1; q >>= 1)
+   {
+      const unsigned p = q - 1;
+      for (int i = 0; i < n; i++)
+      {
+         if (x[i] & q) { x[0] ^= p; }
+         else
+         {
+            const unsigned t = (x[0] ^ x[i]) & p;
+            x[0] ^= t;
+            x[i] ^= t;
+         }
+      }
+   }
+   // Gray encode
+   for (int i = 1; i < n; i++) { x[i] ^= x[i-1]; }
+   unsigned t = 0;
+   for (unsigned q = m; q > 1; q >>= 1)
+   {
+      if (x[n-1] & q) { t ^= q - 1; }
+   }
+   for (int i = 0; i < n; i++) { x[i] ^= t; }
+   // interleave the bits of the transposed index
+   unsigned long long index = 0;
+   for (int j = b - 1; j >= 0; j--)
+   {
+      for (int i = 0; i < n; i++) { index = (index << 1) | ((x[i] >> j) & 1); }
+   }
+   return index;
+}
+
+// The vertices of a mesh are distributed in blocks, with the offsets
+// @a offsets, and @a block contains the coordinates of the vertices in the
+// block of this rank. Return in @a coords the coordinates of the vertices with
+// the sorted global numbers @a ids. If @a vranks is not NULL, also return in
+// it the ranks that requested each of the vertices in this call, and in
+// @a block_vranks the ranks that requested each vertex of the block.
+static void FetchVertices(MPI_Comm comm, const Array<int> &offsets,
+                          const Array<real_t> &block, const Array<int> &ids,
+                          Array<real_t> &coords, Table *vranks = NULL,
+                          Table *block_vranks = NULL)
+{
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+   const int first = offsets[myrank];
+
+   // send the vertex numbers to the ranks that own them
+   std::vector<std::vector<int>> msg(nranks);
+   for (int i = 0; i < ids.Size(); i++)
+   {
+      const int owner = int(std::upper_bound(offsets.begin(), offsets.end(),
+                                             ids[i]) - offsets.begin()) - 1;
+      msg[owner].push_back(ids[i]);
+   }
+   Array<int> count, req;
+   ExchangeAll(comm, msg, count, req);
+
+   // reply with the coordinates
+   std::vector<std::vector<real_t>> reply(nranks);
+   for (int r = 0, i = 0; r < nranks; r++)
+   {
+      for (int j = 0; j < count[r]; j++, i++)
+      {
+         const real_t *x = block.GetData() + 3*(req[i] - first);
+         reply[r].insert(reply[r].end(), x, x + 3);
+      }
+   }
+   Array<int> coords_count;
+   ExchangeAll(comm, reply, coords_count, coords);
+   if (!vranks) { return; }
+
+   // the ranks that requested each vertex of the block, in increasing order
+   block_vranks->MakeI(offsets[myrank+1] - first);
+   for (int i = 0; i < req.Size(); i++)
+   {
+      block_vranks->AddAColumnInRow(req[i] - first);
+   }
+   block_vranks->MakeJ();
+   for (int r = 0, i = 0; r < nranks; r++)
+   {
+      for (int j = 0; j < count[r]; j++, i++)
+      {
+         block_vranks->AddConnection(req[i] - first, r);
+      }
+   }
+   block_vranks->ShiftUpI();
+
+   // reply with the number of ranks and the ranks, for each vertex
+   for (int r = 0, i = 0; r < nranks; r++)
+   {
+      msg[r].clear();
+      for (int j = 0; j < count[r]; j++, i++)
+      {
+         const int v = req[i] - first, n = block_vranks->RowSize(v);
+         msg[r].push_back(n);
+         msg[r].insert(msg[r].end(), block_vranks->GetRow(v),
+                       block_vranks->GetRow(v) + n);
+      }
+   }
+   Array<int> ranks;
+   ExchangeAll(comm, msg, count, ranks);
+
+   vranks->SetDims(ids.Size(), ranks.Size() - ids.Size());
+   int *I = vranks->GetI(), *J = vranks->GetJ();
+   I[0] = 0;
+   for (int i = 0, k = 0; i < ids.Size(); i++)
+   {
+      const int n = ranks[k++];
+      I[i+1] = I[i] + n;
+      for (int j = 0; j < n; j++) { J[I[i] + j] = ranks[k++]; }
+   }
+}
+
+// A shared vertex, edge, triangle or quadrilateral of the mesh constructed by
+// ParMesh::DistributeBinaryMesh().
+struct DistSharedEntity
+{
+   int nv; // number of vertices
+   int gv[4]; // the global vertex numbers, sorted
+   int lv[4]; // the local vertices, in the order of the shared entity
+   int group; // the group, as numbered in the ListOfIntegerSets
+   int min_rank; // the smallest rank in the group
+
+   bool operator<(const DistSharedEntity &other) const
+   {
+      if (group != other.group) { return group < other.group; }
+      return std::lexicographical_compare(gv, gv + nv, other.gv,
+                                          other.gv + other.nv);
+   }
+};
+
+void ParMesh::DistributeBinaryMesh(MPI_File fh)
+{
+   // read the header and find the arrays in the file, see Mesh::PrintBinary()
+   const std::string tag = "MFEM binary mesh v1.0\n";
+   const MPI_Offset align = bin_io::array_alignment;
+   MPI_Offset pos = tag.size();
+   auto next_array = [&pos, align](MPI_Offset nbytes)
+   {
+      pos = (pos + align - 1) / align * align;
+      const MPI_Offset start = pos;
+      pos += nbytes;
+      return start;
+   };
+   int64_t hdr[16];
+   ReadAtAll(fh, next_array(sizeof(hdr)), hdr, 16);
+   MFEM_VERIFY(hdr[0] == 0x0102030405060708,
+               "binary mesh data with different byte order");
+   MFEM_VERIFY(hdr[2] == sizeof(real_t),
+               "binary mesh data with different size of real_t");
+   MFEM_VERIFY(hdr[10] == 0, "curved meshes cannot be partitioned while "
+               "reading, use the ParMesh constructor from a serial Mesh");
+   Dim = hdr[3];
+   spaceDim = hdr[4];
+   const int nv = hdr[5];
+   const int num_elems[2] = { int(hdr[6]), int(hdr[7]) };
+   const MPI_Offset vert_pos = next_array(3*nv*sizeof(real_t));
+   MPI_Offset geom_pos[2], attr_pos[2], conn_pos[2], sets_pos[2];
+   for (int b = 0; b < 2; b++)
+   {
+      geom_pos[b] = next_array(num_elems[b]*sizeof(int));
+      attr_pos[b] = next_array(num_elems[b]*sizeof(int));
+      conn_pos[b] = next_array(hdr[8 + b]*sizeof(int));
+   }
+   for (int b = 0; b < 2; b++) { sets_pos[b] = next_array(hdr[14 + b]); }
+
+   for (int b = 0; b < 2; b++)
+   {
+      std::string sets_str(hdr[14 + b], '\0');
+      ReadAtAll(fh, sets_pos[b], &sets_str[0], sets_str.size());
+      if (sets_str.empty()) { continue; }
+      std::istringstream sets_in(sets_str);
+      AttributeSets &sets = b ? bdr_attribute_sets : attribute_sets;
+      sets.attr_sets.Load(sets_in);
+      sets.attr_sets.SortAll();
+      sets.attr_sets.UniqueAll();
+   }
+
+   // Each rank reads a block of the elements, of the boundary elements and of
+   // the vertices.
+   auto block_begin = [this](long long n, int rank)
+   {
+      return int(n*rank/NRanks);
+   };
+   Array<int> geom[2], attr[2], conn[2];
+   int first[2];
+   for (int b = 0; b < 2; b++)
+   {
+      first[b] = block_begin(num_elems[b], MyRank);
+      const int n = block_begin(num_elems[b], MyRank + 1) - first[b];
+      geom[b].SetSize(n);
+      attr[b].SetSize(n);
+      ReadAtAll(fh, geom_pos[b] + first[b]*sizeof(int), geom[b].GetData(), n);
+      ReadAtAll(fh, attr_pos[b] + first[b]*sizeof(int), attr[b].GetData(), n);
+      long long conn_size = 0, conn_first = 0;
+      for (int i = 0; i < n; i++)
+      {
+         MFEM_VERIFY(geom[b][i] >= 0 && geom[b][i] < Geometry::NUM_GEOMETRIES,
+                     "invalid binary mesh data");
+         conn_size += Geometry::NumVerts[geom[b][i]];
+      }
+      MPI_Exscan(&conn_size, &conn_first, 1, MPI_LONG_LONG, MPI_SUM, MyComm);
+      if (MyRank == 0) { conn_first = 0; }
+      MFEM_VERIFY(conn_first + conn_size <= hdr[8 + b],
+                  "invalid binary mesh data");
+      conn[b].SetSize(int(conn_size));
+      ReadAtAll(fh, conn_pos[b] + conn_first*sizeof(int), conn[b].GetData(),
+                conn_size);
+   }
+   Array<int> vert_offsets(NRanks + 1);
+   for (int r = 0; r <= NRanks; r++) { vert_offsets[r] = block_begin(nv, r); }
+   const int block_nv = vert_offsets[MyRank + 1] - vert_offsets[MyRank];
+   Array<real_t> block_coords(3*block_nv);
+   ReadAtAll(fh, vert_pos + 3*vert_offsets[MyRank]*sizeof(real_t),
+             block_coords.GetData(), 3*block_nv);
+
+   // Partition the elements along the Hilbert curve through their centroids.
+   // The keys splitting the curve into pieces with the same number of elements
+   // are found by bisection, with global counts of the keys.
+   real_t bb_min[3], bb_max[3];
+   for (int d = 0; d < 3; d++)
+   {
+      bb_min[d] = std::numeric_limits<real_t>::max();
+      bb_max[d] = std::numeric_limits<real_t>::lowest();
+      for (int i = 0; i < block_nv; i++)
+      {
+         bb_min[d] = std::min(bb_min[d], block_coords[3*i + d]);
+         bb_max[d] = std::max(bb_max[d], block_coords[3*i + d]);
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, bb_min, 3, MPITypeMap<real_t>::mpi_type,
+                 MPI_MIN, MyComm);
+   MPI_Allreduce(MPI_IN_PLACE, bb_max, 3, MPITypeMap<real_t>::mpi_type,
+                 MPI_MAX, MyComm);
+
+   const int ne = geom[0].Size();
+   std::vector<unsigned long long> keys(ne);
+   {
+      Array<int> ids(conn[0]);
+      ids.Sort();
+      ids.Unique();
+      Array<real_t> coords;
+      FetchVertices(MyComm, vert_offsets, block_coords, ids, coords);
+
+      const int sdim = std::max(1, std::min(spaceDim, 3));
+      const int bits = (sdim == 3) ? 21 : 31;
+      const real_t max_x = real_t((1u << bits) - 1);
+      for (int i = 0, k = 0; i < ne; i++)
+      {
+         const int nev = Geometry::NumVerts[geom[0][i]];
+         real_t center[3] = { 0.0, 0.0, 0.0 };
+         for (int j = 0; j < nev; j++, k++)
+         {
+            const int v = int(std::lower_bound(ids.begin(), ids.end(),
+                                               conn[0][k]) - ids.begin());
+            for (int d = 0; d < 3; d++) { center[d] += coords[3*v + d]; }
+         }
+         unsigned x[3];
+         for (int d = 0; d < sdim; d++)
+         {
+            const real_t h = bb_max[d] - bb_min[d];
+            const real_t s = (h > 0.0) ? (center[d]/nev - bb_min[d])/h : 0.0;
+            x[d] = unsigned(std::min(std::max(s, real_t(0)), real_t(1))*max_x);
+         }
+         keys[i] = HilbertIndex(x, sdim, bits);
+      }
+   }
+
+   const int nsplit = NRanks - 1;
+   std::vector<unsigned long long> lo(nsplit, 0), hi(nsplit, 1ull << 63);
+   {
+      std::vector<unsigned long long> sorted_keys(keys);
+      std::sort(sorted_keys.begin(), sorted_keys.end());
+      std::vector<long long> count(nsplit);
+      auto mid = [&lo, &hi](int j) { return lo[j] + (hi[j] - lo[j])/2; };
+      while (lo != hi)
+      {
+         for (int j = 0; j < nsplit; j++)
+         {
+            count[j] = std::lower_bound(sorted_keys.begin(), sorted_keys.end(),
+                                        mid(j)) - sorted_keys.begin();
+         }
+         MPI_Allreduce(MPI_IN_PLACE, count.data(), nsplit, MPI_LONG_LONG,
+                       MPI_SUM, MyComm);
+         for (int j = 0; j < nsplit; j++)
+         {
+            const long long target = block_begin(num_elems[0], j + 1);
+            if (count[j] >= target) { hi[j] = mid(j); }
+            else { lo[j] = mid(j) + 1; }
+         }
+      }
+   }
+
+   // Send the elements to their ranks as records (global number, geometry,
+   // attribute, vertices). They are received in the order of their global
+   // numbers, which is kept for the local elements.
+   std::vector<std::vector<int>> msg(NRanks);
+   for (int i = 0, k = 0; i < ne; i++)
+   {
+      const int nev = Geometry::NumVerts[geom[0][i]];
+      std::vector<int> &rec = msg[std::upper_bound(lo.begin(), lo.end(),
+                                                   keys[i]) - lo.begin()];
+      rec.push_back(first[0] + i);
+      rec.push_back(geom[0][i]);
+      rec.push_back(attr[0][i]);
+      rec.insert(rec.end(), conn[0].GetData() + k, conn[0].GetData() + k + nev);
+      k += nev;
+   }
+   std::vector<unsigned long long>().swap(keys);
+   geom[0].DeleteAll();
+   attr[0].DeleteAll();
+   conn[0].DeleteAll();
+   Array<int> count, recs;
+   ExchangeAll(MyComm, msg, count, recs);
+
+   // the local vertices, in the order of their global numbers
+   Array<int> glob_vert;
+   NumOfElements = 0;
+   for (int k = 0; k < recs.Size(); NumOfElements++)
+   {
+      const int nev = Geometry::NumVerts[recs[k + 1]];
+      glob_vert.Append(recs.GetData() + k + 3, nev);
+      k += 3 + nev;
+   }
+   glob_vert.Sort();
+   glob_vert.Unique();
+   auto local_vertex = [&glob_vert](int gv)
+   {
+      const int *v = std::lower_bound(glob_vert.begin(), glob_vert.end(), gv);
+      return (v != glob_vert.end() && *v == gv) ?
+             int(v - glob_vert.begin()) : -1;
+   };
+
+   Table vranks, block_vranks;
+   {
+      Array<real_t> coords;
+      FetchVertices(MyComm, vert_offsets, block_coords, glob_vert, coords,
+                    &vranks, &block_vranks);
+      block_coords.DeleteAll();
+      NumOfVertices = glob_vert.Size();
+      vertices.SetSize(NumOfVertices);
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (int d = 0; d < 3; d++) { vertices[i](d) = coords[3*i + d]; }
+      }
+   }
+
+   elements.SetSize(NumOfElements);
+   for (int i = 0, k = 0; i < NumOfElements; i++)
+   {
+      const int nev = Geometry::NumVerts[recs[k + 1]];
+      elements[i] = NewElement(recs[k + 1]);
+      elements[i]->SetAttribute(recs[k + 2]);
+      int *v = elements[i]->GetVertices();
+      for (int j = 0; j < nev; j++) { v[j] = local_vertex(recs[k + 3 + j]); }
+      k += 3 + nev;
+   }
+
+   // Shared entities: a vertex is shared if more than one rank requested it.
+   // An edge or a face may be shared if all its vertices are shared, and the
+   // ranks that have all of them are asked whether they have the entity, too.
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+   std::vector<DistSharedEntity> shared[4], cand;
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      if (vranks.RowSize(i) < 2) { continue; }
+      DistSharedEntity ent;
+      ent.nv = 1;
+      ent.gv[0] = glob_vert[i];
+      ent.lv[0] = i;
+      group.Recreate(vranks.RowSize(i), vranks.GetRow(i));
+      ent.group = groups.Insert(group);
+      ent.min_rank = vranks.GetRow(i)[0];
+      shared[0].push_back(ent);
+   }
+
+   auto add_candidate = [&](int nev, const int *lv)
+   {
+      DistSharedEntity ent;
+      ent.nv = nev;
+      for (int j = 0; j < nev; j++)
+      {
+         if (vranks.RowSize(lv[j]) < 2) { return; }
+         ent.lv[j] = lv[j];
+         ent.gv[j] = glob_vert[lv[j]];
+      }
+      std::sort(ent.gv, ent.gv + nev);
+      ent.group = 0;
+      cand.push_back(ent);
+   };
+   DSTable v_to_v(NumOfVertices);
+   if (Dim > 1) { GetVertexToVertexTable(v_to_v); }
+   for (int i = 0; i < NumOfVertices && Dim > 1; i++)
+   {
+      for (DSTable::RowIterator it(v_to_v, i); !it; ++it)
+      {
+         const int lv[2] = { i, it.Column() };
+         add_candidate(2, lv);
+      }
+   }
+   std::unique_ptr<STable3D> faces_tbl;
+   if (Dim == 3)
+   {
+      faces_tbl.reset(GetFacesTable());
+      const size_t nedges = cand.size();
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int *v = elements[i]->GetVertices();
+         for (int f = 0; f < elements[i]->GetNFaces(); f++)
+         {
+            const int nfv = elements[i]->GetNFaceVertices(f);
+            const int *fv = elements[i]->GetFaceVertices(f);
+            int lv[4];
+            for (int j = 0; j < nfv; j++) { lv[j] = v[fv[j]]; }
+            add_candidate(nfv, lv);
+         }
+      }
+      // the faces of two local elements are not shared
+      std::sort(cand.begin() + nedges, cand.end());
+      size_t n = nedges;
+      for (size_t i = nedges, j; i < cand.size(); i = j)
+      {
+         for (j = i + 1; j < cand.size() && !(cand[i] < cand[j]); j++) { }
+         if (j == i + 1) { cand[n++] = cand[i]; }
+      }
+      cand.resize(n);
+   }
+
+   // does this rank have the entity with the sorted global vertices gv?
+   auto have_entity = [&](int nev, const int *gv)
+   {
+      int lv[4];
+      for (int j = 0; j < nev; j++)
+      {
+         lv[j] = local_vertex(gv[j]);
+         if (lv[j] < 0) { return false; }
+      }
+      if (nev == 1) { return true; }
+      if (nev == 2) { return v_to_v(lv[0], lv[1]) >= 0; }
+      // the local numbering follows the global one, so lv[0..2] are the three
+      // smallest vertices, which identify the face in faces_tbl
+      return faces_tbl && faces_tbl->Index(lv[0], lv[1], lv[2]) >= 0;
+   };
+
+   std::vector<std::vector<int>> query(NRanks);
+   for (auto &m : msg) { m.clear(); }
+   for (size_t c = 0; c < cand.size(); c++)
+   {
+      const DistSharedEntity &ent = cand[c];
+      const int *r0 = vranks.GetRow(ent.lv[0]);
+      for (int k = 0; k < vranks.RowSize(ent.lv[0]); k++)
+      {
+         bool in_all = (r0[k] != MyRank);
+         for (int j = 1; j < ent.nv && in_all; j++)
+         {
+            const int *rj = vranks.GetRow(ent.lv[j]);
+            in_all = std::binary_search(rj, rj + vranks.RowSize(ent.lv[j]),
+                                        r0[k]);
+         }
+         if (!in_all) { continue; }
+         msg[r0[k]].push_back(ent.nv);
+         msg[r0[k]].insert(msg[r0[k]].end(), ent.gv, ent.gv + ent.nv);
+         query[r0[k]].push_back(int(c));
+      }
+   }
+   Array<int> queries, answers;
+   ExchangeAll(MyComm, msg, count, queries);
+   for (int r = 0, k = 0; r < NRanks; r++)
+   {
+      msg[r].clear();
+      for (const int end = k + count[r]; k < end; k += 1 + queries[k])
+      {
+         msg[r].push_back(have_entity(queries[k], queries.GetData() + k + 1));
+      }
+   }
+   ExchangeAll(MyComm, msg, count, answers);
+
+   std::vector<std::vector<int>> cand_ranks(cand.size());
+   for (int r = 0, k = 0; r < NRanks; r++)
+   {
+      for (int j = 0; j < count[r]; j++, k++)
+      {
+         if (answers[k]) { cand_ranks[query[r][j]].push_back(r); }
+      }
+   }
+   for (size_t c = 0; c < cand.size(); c++)
+   {
+      std::vector<int> &ranks = cand_ranks[c];
+      if (ranks.empty()) { continue; }
+      ranks.push_back(MyRank);
+      DistSharedEntity &ent = cand[c];
+      group.Recreate(int(ranks.size()), ranks.data());
+      ent.group = groups.Insert(group);
+      ent.min_rank = *std::min_element(ranks.begin(), ranks.end());
+      // The shared edges and triangles list their vertices in the order of
+      // the global numbers. The quadrilaterals start from their smallest
+      // vertex, towards its smaller neighbor.
+      if (ent.nv == 4)
+      {
+         int s = 0, lv[4];
+         for (int j = 1; j < 4; j++)
+         {
+            if (glob_vert[ent.lv[j]] < glob_vert[ent.lv[s]]) { s = j; }
+         }
+         const int dir = (ent.lv[(s + 1) % 4] < ent.lv[(s + 3) % 4]) ? 1 : 3;
+         for (int j = 0; j < 4; j++) { lv[j] = ent.lv[(s + j*dir) % 4]; }
+         std::copy(lv, lv + 4, ent.lv);
+      }
+      else
+      {
+         std::sort(ent.lv, ent.lv + ent.nv);
+      }
+      shared[ent.nv - 1].push_back(ent);
+   }
+   std::vector<DistSharedEntity>().swap(cand);
+
+   // Send each boundary element to the owner of its first vertex, which sends
+   // it on to all the ranks that have this vertex. The ranks that have the
+   // face keep it, except that a shared face is kept by its smallest rank.
+   for (auto &m : msg) { m.clear(); }
+   for (int i = 0, k = 0; i < geom[1].Size(); i++)
+   {
+      const int nbv = Geometry::NumVerts[geom[1][i]];
+      const int owner =
+         int(std::upper_bound(vert_offsets.begin(), vert_offsets.end(),
+                              conn[1][k]) - vert_offsets.begin()) - 1;
+      std::vector<int> &rec = msg[owner];
+      rec.push_back(first[1] + i);
+      rec.push_back(geom[1][i]);
+      rec.push_back(attr[1][i]);
+      rec.insert(rec.end(), conn[1].GetData() + k, conn[1].GetData() + k + nbv);
+      k += nbv;
+   }
+   geom[1].DeleteAll();
+   attr[1].DeleteAll();
+   conn[1].DeleteAll();
+   ExchangeAll(MyComm, msg, count, recs);
+   for (auto &m : msg) { m.clear(); }
+   for (int k = 0; k < recs.Size(); )
+   {
+      const int nbv = Geometry::NumVerts[recs[k + 1]];
+      const int v = recs[k + 3] - vert_offsets[MyRank];
+      for (int j = 0; j < block_vranks.RowSize(v); j++)
+      {
+         std::vector<int> &rec = msg[block_vranks.GetRow(v)[j]];
+         rec.insert(rec.end(), recs.GetData() + k,
+                    recs.GetData() + k + 3 + nbv);
+      }
+      k += 3 + nbv;
+   }
+   ExchangeAll(MyComm, msg, count, recs);
+
+   // The shared faces are in shared[Dim-1] and, in 3D, the shared quadrilateral
+   // faces in shared[3]; the boundary elements are looked up by their vertices
+   auto by_verts = [](const DistSharedEntity &a, const DistSharedEntity &b)
+   {
+      return std::lexicographical_compare(a.gv, a.gv + a.nv, b.gv, b.gv + b.nv);
+   };
+   for (int t = Dim - 1; t < ((Dim == 3) ? 4 : Dim); t++)
+   {
+      std::sort(shared[t].begin(), shared[t].end(), by_verts);
+   }
+   std::vector<std::pair<int,int>> bdr_recs; // (global number, position)
+   for (int k = 0; k < recs.Size(); )
+   {
+      const int nbv = Geometry::NumVerts[recs[k + 1]];
+      DistSharedEntity face;
+      face.nv = nbv;
+      std::copy(recs.GetData() + k + 3, recs.GetData() + k + 3 + nbv, face.gv);
+      std::sort(face.gv, face.gv + nbv);
+      if (have_entity(nbv, face.gv))
+      {
+         const std::vector<DistSharedEntity> &shared_faces = shared[nbv - 1];
+         auto sface = std::lower_bound(shared_faces.begin(),
+                                       shared_faces.end(), face, by_verts);
+         if (sface == shared_faces.end() || by_verts(face, *sface) ||
+             sface->min_rank == MyRank)
+         {
+            bdr_recs.push_back(std::make_pair(recs[k], k));
+         }
+      }
+      k += 3 + nbv;
+   }
+   std::sort(bdr_recs.begin(), bdr_recs.end());
+   NumOfBdrElements = int(bdr_recs.size());
+   boundary.SetSize(NumOfBdrElements);
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      const int *rec = recs.GetData() + bdr_recs[i].second;
+      boundary[i] = NewElement(rec[1]);
+      boundary[i]->SetAttribute(rec[2]);
+      int *v = boundary[i]->GetVertices();
+      for (int j = 0; j < boundary[i]->GetNVertices(); j++)
+      {
+         v[j] = local_vertex(rec[3 + j]);
+      }
+   }
+
+   // don't generate any boundary elements, see Mesh::Loader
+   FinalizeTopology(false);
+   ReduceMeshGen();
+
+   // The shared entities are stored group by group, in the order of their
+   // global vertex numbers, which is the same on all ranks in the group.
+   gtopo.Create(groups, 822);
+   const int ngroups = groups.Size();
+   for (int t = 0; t < 4; t++)
+   {
+      std::vector<DistSharedEntity> &ents = shared[t];
+      std::sort(ents.begin(), ents.end());
+      const int nent = int(ents.size());
+      Table &group_ent = (t == 0) ? group_svert : (t == 1) ? group_sedge :
+                         (t == 2) ? group_stria : group_squad;
+      group_ent.SetDims(ngroups - 1, nent);
+      int *I = group_ent.GetI(), *J = group_ent.GetJ();
+      for (int gr = 0; gr < ngroups; gr++) { I[gr] = 0; }
+      for (int i = 0; i < nent; i++) { I[ents[i].group]++; J[i] = i; }
+      for (int gr = 1; gr < ngroups; gr++) { I[gr] += I[gr - 1]; }
+      switch (t)
+      {
+         case 0:
+            svert_lvert.SetSize(nent);
+            for (int i = 0; i < nent; i++) { svert_lvert[i] = ents[i].lv[0]; }
+            break;
+         case 1:
+            shared_edges.SetSize(nent);
+            for (int i = 0; i < nent; i++)
+            {
+               shared_edges[i] = new Segment(ents[i].lv[0], ents[i].lv[1], 1);
+            }
+            break;
+         case 2:
+            shared_trias.SetSize(nent);
+            for (int i = 0; i < nent; i++) { shared_trias[i].Set(ents[i].lv); }
+            break;
+         case 3:
+            shared_quads.SetSize(nent);
+            for (int i = 0; i < nent; i++) { shared_quads[i].Set(ents[i].lv); }
+            break;
+      }
+   }
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
 {
    MakeRefined_(*orig_mesh, ref_factor, ref_type);
@@ -4015,7 +4954,15 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
-void ParMesh::RebalanceImpl(const Array<int> *partition)
+void ParMesh::Rebalance(const Array<real_t> &elem_weights,
+                        real_t imbalance_tol)
+{
+   RebalanceImpl(NULL, &elem_weights, imbalance_tol);
+}
+
+void ParMesh::RebalanceImpl(const Array<int> *partition,
+                            const Array<real_t> *elem_weights,
+                            real_t imbalance_tol)
 {
    if (Conforming())
    {
@@ -4032,7 +4979,14 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance(partition);
+   if (elem_weights)
+   {
+      pncmesh->Rebalance(*elem_weights, imbalance_tol);
+   }
+   else
+   {
+      pncmesh->Rebalance(partition);
+   }
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
@@ -4359,18 +5313,24 @@ void ParMesh::UniformRefineGroups2D(int old_nv)
       sedges.CopyTo(J_group_sedge + I_group_sedge[group]);
    }
 
-   FinalizeParTopo();
+   FindSharedEntityIndices();
 
    group_svert.SetIJ(I_group_svert, J_group_svert);
    group_sedge.SetIJ(I_group_sedge, J_group_sedge);
 }
 
 void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
-                                    const DSTable &old_v_to_v,
-                                    const STable3D &old_faces,
-                                    Array<int> *f2qf)
+                                    const Array<int> &stria_edges,
+                                    const Array<int> &squad_edges,
+                                    const Array<int> &squad_faces,
+                                    const Array<int> &e2v,
+                                    const Array<int> &f2qf)
 {
-   // f2qf can be NULL if all faces are quads or there are no quad faces
+   // e2v and f2qf can be empty, see Mesh::UniformRefinement3D_base()
+   auto edge_mid = [old_nv, &e2v](int edge)
+   {
+      return old_nv + (e2v.Size() ? e2v[edge] : edge);
+   };
 
    Array<int> group_verts, group_edges, group_trias, group_quads;
 
@@ -4413,7 +5373,7 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
       for (int i = 0; i < group_sedge.RowSize(group); i++)
       {
          int *v = shared_edges[group_edges[i]]->GetVertices();
-         const int ind = old_nv + old_v_to_v(v[0], v[1]);
+         const int ind = edge_mid(sedge_ledge[group_edges[i]]);
          // add a vertex
          group_verts.Append(svert_lvert.Append(ind)-1);
          // update the edges
@@ -4430,9 +5390,9 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
          const int stria = group_trias[i];
          int *v = shared_trias[stria].v;
          // add the refinement edges
-         m[0] = old_nv + old_v_to_v(v[0], v[1]);
-         m[1] = old_nv + old_v_to_v(v[1], v[2]);
-         m[2] = old_nv + old_v_to_v(v[2], v[0]);
+         m[0] = edge_mid(stria_edges[3*stria+0]);
+         m[1] = edge_mid(stria_edges[3*stria+1]);
+         m[2] = edge_mid(stria_edges[3*stria+2]);
          const int edge_attr = 1;
          shared_edges.Append(new Segment(m[0], m[1], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
@@ -4461,16 +5421,16 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
          int m[5];
          const int squad = group_quads[i];
          int *v = shared_quads[squad].v;
-         const int olf = old_faces(v[0], v[1], v[2], v[3]);
-         // f2qf can be NULL if all faces are quads
-         m[0] = oface + (f2qf ? (*f2qf)[olf] : olf);
+         const int olf = squad_faces[squad];
+         // f2qf is empty if all faces are quads
+         m[0] = oface + (f2qf.Size() ? f2qf[olf] : olf);
          // add a vertex
          group_verts.Append(svert_lvert.Append(m[0])-1);
          // add the refinement edges
-         m[1] = old_nv + old_v_to_v(v[0], v[1]);
-         m[2] = old_nv + old_v_to_v(v[1], v[2]);
-         m[3] = old_nv + old_v_to_v(v[2], v[3]);
-         m[4] = old_nv + old_v_to_v(v[3], v[0]);
+         m[1] = edge_mid(squad_edges[4*squad+0]);
+         m[2] = edge_mid(squad_edges[4*squad+1]);
+         m[3] = edge_mid(squad_edges[4*squad+2]);
+         m[4] = edge_mid(squad_edges[4*squad+3]);
          const int edge_attr = 1;
          shared_edges.Append(new Segment(m[1], m[0], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
@@ -4506,7 +5466,7 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
       group_quads.CopyTo(J_group_squad + I_group_squad[group]);
    }
 
-   FinalizeParTopo();
+   FindSharedEntityIndices();
 
    group_svert.SetIJ(I_group_svert, J_group_svert);
    group_sedge.SetIJ(I_group_sedge, J_group_sedge);
@@ -4542,26 +5502,58 @@ void ParMesh::UniformRefinement3D()
 {
    DeleteFaceNbrData();
 
+   if (el_to_edge == NULL)
+   {
+      el_to_edge = new Table;
+      NumOfEdges = GetElementToEdgeTable(*el_to_edge);
+   }
+
    const int old_nv = NumOfVertices;
    const int old_nedges = NumOfEdges;
 
-   DSTable v_to_v(NumOfVertices);
-   GetVertexToVertexTable(v_to_v);
-   auto faces_tbl = std::unique_ptr<STable3D>(GetFacesTable());
+   // Find the old local edges of the shared triangles and quadrilaterals in
+   // the elements containing them, and the old local faces of the shared
+   // quadrilaterals, instead of building tables of all local edges and faces.
+   const int nst = shared_trias.Size(), nsq = shared_quads.Size();
+   MFEM_ASSERT(sface_lface.Size() == nst + nsq, "invalid shared faces");
+   Array<int> stria_edges(3*nst), squad_edges(4*nsq), squad_faces(nsq);
+   for (int st = 0; st < nst; st++)
+   {
+      const int el = faces_info[sface_lface[st]].Elem1No;
+      const int *v = shared_trias[st].v;
+      for (int k = 0; k < 3; k++)
+      {
+         stria_edges[3*st+k] = FindElementEdge(elements[el],
+                                               el_to_edge->GetRow(el),
+                                               v[k], v[(k+1)%3]);
+      }
+   }
+   for (int sq = 0; sq < nsq; sq++)
+   {
+      squad_faces[sq] = sface_lface[nst+sq];
+      const int el = faces_info[squad_faces[sq]].Elem1No;
+      const int *v = shared_quads[sq].v;
+      for (int k = 0; k < 4; k++)
+      {
+         squad_edges[4*sq+k] = FindElementEdge(elements[el],
+                                               el_to_edge->GetRow(el),
+                                               v[k], v[(k+1)%4]);
+      }
+   }
 
    // call Mesh::UniformRefinement3D_base so that it won't update the nodes
-   Array<int> f2qf;
+   Array<int> f2qf, e2v;
    {
       const bool update_nodes = false;
-      UniformRefinement3D_base(&f2qf, &v_to_v, update_nodes);
-      // Note: for meshes that have triangular faces, v_to_v is modified by the
-      //       above call to return different edge indices - this is used when
-      //       updating the groups. This is needed by ReorientTetMesh().
+      UniformRefinement3D_base(&f2qf, &e2v, update_nodes);
+      // Note: for meshes that have triangular faces, the midpoints of the
+      //       edges are numbered by e2v - this is used when updating the
+      //       groups. This is needed by ReorientTetMesh().
    }
 
    // update the groups
-   UniformRefineGroups3D(old_nv, old_nedges, v_to_v, *faces_tbl,
-                         f2qf.Size() ? &f2qf : NULL);
+   UniformRefineGroups3D(old_nv, old_nedges, stria_edges, squad_edges,
+                         squad_faces, e2v, f2qf);
 
    UpdateNodes();
 }
@@ -6394,6 +7386,83 @@ void ParMesh::ParPrint(ostream &os, const std::string &comments) const
    os << "\nmfem_mesh_end" << endl;
 }
 
+void ParMesh::ParPrintBinary(std::ostream &os) const
+{
+   MFEM_VERIFY(Conforming() && !NURBSext, "nonconforming and NURBS meshes are"
+               " not supported by the binary mesh format");
+
+   // the serial part is padded, so the shared entities are aligned, too
+   PrintBinary(os);
+
+   std::ostringstream gtopo_out;
+   gtopo.Save(gtopo_out);
+   const std::string gtopo_str = gtopo_out.str();
+
+   // offsets and vertices of the shared entities, group by group
+   const int ngroups = GetNGroups();
+   Array<int> offsets[4], v[4];
+   for (int t = 0; t < 4; t++)
+   {
+      offsets[t].SetSize(ngroups);
+      offsets[t] = 0;
+      if (Dim <= std::min(t, 2)) { continue; } // entities of dimension < Dim
+      const Table &group_ent = (t == 0) ? group_svert : (t == 1) ? group_sedge :
+                               (t == 2) ? group_stria : group_squad;
+      for (int gr = 1; gr < ngroups; gr++)
+      {
+         const int ne = group_ent.RowSize(gr-1);
+         const int *ent = group_ent.GetRow(gr-1);
+         offsets[t][gr] = offsets[t][gr-1] + ne;
+         for (int i = 0; i < ne; i++)
+         {
+            switch (t)
+            {
+               case 0: v[t].Append(svert_lvert[ent[i]]); break;
+               case 1:
+                  v[t].Append(shared_edges[ent[i]]->GetVertices(), 2);
+                  break;
+               case 2: v[t].Append(shared_trias[ent[i]].v, 3); break;
+               case 3: v[t].Append(shared_quads[ent[i]].v, 4); break;
+            }
+         }
+      }
+   }
+
+   const size_t align = bin_io::array_alignment;
+   const std::string tag = "mfem_binary_shared_entities\n";
+   std::vector<char> buf(tag.begin(), tag.end());
+   const size_t hdr_pos = (tag.size() + align - 1) / align * align;
+   const int64_t hdr[8] =
+   {
+      0x0102030405060708, // byte order
+      0, // total size, set below
+      (int64_t) gtopo_str.size(), ngroups,
+      offsets[0].Last(), offsets[1].Last(), offsets[2].Last(), offsets[3].Last()
+   };
+   bin_io::AppendArray(buf, hdr, 8);
+   bin_io::AppendArray(buf, gtopo_str.data(), gtopo_str.size());
+   for (int t = 0; t < 4; t++)
+   {
+      bin_io::AppendArray(buf, offsets[t].GetData(), ngroups);
+      bin_io::AppendArray(buf, v[t].GetData(), v[t].Size());
+   }
+   buf.resize((buf.size() + align - 1) / align * align, 0);
+
+   const int64_t size = buf.size();
+   std::memcpy(buf.data() + hdr_pos + sizeof(int64_t), &size, sizeof(int64_t));
+   os.write(buf.data(), buf.size());
+}
+
+void ParMesh::SaveBinary(const std::string &fname) const
+{
+   std::ostringstream part;
+   ParPrintBinary(part);
+   const bool ok = DataCollection::WriteParallelBinaryFile(
+                      MyComm, fname, "MFEM binary parallel mesh v1.0\n",
+                      part.str());
+   MFEM_VERIFY(ok, "Error writing file: " << fname);
+}
+
 void ParMesh::PrintVTU(std::string pathname,
                        VTKFormat format,
                        bool high_order_output,
@@ -109,6 +109,10 @@ protected:
    // Determine sedge_ledge and sface_lface.
    void FinalizeParTopo();
 
+   // Determine sedge_ledge and sface_lface from el_to_edge and the faces, which
+   // must be up to date, without tables of all local edges and faces.
+   void FindSharedEntityIndices();
+
    // Mark all tets to ensure consistency across MPI tasks; also mark the shared
    // and boundary triangle faces using the consistently marked tets.
    void MarkTetMeshForRefinement(const DSTable &v_to_v) override;
@@ -168,11 +172,16 @@ protected:
 
    void UniformRefineGroups2D(int old_nv);
 
-   // f2qf can be NULL if all faces are quads or there are no quad faces
+   // The old local edges of the shared triangles and quadrilaterals and the
+   // old local faces of the shared quadrilaterals are given in stria_edges,
+   // squad_edges and squad_faces; e2v and f2qf can be empty, see
+   // Mesh::UniformRefinement3D_base().
    void UniformRefineGroups3D(int old_nv, int old_nedges,
-                              const DSTable &old_v_to_v,
-                              const STable3D &old_faces,
-                              Array<int> *f2qf);
+                              const Array<int> &stria_edges,
+                              const Array<int> &squad_edges,
+                              const Array<int> &squad_faces,
+                              const Array<int> &e2v,
+                              const Array<int> &f2qf);
 
    void ExchangeFaceNbrData(Table *gr_sface, int *s2l_face);
 
@@ -202,7 +211,9 @@ protected:
                                   real_t threshold, int nc_limit = 0,
                                   int op = 1) override;
 
-   void RebalanceImpl(const Array<int> *partition);
+   void RebalanceImpl(const Array<int> *partition,
+                      const Array<real_t> *elem_weights = NULL,
+                      real_t imbalance_tol = 0.0);
 
    void DeleteFaceNbrData();
 
@@ -316,6 +327,15 @@ protected:
    void DistributeAttributes(Array<int> &attr);
 
    void LoadSharedEntities(std::istream &input);
+   /// Read the shared entities written by ParPrintBinary() from a buffer.
+   void LoadSharedEntities(const char *buf, size_t size);
+
+   /** Read a serial mesh in the MFEM binary format from the file @a fh, with
+       each rank reading a block of the elements and the vertices, partition
+       it along a Hilbert curve through the element centers and send the
+       elements to their ranks, so that no rank holds the whole mesh. Curved
+       meshes are not supported. */
+   void DistributeBinaryMesh(MPI_File fh);
 
    /// If the mesh is curved, make sure 'Nodes' is ParGridFunction.
    /** Note that this method is not related to the public 'Mesh::EnsureNodes`.*/
@@ -392,6 +412,25 @@ public:
        See @a Mesh::MakeSimplicial for more details. */
    static ParMesh MakeSimplicial(ParMesh &orig_mesh);
 
+   /** @brief Read a parallel mesh from a single file written with
+       SaveBinary(), using MPI-IO.
+
+       Each MPI rank reads only its own part of the file. The number of MPI
+       ranks in @a comm must be the same as when the file was written.
+
+       The file can also be a serial mesh written with Mesh::SaveBinary(), in
+       which case it is read in chunks by all ranks and partitioned along a
+       Hilbert curve through the element centers, with any number of ranks and
+       without reading the whole mesh on any rank. Other serial formats can be
+       converted once with Mesh::SaveBinary(). Curved serial meshes are not
+       supported in this case.
+
+       The @a refine and @a fix_orientation parameters are passed to the method
+       Mesh::Finalize(). */
+   static ParMesh LoadFromBinaryFile(MPI_Comm comm, const std::string &filename,
+                                     bool refine = true,
+                                     bool fix_orientation = true);
+
    void Finalize(bool refine = false, bool fix_orientation = false) override;
 
    void SetAttributes() override;
@@ -719,11 +758,33 @@ public:
        i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance a nonconforming mesh with weighted elements. The local
+       element 'i' has the cost @a elem_weights[i], and the elements are
+       migrated so that the total cost on each processor is within a factor
+       (1 +- imbalance_tol) of the average, moving only as many elements as
+       needed. See ParNCMesh::Rebalance(const Array<real_t> &, real_t). */
+   void Rebalance(const Array<real_t> &elem_weights,
+                  real_t imbalance_tol = 0.0);
+
    /** Save the mesh in a parallel mesh format. If @a comments is non-empty, it
        will be printed after the first line of the file, and each line should
        begin with '#'. */
    void ParPrint(std::ostream &out, const std::string &comments = "") const;
 
+   /** Save the part of the mesh in the calling processor, including the shared
+       entities, in the MFEM binary mesh format, see Mesh::PrintBinary(). The
+       result can be read with the ParMesh stream constructor. Nonconforming
+       and NURBS meshes are not supported. */
+   void ParPrintBinary(std::ostream &out) const;
+
+   /** @brief Save the ParMesh to a single file, using MPI-IO.
+
+       The file starts with the line "MFEM binary parallel mesh v1.0", followed
+       by int64_t entries with the byte order tag, the number of MPI ranks and
+       the offsets of the parts of all ranks in the file. Each part is written
+       with ParPrintBinary(). Use LoadFromBinaryFile() to read the file. */
+   void SaveBinary(const std::string &fname) const override;
+
    // Enable Print() to add the parallel interface as boundary (typically used
    // for visualization purposes)
    void SetPrintShared(bool print) { print_shared = print; }
@@ -1884,12 +1884,6 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 void ParNCMesh::Rebalance(const Array<int> *custom_partition)
 {
-   send_rebalance_dofs.clear();
-   recv_rebalance_dofs.clear();
-
-   Array<int> old_elements;
-   leaf_elements.GetSubArray(0, NElements, old_elements);
-
    if (!custom_partition) // SFC based partitioning
    {
       Array<int> new_ranks(leaf_elements.Size());
@@ -1915,7 +1909,7 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
                             - PartitionFirstIndex(MyRank, total_elems);
 
       // assign the new ranks and send elements (plus ghosts) to new owners
-      RedistributeElements(new_ranks, target_elements, true);
+      RebalanceImpl(new_ranks, target_elements);
    }
    else // whatever partitioning the user has passed
    {
@@ -1927,9 +1921,95 @@ void ParNCMesh::Rebalance(const Array<int> *custom_partition)
       custom_partition->Copy(new_ranks);
       new_ranks.SetSize(leaf_elements.Size(), -1); // make room for ghosts
 
-      RedistributeElements(new_ranks, -1, true);
+      RebalanceImpl(new_ranks, -1);
+   }
+}
+
+void ParNCMesh::Rebalance(const Array<real_t> &elem_weights,
+                          real_t imbalance_tol)
+{
+   Array<int> new_ranks;
+   int target_elements = WeightedPartition(elem_weights, imbalance_tol,
+                                           new_ranks);
+   RebalanceImpl(new_ranks, target_elements);
+}
+
+int ParNCMesh::WeightedPartition(const Array<real_t> &elem_weights,
+                                 real_t imbalance_tol,
+                                 Array<int> &new_ranks) const
+{
+   MFEM_VERIFY(elem_weights.Size() == NElements,
+               "Size of the weight array must match the number "
+               "of local mesh elements (ParMesh::GetNE()).");
+   MFEM_VERIFY(imbalance_tol >= 0.0, "invalid imbalance tolerance");
+
+   // position of the local piece of the SFC in the global weight sequence
+   double local_weight = 0.0;
+   for (int i = 0; i < NElements; i++)
+   {
+      MFEM_VERIFY(elem_weights[i] > 0.0, "element weights must be positive");
+      local_weight += elem_weights[i];
+   }
+
+   double first_weight = 0.0, total_weight = 0.0;
+   MPI_Allreduce(&local_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   MPI_Scan(&local_weight, &first_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   first_weight -= local_weight;
+
+   // The current partition cuts the weight sequence at the positions
+   // cut[r] = first_weight of rank r. Move each cut into the interval of size
+   // imbalance_tol * avg_weight around the cut of the equal weight partition,
+   // so that the weight of each piece is within (1 +- imbalance_tol) times
+   // the average. Cuts that are already in their interval do not move, and
+   // since both the cuts and the intervals are nondecreasing, so are the new
+   // cuts.
+   std::vector<double> cut(NRanks);
+   MPI_Allgather(&first_weight, 1, MPI_DOUBLE, cut.data(), 1, MPI_DOUBLE,
+                 MyComm);
+
+   const double avg_weight = total_weight / NRanks;
+   const double slack = 0.5 * imbalance_tol * avg_weight;
+   for (int r = 1; r < NRanks; r++)
+   {
+      const double ideal = r * avg_weight;
+      cut[r] = std::min(std::max(cut[r], ideal - slack), ideal + slack);
+   }
+
+   // assign each local element to the piece containing its center
+   new_ranks.SetSize(leaf_elements.Size());
+   new_ranks = -1;
+
+   std::vector<int> count(NRanks, 0);
+   double pos = first_weight;
+   for (int i = 0; i < NElements; i++)
+   {
+      const double center = pos + 0.5*elem_weights[i];
+      pos += elem_weights[i];
+
+      int rank = int(std::upper_bound(cut.begin() + 1, cut.end(), center)
+                     - cut.begin()) - 1;
+      new_ranks[i] = rank;
+      count[rank]++;
    }
 
+   // the number of elements each rank will own after the migration
+   int target_elements = 0;
+   MPI_Reduce_scatter_block(count.data(), &target_elements, 1, MPI_INT,
+                            MPI_SUM, MyComm);
+   return target_elements;
+}
+
+void ParNCMesh::RebalanceImpl(Array<int> &new_ranks, int target_elements)
+{
+   send_rebalance_dofs.clear();
+   recv_rebalance_dofs.clear();
+
+   Array<int> old_elements;
+   leaf_elements.GetSubArray(0, NElements, old_elements);
+
+   // assign the new ranks and send elements (plus ghosts) to new owners
+   RedistributeElements(new_ranks, target_elements, true);
+
    // set up the old index array
    old_index_or_rank.SetSize(NElements);
    old_index_or_rank = -1;
@@ -2246,10 +2326,11 @@ void ParNCMesh::SendRebalanceDofs(int old_ndofs,
          msg.dofs.insert(msg.dofs.end(), dofs.begin(), dofs.end());
       }
       msg.dof_offset = old_global_offset;
-   }
 
-   // send the DOFs to element recipients from last Rebalance()
-   RebalanceDofMessage::IsendAll(send_rebalance_dofs, MyComm);
+      // send the DOFs to the element recipient from last Rebalance() right
+      // away, overlapping the communication with packing the next messages
+      msg.Isend(it->first, MyComm);
+   }
 }
 
 
@@ -112,6 +112,18 @@ public:
        passed. */
    void Rebalance(const Array<int> *custom_partition = NULL);
 
+   /** Migrate leaf elements so that the total weight of the elements owned by
+       each processor is within a factor (1 +- imbalance_tol) of the average,
+       up to the weight of one element. The array @a elem_weights contains the
+       (positive) cost of each local element, e.g., p^d for elements of order
+       p in dimension d, or a measured computation time. The partitions are
+       contiguous pieces of the global space-filling sequence of leaf
+       elements. Unlike in the default Rebalance(), the boundaries of the
+       pieces are moved only as far as needed to meet the tolerance, so a
+       small imbalance results in a small migration. With imbalance_tol = 0,
+       the space-filling sequence is split into pieces of equal weight. */
+   void Rebalance(const Array<real_t> &elem_weights, real_t imbalance_tol);
+
    // interface for ParFiniteElementSpace
    int GetNElements() const { return NElements; }
 
@@ -531,6 +543,16 @@ protected: // implementation
    void RedistributeElements(Array<int> &new_ranks, int target_elements,
                              bool record_comm);
 
+   /** Common part of the Rebalance() methods: redistribute the elements
+       according to 'new_ranks' (see RedistributeElements), set up the old
+       index array and prune the elements beyond the new ghost layer. */
+   void RebalanceImpl(Array<int> &new_ranks, int target_elements);
+
+   /** Calculate the new ranks of the local leaf elements for the weighted
+       Rebalance(). Returns the number of elements this rank will own. */
+   int WeightedPartition(const Array<real_t> &elem_weights,
+                         real_t imbalance_tol, Array<int> &new_ranks) const;
+
    /** Recorded communication pattern from last Rebalance. Used by
        Send/RecvRebalanceDofs to ship element DOFs. */
    RebalanceDofMessage::Map send_rebalance_dofs;
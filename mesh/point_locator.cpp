@@ -0,0 +1,499 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "point_locator.hpp"
+#include "../fem/fespace.hpp"
+#include "../fem/geom.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace mfem
+{
+
+PointLocator::PointLocator(Mesh &mesh_, real_t padding_, int leaf_size_)
+   : mesh(&mesh_), sdim(mesh_.SpaceDimension()), padding(padding_),
+     leaf_size(leaf_size_), mesh_sequence(-1), nodes_sequence(-1),
+     global_searches(0)
+{
+   MFEM_VERIFY(sdim <= 3, "invalid space dimension");
+   MFEM_VERIFY(padding >= 0.0 && leaf_size > 0, "invalid parameters");
+#ifdef MFEM_USE_DOUBLE
+   // the default tolerances of InverseElementTransformation are at the level
+   // of the round-off, which Newton's method may not reach in high-order
+   // elements, so that points inside would not be found
+   inv_tr.SetReferenceTol(1e-13);
+   inv_tr.SetPhysicalRelTol(1e-13);
+#endif
+}
+
+void PointLocator::ComputeElementBoxes()
+{
+   const int NE = mesh->GetNE();
+   elem_box.SetSize(2*sdim*NE);
+
+   // sample the elements on a lattice that resolves the curvature of the
+   // high-order nodes, vertices are enough for straight-sided elements
+   const FiniteElementSpace *nodal_fes = mesh->GetNodalFESpace();
+   const int order = nodal_fes ? nodal_fes->GetMaxElementOrder() : 1;
+   const int ref = (order > 1) ? 2*order : 1;
+
+   DenseMatrix pts;
+   for (int e = 0; e < NE; e++)
+   {
+      const Geometry::Type geom = mesh->GetElementBaseGeometry(e);
+      const IntegrationRule &ir = GlobGeometryRefiner.Refine(geom, ref)->RefPts;
+
+      mesh->GetElementTransformation(e, &T);
+      T.Transform(ir, pts);
+
+      real_t *box_min = &elem_box[2*sdim*e], *box_max = box_min + sdim;
+      real_t size = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         box_min[d] = box_max[d] = pts(d, 0);
+         for (int j = 1; j < pts.Width(); j++)
+         {
+            box_min[d] = std::min(box_min[d], pts(d, j));
+            box_max[d] = std::max(box_max[d], pts(d, j));
+         }
+         size = std::max(size, box_max[d] - box_min[d]);
+      }
+
+      // the padding is relative to the largest size, so that the boxes of
+      // flat elements (e.g., in surface meshes) are not degenerate
+      for (int d = 0; d < sdim; d++)
+      {
+         box_min[d] -= padding*size;
+         box_max[d] += padding*size;
+      }
+   }
+}
+
+void PointLocator::BuildNode(int node, int begin, int end)
+{
+   const Array<real_t> &center = elem_center;
+
+   // bounding box of the elements, and of their centers
+   real_t box_min[3], box_max[3], c_min[3], c_max[3];
+   for (int d = 0; d < sdim; d++)
+   {
+      box_min[d] = c_min[d] = std::numeric_limits<real_t>::max();
+      box_max[d] = c_max[d] = -std::numeric_limits<real_t>::max();
+   }
+   for (int i = begin; i < end; i++)
+   {
+      const int e = elem_order[i];
+      const real_t *e_min = &elem_box[2*sdim*e], *e_max = e_min + sdim;
+      for (int d = 0; d < sdim; d++)
+      {
+         box_min[d] = std::min(box_min[d], e_min[d]);
+         box_max[d] = std::max(box_max[d], e_max[d]);
+         c_min[d] = std::min(c_min[d], center[sdim*e + d]);
+         c_max[d] = std::max(c_max[d], center[sdim*e + d]);
+      }
+   }
+
+   // NOTE: 'bvh' may be reallocated below, no references to its items are kept
+   for (int d = 0; d < sdim; d++)
+   {
+      bvh[node].min[d] = box_min[d];
+      bvh[node].max[d] = box_max[d];
+   }
+
+   if (end - begin <= leaf_size)
+   {
+      bvh[node].first = begin;
+      bvh[node].count = end - begin;
+      return;
+   }
+
+   // split at the median of the centers along the longest axis
+   int axis = 0;
+   for (int d = 1; d < sdim; d++)
+   {
+      if (c_max[d] - c_min[d] > c_max[axis] - c_min[axis]) { axis = d; }
+   }
+
+   const int mid = (begin + end) / 2;
+   std::nth_element(elem_order.begin() + begin, elem_order.begin() + mid,
+                    elem_order.begin() + end, [&](int a, int b)
+   {
+      return center[sdim*a + axis] < center[sdim*b + axis];
+   });
+
+   const int child = bvh.Size();
+   bvh.SetSize(child + 2);
+   bvh[node].first = child;
+   bvh[node].count = 0;
+
+   BuildNode(child, begin, mid);
+   BuildNode(child + 1, mid, end);
+}
+
+void PointLocator::Setup()
+{
+   mesh_sequence = mesh->GetSequence();
+   nodes_sequence = mesh->GetNodesSequence();
+
+   const int NE = mesh->GetNE();
+   bvh.SetSize(0);
+   if (!NE) { return; }
+
+   ComputeElementBoxes();
+
+   elem_center.SetSize(sdim*NE);
+   for (int e = 0; e < NE; e++)
+   {
+      const real_t *box_min = &elem_box[2*sdim*e], *box_max = box_min + sdim;
+      for (int d = 0; d < sdim; d++)
+      {
+         elem_center[sdim*e + d] = 0.5*(box_min[d] + box_max[d]);
+      }
+   }
+
+   elem_order.SetSize(NE);
+   for (int e = 0; e < NE; e++) { elem_order[e] = e; }
+
+   bvh.Reserve(2*(NE/leaf_size + 1));
+   bvh.SetSize(1);
+   BuildNode(0, 0, NE);
+}
+
+bool PointLocator::FindInElement(int elem, const Vector &pt,
+                                 IntegrationPoint &ip)
+{
+   mesh->GetElementTransformation(elem, &T);
+   inv_tr.SetTransformation(T);
+   return inv_tr.Transform(pt, ip) == InverseElementTransformation::Inside;
+}
+
+int PointLocator::FindPoint(const Vector &pt, IntegrationPoint &ip)
+{
+   MFEM_ASSERT(pt.Size() == sdim, "invalid point");
+   CheckSetup();
+   if (!bvh.Size()) { return -1; }
+
+   // the tree is balanced, its depth is at most log2(NE) + 1
+   const int max_depth = 64;
+   int stack[max_depth], top = 0;
+   stack[top++] = 0;
+
+   const real_t *x = pt.GetData();
+   while (top)
+   {
+      const BVHNode &node = bvh[stack[--top]];
+      if (!BoxContains(node.min, node.max, x)) { continue; }
+
+      if (node.count) // leaf
+      {
+         for (int i = node.first; i < node.first + node.count; i++)
+         {
+            const int e = elem_order[i];
+            const real_t *e_min = &elem_box[2*sdim*e];
+            if (BoxContains(e_min, e_min + sdim, x) &&
+                FindInElement(e, pt, ip)) { return e; }
+         }
+      }
+      else
+      {
+         MFEM_ASSERT(top + 2 <= max_depth, "BVH too deep");
+         stack[top++] = node.first + 1;
+         stack[top++] = node.first;
+      }
+   }
+   return -1;
+}
+
+int PointLocator::FindPoints(const DenseMatrix &point_mat,
+                             Array<int> &elem_ids,
+                             Array<IntegrationPoint> &ips)
+{
+   MFEM_VERIFY(point_mat.Height() == sdim, "Invalid points matrix");
+   const int npts = point_mat.Width();
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+
+   int pts_found = 0;
+   Vector pt;
+   for (int k = 0; k < npts; k++)
+   {
+      pt.SetDataAndSize(const_cast<real_t*>(point_mat.GetColumn(k)), sdim);
+      elem_ids[k] = FindPoint(pt, ips[k]);
+      if (elem_ids[k] >= 0) { pts_found++; }
+   }
+   return pts_found;
+}
+
+int PointLocator::WalkToPoint(const Vector &pt, int elem, IntegrationPoint &ip,
+                              int max_steps)
+{
+   // start from the previous reference coordinates, which are close to the
+   // new ones if the point moved by a fraction of the element size
+   const IntegrationPoint ip_hint = ip;
+   const InverseElementTransformation::InitGuessType guess_type =
+      inv_tr.GetInitialGuessType();
+   inv_tr.SetInitialGuess(ip_hint);
+   const bool found = FindInElement(elem, pt, ip);
+   inv_tr.SetInitialGuessType(guess_type);
+   if (found) { return elem; }
+
+   // greedy walk: move to the unvisited neighbor whose center is closest to
+   // the point, the element-to-element table is cached by the mesh
+   const Table &el_to_el = mesh->ElementToElementTable();
+   const real_t *x = pt.GetData();
+   int visited[32];
+   max_steps = std::min(max_steps, 32);
+
+   int e = elem;
+   for (int step = 0; step < max_steps; step++)
+   {
+      visited[step] = e;
+
+      int next = -1;
+      real_t next_dist = std::numeric_limits<real_t>::max();
+      const int *nbr = el_to_el.GetRow(e);
+      for (int i = 0; i < el_to_el.RowSize(e); i++)
+      {
+         const int n = nbr[i];
+         if (std::find(visited, visited + step + 1, n) != visited + step + 1)
+         {
+            continue;
+         }
+         const real_t *c = &elem_center[sdim*n];
+         real_t dist = 0.0;
+         for (int d = 0; d < sdim; d++) { dist += (c[d] - x[d])*(c[d] - x[d]); }
+         if (dist < next_dist) { next = n; next_dist = dist; }
+      }
+      if (next < 0) { break; }
+
+      e = next;
+      const real_t *e_min = &elem_box[2*sdim*e];
+      if (BoxContains(e_min, e_min + sdim, x) && FindInElement(e, pt, ip))
+      {
+         return e;
+      }
+   }
+   return -1;
+}
+
+int PointLocator::TrackPoint(const Vector &pt, int elem, IntegrationPoint &ip,
+                             int max_steps)
+{
+   MFEM_ASSERT(pt.Size() == sdim, "invalid point");
+
+   // the element indices of the hints are invalid after a refinement
+   const bool use_hint = elem >= 0 &&
+                         (mesh_sequence < 0 ||
+                          mesh_sequence == mesh->GetSequence());
+   CheckSetup();
+
+   if (use_hint && elem < mesh->GetNE())
+   {
+      const int e = WalkToPoint(pt, elem, ip, max_steps);
+      if (e >= 0) { return e; }
+   }
+   global_searches++;
+   return FindPoint(pt, ip);
+}
+
+int PointLocator::TrackPoints(const DenseMatrix &point_mat,
+                              Array<int> &elem_ids,
+                              Array<IntegrationPoint> &ips, int max_steps)
+{
+   MFEM_VERIFY(point_mat.Height() == sdim, "Invalid points matrix");
+   const int npts = point_mat.Width();
+   if (elem_ids.Size() != npts || ips.Size() != npts)
+   {
+      elem_ids.SetSize(npts);
+      elem_ids = -1;
+      ips.SetSize(npts);
+   }
+
+   int pts_found = 0;
+   Vector pt;
+   for (int k = 0; k < npts; k++)
+   {
+      pt.SetDataAndSize(const_cast<real_t*>(point_mat.GetColumn(k)), sdim);
+      elem_ids[k] = TrackPoint(pt, elem_ids[k], ips[k], max_steps);
+      if (elem_ids[k] >= 0) { pts_found++; }
+   }
+   return pts_found;
+}
+
+std::size_t PointLocator::MemoryUsage() const
+{
+   return bvh.MemoryUsage() + elem_order.MemoryUsage() +
+          elem_box.MemoryUsage() + elem_center.MemoryUsage();
+}
+
+#ifdef MFEM_USE_MPI
+
+int ParPointLocator::TrackPoints(DenseMatrix &point_mat, Array<int> &elem_ids,
+                                 Array<IntegrationPoint> &ips,
+                                 Array<int> &point_ids, int max_steps)
+{
+   MFEM_VERIFY(point_ids.Size() == point_mat.Width(), "invalid point ids");
+   PointLocator::TrackPoints(point_mat, elem_ids, ips, max_steps);
+
+   const MPI_Comm comm = pmesh->GetComm();
+   const int nranks = pmesh->GetNRanks(), myrank = pmesh->GetMyRank();
+   const MPI_Datatype real_type = MPITypeMap<real_t>::mpi_type;
+   const int npts = point_mat.Width();
+
+   // gather the bounding boxes of the local meshes, an empty rank has an
+   // inverted box that contains no points
+   const int bs = 2*sdim;
+   Array<real_t> boxes(bs*nranks), my_box(bs);
+   for (int d = 0; d < sdim; d++)
+   {
+      my_box[d] = bvh.Size() ? bvh[0].min[d]
+                  : std::numeric_limits<real_t>::max();
+      my_box[sdim + d] = bvh.Size() ? bvh[0].max[d]
+                         : -std::numeric_limits<real_t>::max();
+   }
+   MPI_Allgather(my_box.GetData(), bs, real_type,
+                 boxes.GetData(), bs, real_type, comm);
+
+   // candidate ranks of the points not found locally
+   Array<int> send_cnt(nranks), send_off(nranks + 1);
+   send_cnt = 0;
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { continue; }
+      const real_t *x = point_mat.GetColumn(k);
+      for (int r = 0; r < nranks; r++)
+      {
+         const real_t *b = &boxes[bs*r];
+         if (r != myrank && BoxContains(b, b + sdim, x)) { send_cnt[r]++; }
+      }
+   }
+
+   Array<int> recv_cnt(nranks), recv_off(nranks + 1);
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+
+   send_off[0] = recv_off[0] = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      send_off[r+1] = send_off[r] + send_cnt[r];
+      recv_off[r+1] = recv_off[r] + recv_cnt[r];
+   }
+   const int nsend = send_off[nranks], nrecv = recv_off[nranks];
+
+   // pack the coordinates and the ids of the candidates, rank by rank
+   Array<int> send_pt(nsend), send_id(nsend), pos(nranks);
+   Array<real_t> send_x(sdim*nsend);
+   for (int r = 0; r < nranks; r++) { pos[r] = send_off[r]; }
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { continue; }
+      const real_t *x = point_mat.GetColumn(k);
+      for (int r = 0; r < nranks; r++)
+      {
+         const real_t *b = &boxes[bs*r];
+         if (r == myrank || !BoxContains(b, b + sdim, x)) { continue; }
+         const int i = pos[r]++;
+         send_pt[i] = k;
+         send_id[i] = point_ids[k];
+         for (int d = 0; d < sdim; d++) { send_x[sdim*i + d] = x[d]; }
+      }
+   }
+
+   Array<int> send_cnt_x(nranks), send_off_x(nranks);
+   Array<int> recv_cnt_x(nranks), recv_off_x(nranks);
+   for (int r = 0; r < nranks; r++)
+   {
+      send_cnt_x[r] = sdim*send_cnt[r], send_off_x[r] = sdim*send_off[r];
+      recv_cnt_x[r] = sdim*recv_cnt[r], recv_off_x[r] = sdim*recv_off[r];
+   }
+
+   Array<real_t> recv_x(sdim*nrecv);
+   Array<int> recv_id(nrecv);
+   MPI_Alltoallv(send_x.GetData(), send_cnt_x.GetData(), send_off_x.GetData(),
+                 real_type, recv_x.GetData(), recv_cnt_x.GetData(),
+                 recv_off_x.GetData(), real_type, comm);
+   MPI_Alltoallv(send_id.GetData(), send_cnt.GetData(), send_off.GetData(),
+                 MPI_INT, recv_id.GetData(), recv_cnt.GetData(),
+                 recv_off.GetData(), MPI_INT, comm);
+
+   // search for the received points, which have no valid hints here
+   Array<int> recv_elem(nrecv), recv_found(nrecv), send_found(nsend);
+   Array<IntegrationPoint> recv_ip(nrecv);
+   Vector pt;
+   for (int i = 0; i < nrecv; i++)
+   {
+      pt.SetDataAndSize(&recv_x[sdim*i], sdim);
+      recv_elem[i] = FindPoint(pt, recv_ip[i]);
+      recv_found[i] = (recv_elem[i] >= 0);
+   }
+   MPI_Alltoallv(recv_found.GetData(), recv_cnt.GetData(), recv_off.GetData(),
+                 MPI_INT, send_found.GetData(), send_cnt.GetData(),
+                 send_off.GetData(), MPI_INT, comm);
+
+   // each point is kept by the lowest rank that found it; since the
+   // candidates are packed rank by rank, that is the first one in send order
+   Array<int> send_keep(nsend), recv_keep(nrecv), moved(npts);
+   moved = 0;
+   for (int i = 0; i < nsend; i++)
+   {
+      const int k = send_pt[i];
+      send_keep[i] = (send_found[i] && !moved[k]);
+      if (send_keep[i]) { moved[k] = 1; }
+   }
+   MPI_Alltoallv(send_keep.GetData(), send_cnt.GetData(), send_off.GetData(),
+                 MPI_INT, recv_keep.GetData(), recv_cnt.GetData(),
+                 recv_off.GetData(), MPI_INT, comm);
+
+   // new local points: the points found locally, the received points, and
+   // the points not found anywhere
+   int nkeep = 0, nlost = 0;
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] >= 0) { nkeep++; }
+      else if (!moved[k]) { nlost++; }
+   }
+   for (int i = 0; i < nrecv; i++) { nkeep += recv_keep[i]; }
+
+   DenseMatrix new_mat(sdim, nkeep + nlost);
+   Array<int> new_elem(nkeep + nlost), new_id(nkeep + nlost);
+   Array<IntegrationPoint> new_ip(nkeep + nlost);
+   int j = 0, l = nkeep;
+   for (int k = 0; k < npts; k++)
+   {
+      if (elem_ids[k] < 0 && moved[k]) { continue; }
+      const int i = (elem_ids[k] >= 0) ? j++ : l++;
+      for (int d = 0; d < sdim; d++) { new_mat(d, i) = point_mat(d, k); }
+      new_elem[i] = elem_ids[k];
+      new_ip[i] = ips[k];
+      new_id[i] = point_ids[k];
+   }
+   for (int i = 0; i < nrecv; i++)
+   {
+      if (!recv_keep[i]) { continue; }
+      for (int d = 0; d < sdim; d++) { new_mat(d, j) = recv_x[sdim*i + d]; }
+      new_elem[j] = recv_elem[i];
+      new_ip[j] = recv_ip[i];
+      new_id[j] = recv_id[i];
+      j++;
+   }
+   MFEM_ASSERT(j == nkeep && l == nkeep + nlost, "internal error");
+
+   point_mat.Swap(new_mat);
+   Swap(elem_ids, new_elem);
+   Swap(ips, new_ip);
+   Swap(point_ids, new_id);
+   return nkeep;
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem
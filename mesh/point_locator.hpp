@@ -0,0 +1,217 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_POINT_LOCATOR
+#define MFEM_POINT_LOCATOR
+
+#include "../config/config.hpp"
+#include "../fem/eltrans.hpp"
+#include "mesh.hpp"
+#ifdef MFEM_USE_MPI
+#include "pmesh.hpp"
+#endif
+
+namespace mfem
+{
+
+/** @brief Point location in a (possibly high-order) Mesh using a bounding
+    volume hierarchy (BVH) of the element bounding boxes.
+
+    The bounding box of each element is computed from the images of a lattice
+    of reference points, whose resolution increases with the order of the
+    mesh nodes, and is enlarged by a relative padding to account for the
+    curvature of the element between the lattice points. The boxes are
+    organized in a binary tree, built by recursively splitting the elements
+    at the median of their centers along the longest axis. A point is located
+    by visiting the tree nodes whose boxes contain it, and inverting the
+    transformations of the candidate elements with an
+    InverseElementTransformation, which can be configured with
+    GetInverseTransformation().
+
+    The hierarchy is built on the first query and reused by the following
+    ones. It is rebuilt automatically when the mesh is refined or its nodes
+    are updated, as indicated by Mesh::GetSequence() and
+    Mesh::GetNodesSequence(). If the nodes are changed directly, without
+    calling Mesh::NodesUpdated(), call Setup() to rebuild the hierarchy.
+
+    Unlike Mesh::FindPoints(), the cost of a query does not depend on the
+    number of elements (for meshes of elements of similar sizes), which makes
+    the class suitable for large numbers of queries, e.g., for particle
+    tracking or probe sampling. In parallel, the search is local: points
+    outside of the local part of the mesh are not found, see ParPointLocator.
+
+    Points that move by small distances between queries, e.g., Lagrangian
+    particles, can be tracked with TrackPoints(), which starts the search from
+    the element found previously and walks to the neighboring elements,
+    falling back to the global search only when the walk fails. */
+class PointLocator
+{
+protected:
+   /// Node of the BVH, stored in a flat array.
+   struct BVHNode
+   {
+      real_t min[3], max[3]; ///< bounding box of the subtree
+      /** First element (index in 'elem_order') of a leaf, or the index of
+          the first child of an inner node, the second child follows it. */
+      int first;
+      int count; ///< number of elements of a leaf, 0 for an inner node
+   };
+
+   Mesh *mesh;
+   int sdim;
+   real_t padding;
+   int leaf_size;
+
+   long mesh_sequence, nodes_sequence;
+
+   Array<BVHNode> bvh;
+   Array<int> elem_order;
+   Array<real_t> elem_box; ///< min and max corners of the element boxes
+   Array<real_t> elem_center; ///< centers of the element boxes
+
+   long global_searches; ///< number of tracked points found by FindPoint()
+
+   IsoparametricTransformation T;
+   InverseElementTransformation inv_tr;
+
+   /// Calculate the padded bounding boxes of all elements in 'elem_box'.
+   void ComputeElementBoxes();
+
+   /// Build the subtree of 'node' for the elements elem_order[begin:end].
+   void BuildNode(int node, int begin, int end);
+
+   /// Return true if the box [@a box_min, @a box_max] contains @a pt.
+   bool BoxContains(const real_t *box_min, const real_t *box_max,
+                    const real_t *pt) const
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         if (pt[d] < box_min[d] || pt[d] > box_max[d]) { return false; }
+      }
+      return true;
+   }
+
+   /// Try to find the point @a pt in element @a elem.
+   bool FindInElement(int elem, const Vector &pt, IntegrationPoint &ip);
+
+   /** @brief Walk from the element @a elem, where the point had the reference
+       coordinates @a ip, towards the point @a pt through the face neighbors,
+       visiting at most @a max_steps elements. Returns the element containing
+       the point, or -1. */
+   int WalkToPoint(const Vector &pt, int elem, IntegrationPoint &ip,
+                   int max_steps);
+
+   /// Build the hierarchy if it does not exist or the mesh has changed.
+   void CheckSetup()
+   {
+      if (mesh_sequence != mesh->GetSequence() ||
+          nodes_sequence != mesh->GetNodesSequence()) { Setup(); }
+   }
+
+public:
+   /** @brief Create a locator for @a mesh_. The element bounding boxes are
+       enlarged by @a padding_ times their size in each direction, and the
+       leaves of the hierarchy contain up to @a leaf_size_ elements. */
+   PointLocator(Mesh &mesh_, real_t padding_ = 0.05, int leaf_size_ = 4);
+
+   /// Build the hierarchy for the current element positions.
+   void Setup();
+
+   /** @brief Find the element containing the point @a pt and the reference
+       coordinates of the point in @a ip. Returns the element index, or -1
+       if the point is not found. */
+   int FindPoint(const Vector &pt, IntegrationPoint &ip);
+
+   /** @brief Find the points given by the columns of @a point_mat, see
+       Mesh::FindPoints(). Returns the number of points found; the element of
+       a point that is not found is -1. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips);
+
+   /** @brief Find the point @a pt, starting the search from the element
+       @a elem where the point was located previously, with the reference
+       coordinates @a ip. The neighbors of @a elem are searched, for up to
+       @a max_steps elements, before falling back to FindPoint(). On return,
+       @a ip contains the new reference coordinates.
+
+       The hint is ignored if @a elem is negative or if the mesh has been
+       refined or derefined since the last query, as the element indices are
+       not valid anymore. Returns the element index, or -1 if the point is not
+       found. */
+   int TrackPoint(const Vector &pt, int elem, IntegrationPoint &ip,
+                  int max_steps = 8);
+
+   /** @brief Track the points given by the columns of @a point_mat, see
+       TrackPoint(). On input, @a elem_ids and @a ips contain the elements
+       and reference coordinates of the points found by a previous call to
+       FindPoints() or TrackPoints() (or are empty, if there are no hints), and
+       on output, their new values. Returns the number of points found. */
+   int TrackPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                   Array<IntegrationPoint> &ips, int max_steps = 8);
+
+   /// Return the number of tracked points that were not found by walking
+   /// from their hints, and required a global search.
+   long GetNumGlobalSearches() const { return global_searches; }
+
+   /// Return the inverse transformation used to find the reference
+   /// coordinates, which can be used to set its options.
+   InverseElementTransformation &GetInverseTransformation() { return inv_tr; }
+
+   /// Return the number of nodes of the hierarchy.
+   int GetNumNodes() const { return bvh.Size(); }
+
+   std::size_t MemoryUsage() const;
+
+   virtual ~PointLocator() { }
+};
+
+#ifdef MFEM_USE_MPI
+
+/** @brief Point tracking in a ParMesh, where the points that leave the local
+    part of the mesh are sent to the ranks that contain them.
+
+    The redistribution is batched: the points that are not found locally are
+    sent to the ranks whose local bounding boxes contain them, with a single
+    exchange for all points, and each point is kept by the lowest rank that
+    finds it. */
+class ParPointLocator : public PointLocator
+{
+protected:
+   ParMesh *pmesh;
+
+public:
+   ParPointLocator(ParMesh &pmesh_, real_t padding_ = 0.05,
+                   int leaf_size_ = 4)
+      : PointLocator(pmesh_, padding_, leaf_size_), pmesh(&pmesh_) { }
+
+   using PointLocator::TrackPoints;
+
+   /** @brief Track the local points given by the columns of @a point_mat,
+       moving the points that left the local part of the mesh to the ranks
+       that contain them. This is a collective operation.
+
+       On input, @a elem_ids and @a ips contain the hints, see
+       PointLocator::TrackPoints(), and @a point_ids contains user defined
+       identifiers of the points. On output, all four arrays contain the
+       points that are now owned by this rank: the points found locally or
+       received from other ranks, followed by the local points that were not
+       found by any rank, which have an element index of -1. Returns the
+       number of local points found. */
+   int TrackPoints(DenseMatrix &point_mat, Array<int> &elem_ids,
+                   Array<IntegrationPoint> &ips, Array<int> &point_ids,
+                   int max_steps = 8);
+};
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem
+
+#endif
@@ -33,6 +33,7 @@
 //
 // Sample runs:  lor-transfer
 //               lor-transfer -h1
+//               lor-transfer -h1 -pa -o 4 -lref 5
 //               lor-transfer -t
 //               lor-transfer -m ../../data/star-q2.mesh -lref 5 -p 4
 //               lor-transfer -m ../../data/star-mixed.mesh -lref 3 -p 2
@@ -78,6 +79,7 @@ int main(int argc, char *argv[])
    bool use_pointwise_transfer = false;
    const char *device_config = "cpu";
    bool use_ea       = false;
+   bool use_pa       = false;
 
    OptionsParser args(argc, argv);
    args.AddOption(&mesh_file, "-m", "--mesh",
@@ -102,6 +104,9 @@ int main(int argc, char *argv[])
                   "Device configuration string, see Device::Configure().");
    args.AddOption(&use_ea, "-ea", "--ea-version", "-no-ea",
                   "--no-ea-version", "Use element assembly version.");
+   args.AddOption(&use_pa, "-pa", "--pa-version", "-no-pa",
+                  "--no-pa-version",
+                  "Use partial assembly (sum-factorized) version.");
    args.ParseCheck();
 
    // Configure device
@@ -180,6 +185,7 @@ int main(int argc, char *argv[])
 
    // Configure element assembly for device acceleration
    gt->UseEA(use_ea);
+   gt->UsePA(use_pa);
 
    const Operator &R = gt->ForwardOperator();
 
@@ -0,0 +1,159 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+#include <random>
+
+using namespace mfem;
+
+// Default macro to register the tests, the argument is the number of points
+#define MFEM_KDTREE_BENCHMARK(x) BENCHMARK(x)->RangeMultiplier(8)->\
+   Range(1<<12, 1<<21)->Unit(benchmark::kMillisecond);
+
+// Uniformly distributed random points in the unit cube
+static std::vector<real_t> RandomPoints(size_t npts, unsigned seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<real_t> dist(0.0, 1.0);
+   std::vector<real_t> xx(3*npts);
+   for (auto &x : xx) { x = dist(gen); }
+   return xx;
+}
+
+static void BuildTree(const std::vector<real_t> &xx, KDTree3D &kdt)
+{
+   const size_t npts = xx.size()/3;
+   for (size_t i = 0; i < npts; i++) { kdt.AddPoint(&xx[3*i], int(i)); }
+   kdt.Sort();
+}
+
+static void KDTree_Sort(benchmark::State &state)
+{
+   const size_t npts = state.range(0);
+   const std::vector<real_t> xx = RandomPoints(npts, 1);
+   KDTree3D kdt;
+   for (auto _ : state)
+   {
+      state.PauseTiming();
+      kdt.clear();
+      for (size_t i = 0; i < npts; i++) { kdt.AddPoint(&xx[3*i], int(i)); }
+      state.ResumeTiming();
+      kdt.Sort();
+   }
+   state.SetItemsProcessed(state.iterations()*npts);
+}
+MFEM_KDTREE_BENCHMARK(KDTree_Sort);
+
+// One query at a time, in random order
+static void KDTree_FindClosestPoint(benchmark::State &state)
+{
+   const size_t npts = state.range(0);
+   KDTree3D kdt;
+   BuildTree(RandomPoints(npts, 1), kdt);
+   const std::vector<real_t> qq = RandomPoints(npts, 2);
+   for (auto _ : state)
+   {
+      for (size_t i = 0; i < npts; i++)
+      {
+         int ind;
+         real_t dist;
+         kdt.FindClosestPoint(KDTree3D::PointND(&qq[3*i]), ind, dist);
+         benchmark::DoNotOptimize(ind);
+      }
+   }
+   state.SetItemsProcessed(state.iterations()*npts);
+}
+MFEM_KDTREE_BENCHMARK(KDTree_FindClosestPoint);
+
+// Batched queries, in random order
+static void KDTree_FindClosestPoints(benchmark::State &state)
+{
+   const size_t npts = state.range(0);
+   KDTree3D kdt;
+   BuildTree(RandomPoints(npts, 1), kdt);
+   const std::vector<real_t> qq = RandomPoints(npts, 2);
+   std::vector<int> ind(npts);
+   std::vector<real_t> dist(npts);
+   for (auto _ : state)
+   {
+      kdt.FindClosestPoints(qq.data(), npts, ind.data(), dist.data());
+   }
+   state.SetItemsProcessed(state.iterations()*npts);
+}
+MFEM_KDTREE_BENCHMARK(KDTree_FindClosestPoints);
+
+// Batched queries, without sorting the query points
+static void KDTree_FindClosestPoints_Unsorted(benchmark::State &state)
+{
+   const size_t npts = state.range(0);
+   KDTree3D kdt;
+   BuildTree(RandomPoints(npts, 1), kdt);
+   kdt.SetSortQueries(false);
+   const std::vector<real_t> qq = RandomPoints(npts, 2);
+   std::vector<int> ind(npts);
+   std::vector<real_t> dist(npts);
+   for (auto _ : state)
+   {
+      kdt.FindClosestPoints(qq.data(), npts, ind.data(), dist.data());
+   }
+   state.SetItemsProcessed(state.iterations()*npts);
+}
+MFEM_KDTREE_BENCHMARK(KDTree_FindClosestPoints_Unsorted);
+
+static void KDTree_FindKNearestPoints(benchmark::State &state)
+{
+   const size_t npts = state.range(0), k = 8;
+   KDTree3D kdt;
+   BuildTree(RandomPoints(npts, 1), kdt);
+   const std::vector<real_t> qq = RandomPoints(npts, 2);
+   std::vector<int> ind(k*npts);
+   std::vector<real_t> dist(k*npts);
+   for (auto _ : state)
+   {
+      kdt.FindKNearestPoints(qq.data(), npts, k, ind.data(), dist.data());
+   }
+   state.SetItemsProcessed(state.iterations()*npts);
+}
+MFEM_KDTREE_BENCHMARK(KDTree_FindKNearestPoints);
+
+static void KDTree_FindNeighborPoints(benchmark::State &state)
+{
+   const size_t npts = state.range(0);
+   KDTree3D kdt;
+   BuildTree(RandomPoints(npts, 1), kdt);
+   const std::vector<real_t> qq = RandomPoints(npts, 2);
+   // about 8 neighbors per point
+   const real_t R = std::cbrt(6.0/(M_PI*npts));
+   std::vector<size_t> offsets;
+   std::vector<int> nbrs;
+   for (auto _ : state)
+   {
+      kdt.FindNeighborPoints(qq.data(), npts, R, offsets, nbrs);
+   }
+   state.SetItemsProcessed(state.iterations()*npts);
+}
+MFEM_KDTREE_BENCHMARK(KDTree_FindNeighborPoints);
+
+// --benchmark_filter=all
+// --benchmark_filter=KDTree_FindClosestPoints
+int main(int argc, char *argv[])
+{
+   mfem::Reporter mfem_reporter;
+   ::benchmark::Initialize(&argc, argv);
+   if (::benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   ::benchmark::RunSpecifiedBenchmarks(&mfem_reporter);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
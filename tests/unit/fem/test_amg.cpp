@@ -0,0 +1,140 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace amg
+{
+
+// Solve the given system with PCG preconditioned by AMG, returning the number
+// of iterations.
+int SolveAMG(SparseMatrix &A, const Vector &B, Vector &X,
+             SmoothedAggregationAMG &amg)
+{
+   amg.SetOperator(A);
+   CGSolver cg;
+   cg.SetRelTol(1e-8);
+   cg.SetMaxIter(200);
+   cg.SetOperator(A);
+   cg.SetPreconditioner(amg);
+   X = 0.0;
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+
+   Vector res(B.Size());
+   A.Mult(X, res);
+   res -= B;
+   REQUIRE(res.Norml2() <= 1e-6*B.Norml2());
+   return cg.GetNumIterations();
+}
+
+}
+
+TEST_CASE("SmoothedAggregationAMG Diffusion", "[AMG]")
+{
+   const int dim = GENERATE(2, 3);
+   const int order = GENERATE(1, 2);
+   CAPTURE(dim, order);
+
+   int its[2];
+   for (int r = 0; r < 2; r++)
+   {
+      const int ne = (dim == 2 ? 16 : 6) << r;
+      Mesh mesh = (dim == 2) ?
+                  Mesh::MakeCartesian2D(ne, ne, Element::QUADRILATERAL) :
+                  Mesh::MakeCartesian3D(ne, ne, ne, Element::HEXAHEDRON);
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      Array<int> ess_tdof_list;
+      fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      LinearForm b(&fes);
+      ConstantCoefficient one(1.0);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+      GridFunction x(&fes);
+      x = 0.0;
+
+      SparseMatrix A;
+      Vector B, X;
+      a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+      SmoothedAggregationAMG amg;
+      amg.SetMaxCoarseSize(50);
+      its[r] = amg::SolveAMG(A, B, X, amg);
+      REQUIRE(amg.NumLevels() > 1);
+      REQUIRE(amg.GetOperatorComplexity() < 2.0);
+   }
+   CAPTURE(its[0], its[1]);
+   // Iteration counts should be (roughly) independent of the mesh size
+   REQUIRE(its[0] <= 25);
+   REQUIRE(its[1] <= its[0] + 6);
+}
+
+TEST_CASE("SmoothedAggregationAMG Elasticity", "[AMG]")
+{
+   const int dim = GENERATE(2, 3);
+   const auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+   CAPTURE(dim, ordering);
+
+   const int ne = (dim == 2) ? 16 : 5;
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(2*ne, ne, Element::QUADRILATERAL, false,
+                                     2.0, 1.0) :
+               Mesh::MakeCartesian3D(2*ne, ne, ne, Element::HEXAHEDRON,
+                                     2.0, 1.0, 1.0);
+   H1_FECollection fec(1, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim, ordering);
+
+   // Clamp the boundary x = 0
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[dim == 2 ? 3 : 4] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   ConstantCoefficient lambda(1.0), mu(1.0);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.Assemble();
+   LinearForm b(&fes);
+   Vector f(dim);
+   f = 0.0;
+   f(dim-1) = -1.0;
+   VectorConstantCoefficient force(f);
+   b.AddDomainIntegrator(new VectorDomainLFIntegrator(force));
+   b.Assemble();
+   GridFunction x(&fes);
+   x = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   SmoothedAggregationAMG amg_rbm;
+   amg_rbm.SetElasticityOptions(&fes);
+   amg_rbm.SetMaxCoarseSize(100);
+   const int its_rbm = amg::SolveAMG(A, B, X, amg_rbm);
+
+   SmoothedAggregationAMG amg_sys;
+   amg_sys.SetSystemsOptions(dim, ordering == Ordering::byNODES);
+   amg_sys.SetMaxCoarseSize(100);
+   const int its_sys = amg::SolveAMG(A, B, X, amg_sys);
+
+   CAPTURE(its_rbm, its_sys);
+   REQUIRE(amg_rbm.NumLevels() > 1);
+   REQUIRE(its_rbm < its_sys);
+}
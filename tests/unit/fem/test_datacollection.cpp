@@ -232,6 +232,136 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
          REQUIRE(rmdir("base_00005") == 0);
       }
 #endif
+
+      SECTION("Binary MFEM format")
+      {
+         // Values which are not exactly representable in ASCII format
+         for (int i = 0; i < N; ++i) { (*u)(i) = std::sin(0.1*i); }
+         for (int i = 0; i < Nq; ++i) { (*qs)(i) = std::exp(0.1*i); }
+
+#ifdef MFEM_USE_ZLIB
+         const bool compression = GENERATE(false, true);
+#else
+         const bool compression = false;
+#endif
+         VisItDataCollection dc("base", &mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterField("v", v);
+         dc.RegisterQField("qs",qs);
+         dc.RegisterQField("qv",qv);
+         dc.SetCycle(5);
+         dc.SetTime(8.0);
+         dc.SetPadDigitsCycle(5);
+         dc.SetPadDigitsRank(5);
+         dc.SetFormat(DataCollection::BINARY_FORMAT);
+         dc.SetCompression(compression);
+         dc.Save();
+         REQUIRE(dc.Error() == DataCollection::No_Error);
+
+         VisItDataCollection dc_new("base");
+         dc_new.SetPadDigitsCycle(5);
+         dc_new.SetPadDigitsRank(5);
+         dc_new.Load(dc.GetCycle());
+         REQUIRE(dc_new.Error() == DataCollection::No_Error);
+         Mesh *mesh_new = dc_new.GetMesh();
+         GridFunction *u_new = dc_new.GetField("u");
+         GridFunction *v_new = dc_new.GetField("v");
+         QuadratureFunction *qs_new = dc_new.GetQField("qs");
+         QuadratureFunction *qv_new = dc_new.GetQField("qv");
+         REQUIRE(mesh_new);
+         REQUIRE(u_new);
+         REQUIRE(v_new);
+         REQUIRE(qs_new);
+         REQUIRE(qv_new);
+         REQUIRE(dc_new.GetTime() == 8.0);
+         REQUIRE(mesh_new->GetNE() == mesh.GetNE());
+
+         // The binary format is exact
+         Vector vert, vert_diff;
+         mesh.GetVertices(vert);
+         mesh_new->GetVertices(vert_diff);
+         vert_diff -= vert;
+         REQUIRE(vert_diff.Normlinf() == 0.0);
+
+         Vector u_diff(*u_new), v_diff(*v_new);
+         u_diff -= *u;
+         v_diff -= *v;
+         REQUIRE(u_diff.Normlinf() == 0.0);
+         REQUIRE(v_diff.Normlinf() == 0.0);
+         REQUIRE(u_new->FESpace()->GetVSize() == u->FESpace()->GetVSize());
+
+         Vector qs_diff(*qs_new), qv_diff(*qv_new);
+         qs_diff -= *qs;
+         qv_diff -= *qv;
+         REQUIRE(qs_diff.Normlinf() == 0.0);
+         REQUIRE(qv_diff.Normlinf() == 0.0);
+         REQUIRE(qv_new->GetVDim() == 2);
+
+         // Cleanup all the files
+         REQUIRE(remove("base_00005.mfem_root") == 0);
+         REQUIRE(remove("base_00005/mesh.00000") == 0);
+         REQUIRE(remove("base_00005/u.00000") == 0);
+         REQUIRE(remove("base_00005/v.00000") == 0);
+         REQUIRE(remove("base_00005/qs.00000") == 0);
+         REQUIRE(remove("base_00005/qv.00000") == 0);
+         REQUIRE(rmdir("base_00005") == 0);
+      }
+
+      SECTION("Asynchronous save")
+      {
+         const int fmt = GENERATE(DataCollection::SERIAL_FORMAT,
+                                  DataCollection::BINARY_FORMAT);
+         VisItDataCollection dc("base", &mesh);
+         dc.RegisterField("u", u);
+         dc.RegisterQField("qv",qv);
+         dc.SetPadDigitsCycle(5);
+         dc.SetPadDigitsRank(5);
+         dc.SetPrecision(16);
+         dc.SetFormat(fmt);
+         dc.SetAsyncSave(true);
+         REQUIRE(dc.GetAsyncSave());
+
+         // Save two cycles, modifying the data while the saves are in progress
+         Vector u_saved[2], qv_saved[2];
+         for (int c = 0; c < 2; c++)
+         {
+            dc.SetCycle(c);
+            dc.Save();
+            u_saved[c] = *u;
+            qv_saved[c] = *qv;
+            *u += 1.0;
+            *qv *= 2.0;
+         }
+         dc.WaitSave();
+         REQUIRE(dc.Error() == DataCollection::No_Error);
+
+         for (int c = 0; c < 2; c++)
+         {
+            VisItDataCollection dc_new("base");
+            dc_new.SetPadDigitsCycle(5);
+            dc_new.SetPadDigitsRank(5);
+            dc_new.Load(c);
+            REQUIRE(dc_new.Error() == DataCollection::No_Error);
+            REQUIRE(dc_new.GetMesh()->GetNE() == mesh.GetNE());
+            GridFunction *u_new = dc_new.GetField("u");
+            QuadratureFunction *qv_new = dc_new.GetQField("qv");
+            REQUIRE(u_new);
+            REQUIRE(qv_new);
+            *u_new -= u_saved[c];
+            *qv_new -= qv_saved[c];
+            REQUIRE(u_new->Normlinf() == MFEM_Approx(0.0));
+            REQUIRE(qv_new->Normlinf() == MFEM_Approx(0.0));
+
+            // Cleanup all the files
+            const std::string dir = (c == 0) ? "base_00000" : "base_00001";
+            REQUIRE(remove((dir + ".mfem_root").c_str()) == 0);
+            REQUIRE(remove((dir + "/mesh.00000").c_str()) == 0);
+            REQUIRE(remove((dir + "/u.00000").c_str()) == 0);
+            REQUIRE(remove((dir + "/qv.00000").c_str()) == 0);
+            REQUIRE(rmdir(dir.c_str()) == 0);
+         }
+      }
+
       delete fec;
       delete fespace;
       delete u;
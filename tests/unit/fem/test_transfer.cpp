@@ -425,6 +425,66 @@ TEST_CASE("Variable Order True Transfer", "[Transfer][VariableOrder]")
    delete c_fec;
 }
 
+TEST_CASE("L2 Projection PA Transfer", "[Transfer][PartialAssembly]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const int order = GENERATE(1, 3);
+   const int lorder = GENERATE(1, 2);
+   const int lref = (dim == 2) ? order + 2 : order + 1;
+   CAPTURE(dim, simplex, order, lorder, lref);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(2, 2, simplex ? Element::TRIANGLE :
+                                     Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 1, simplex ? Element::TETRAHEDRON :
+                                     Element::HEXAHEDRON);
+   // non-affine elements
+   mesh.Transform([](const Vector &x, Vector &y)
+   {
+      y = x;
+      y(0) += 0.1*x(0)*x(1);
+      y(1) += 0.05*sin(M_PI*x(0));
+   });
+   Mesh mesh_lor = Mesh::MakeRefined(mesh, lref, BasisType::GaussLobatto);
+
+   H1_FECollection fec_ho(order, dim), fec_lor(lorder, dim);
+   FiniteElementSpace fes_ho(&mesh, &fec_ho);
+   FiniteElementSpace fes_lor(&mesh_lor, &fec_lor);
+
+   L2ProjectionGridTransfer gt(fes_ho, fes_lor);
+   L2ProjectionGridTransfer gt_pa(fes_ho, fes_lor);
+   gt_pa.UsePA(true);
+
+   const Operator &R = gt.ForwardOperator();
+   const Operator &R_pa = gt_pa.ForwardOperator();
+
+   Vector x_ho(fes_ho.GetVSize()), x_lor(fes_lor.GetVSize());
+   x_ho.Randomize(1);
+   x_lor.Randomize(2);
+
+   Vector y_lor(fes_lor.GetVSize()), y_lor_pa(fes_lor.GetVSize());
+   R.Mult(x_ho, y_lor);
+   R_pa.Mult(x_ho, y_lor_pa);
+   y_lor_pa -= y_lor;
+   REQUIRE(y_lor_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+
+   Vector y_ho(fes_ho.GetVSize()), y_ho_pa(fes_ho.GetVSize());
+   R.MultTranspose(x_lor, y_ho);
+   R_pa.MultTranspose(x_lor, y_ho_pa);
+   y_ho_pa -= y_ho;
+   REQUIRE(y_ho_pa.Normlinf() == MFEM_Approx(0.0, 1e-10));
+
+   if (gt.SupportsBackwardsOperator())
+   {
+      REQUIRE(gt_pa.SupportsBackwardsOperator());
+      gt.BackwardOperator().Mult(x_lor, y_ho);
+      gt_pa.BackwardOperator().Mult(x_lor, y_ho_pa);
+      y_ho_pa -= y_ho;
+      REQUIRE(y_ho_pa.Normlinf() == MFEM_Approx(0.0, 1e-8));
+   }
+}
+
 TEST_CASE("Restriction Transpose Operator")
 {
    int order = GENERATE(1, 2);
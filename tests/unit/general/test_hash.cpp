@@ -0,0 +1,134 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+#include <map>
+
+using namespace mfem;
+
+namespace
+{
+
+struct Item2 : public Hashed2 { int value; };
+struct Item4 : public Hashed4 { int value; };
+
+}
+
+TEST_CASE("HashTable insert, find, delete and reparent", "[HashTable]")
+{
+   // small initial size, to exercise rehashing
+   HashTable<Item2> table(64, 8);
+   std::map<std::pair<int, int>, int> ref;
+
+   // pseudo-random sequence of operations on keys from a small range, so that
+   // the same keys are found, deleted and inserted again many times
+   unsigned r = 12345;
+   auto rand = [&r](int n)
+   {
+      r = 1103515245u*r + 12345u;
+      return int((r >> 8) % n);
+   };
+
+   for (int it = 0; it < 50000; it++)
+   {
+      const int p1 = rand(200), p2 = rand(200), op = rand(4);
+      const std::pair<int, int> key(std::min(p1, p2), std::max(p1, p2));
+      auto found = ref.find(key);
+
+      if (op < 2)
+      {
+         const int id = table.GetId(p1, p2);
+         if (found != ref.end()) { REQUIRE(id == found->second); }
+         else { ref[key] = id; table[id].value = 7*id; }
+      }
+      else if (op == 2)
+      {
+         const int id = table.FindId(p2, p1);
+         REQUIRE(id == (found != ref.end() ? found->second : -1));
+         if (id >= 0)
+         {
+            table.Delete(id);
+            REQUIRE(!table.IdExists(id));
+            ref.erase(found);
+         }
+      }
+      else if (found != ref.end())
+      {
+         const int q1 = rand(200), q2 = rand(200);
+         const std::pair<int, int> new_key(std::min(q1, q2), std::max(q1, q2));
+         if (!ref.count(new_key))
+         {
+            const int id = found->second;
+            table.Reparent(id, q1, q2);
+            ref.erase(found);
+            ref[new_key] = id;
+            REQUIRE(table.FindId(q2, q1) == id);
+         }
+      }
+   }
+
+   REQUIRE(table.Size() == (int) ref.size());
+
+   int count = 0;
+   for (auto it = table.cbegin(); it != table.cend(); ++it, count++)
+   {
+      REQUIRE(ref.at(std::make_pair(it->p1, it->p2)) == it.index());
+      REQUIRE(it->value == 7*it.index());
+   }
+   REQUIRE(count == (int) ref.size());
+
+   HashTable<Item2> copy(table);
+   for (const auto &kv : ref)
+   {
+      REQUIRE(copy.FindId(kv.first.second, kv.first.first) == kv.second);
+      REQUIRE(copy.Find(kv.first.first, kv.first.second)->value
+              == 7*kv.second);
+   }
+   REQUIRE(copy.FindId(-5, 1000) == -1);
+
+   table.DeleteAll();
+   REQUIRE(table.Size() == 0);
+   REQUIRE(table.FindId(ref.begin()->first.first,
+                        ref.begin()->first.second) == -1);
+}
+
+TEST_CASE("HashTable with four keys", "[HashTable]")
+{
+   HashTable<Item4> table(64, 8);
+
+   // all triangles of a small set of nodes
+   const int n = 12;
+   Array<int> ids;
+   for (int a = 0; a < n; a++)
+      for (int b = a+1; b < n; b++)
+         for (int c = b+1; c < n; c++)
+         {
+            ids.Append(table.GetId(c, a, b));
+         }
+   REQUIRE(table.Size() == ids.Size());
+
+   int k = 0;
+   for (int a = 0; a < n; a++)
+      for (int b = a+1; b < n; b++)
+         for (int c = b+1; c < n; c++, k++)
+         {
+            REQUIRE(table.FindId(a, b, c) == ids[k]);
+            // p4 is not hashed, the three smallest keys identify a face
+            REQUIRE(table.FindId(b, n, c, a) == ids[k]);
+         }
+
+   for (int i = 0; i < ids.Size(); i += 2) { table.Delete(ids[i]); }
+   REQUIRE(table.Size() == ids.Size() - (ids.Size()+1)/2);
+   REQUIRE(table.FindId(0, 1, 2) == -1);
+   REQUIRE(table.FindId(3, 0, 1, 2*n) == ids[1]);
+}
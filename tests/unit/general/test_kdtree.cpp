@@ -0,0 +1,99 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+#include <algorithm>
+
+using namespace mfem;
+
+TEST_CASE("KDTree queries", "[KDTree]")
+{
+   // include point clouds smaller than the leaves of the tree, and large
+   // enough for the batched queries to be sorted
+   const int npts = GENERATE(5, 100, 70000);
+   CAPTURE(npts);
+
+   std::vector<real_t> coords(3*npts);
+   for (auto &x : coords) { x = rand() / real_t(RAND_MAX); }
+
+   KDTree3D kdt;
+   for (int i = 0; i < npts; i++) { kdt.AddPoint(&coords[3*i], i); }
+   kdt.Sort();
+   REQUIRE(kdt.size() == size_t(npts));
+
+   const int nq = 200;
+   std::vector<real_t> queries(3*nq);
+   for (auto &x : queries) { x = 1.2*rand() / real_t(RAND_MAX) - 0.1; }
+
+   const size_t k = 4;
+   const real_t R = 0.15;
+   std::vector<int> ind(nq), knn_ind(k*nq);
+   std::vector<real_t> dist(nq), knn_dist(k*nq);
+   std::vector<size_t> offsets;
+   std::vector<int> nbrs;
+   kdt.FindClosestPoints(queries.data(), nq, ind.data(), dist.data());
+   if (size_t(npts) >= k)
+   {
+      kdt.FindKNearestPoints(queries.data(), nq, k, knn_ind.data(),
+                             knn_dist.data());
+   }
+   kdt.FindNeighborPoints(queries.data(), nq, R, offsets, nbrs);
+   REQUIRE(offsets.size() == size_t(nq + 1));
+
+   for (int q = 0; q < nq; q++)
+   {
+      KDTree3D::PointND pt(&queries[3*q]);
+
+      // closest point, compared to the brute force search
+      int ref_ind;
+      real_t ref_dist;
+      kdt.FindClosestPointSlow(pt, ref_ind, ref_dist);
+      REQUIRE(dist[q] == MFEM_Approx(ref_dist));
+      REQUIRE(kdt.FindClosestPoint(pt) == ind[q]);
+
+      // all distances, sorted
+      std::vector<int> all_ind;
+      std::vector<real_t> all_dist;
+      kdt.FindNeighborPointsSlow(pt, 10.0, all_ind, all_dist);
+      REQUIRE(all_ind.size() == size_t(npts));
+      std::sort(all_dist.begin(), all_dist.end());
+
+      // k nearest points
+      std::vector<int> kind;
+      std::vector<real_t> kdist;
+      kdt.FindKNearestPoints(pt, k, kind, kdist);
+      REQUIRE(kind.size() == std::min(k, size_t(npts)));
+      for (size_t j = 0; j < kind.size(); j++)
+      {
+         REQUIRE(kdist[j] == MFEM_Approx(all_dist[j]));
+         if (size_t(npts) >= k)
+         {
+            REQUIRE(knn_ind[k*q + j] == kind[j]);
+            REQUIRE(knn_dist[k*q + j] == kdist[j]);
+         }
+      }
+
+      // points within the radius R
+      std::vector<int> rind, ref_rind;
+      kdt.FindNeighborPoints(pt, R, rind);
+      kdt.FindNeighborPointsSlow(pt, R, ref_rind);
+      std::sort(rind.begin(), rind.end());
+      std::sort(ref_rind.begin(), ref_rind.end());
+      REQUIRE(rind == ref_rind);
+
+      std::vector<int> batch_rind(nbrs.begin() + offsets[q],
+                                  nbrs.begin() + offsets[q+1]);
+      std::sort(batch_rind.begin(), batch_rind.end());
+      REQUIRE(batch_rind == ref_rind);
+   }
+}
@@ -64,3 +64,118 @@ TEST_CASE("OperatorChebyshevSmoother", "[Chebyshev symmetry]")
       delete fec;
    }
 }
+
+TEST_CASE("PolynomialSmoother", "[Chebyshev symmetry]")
+{
+   const auto type = GENERATE(PolynomialSmoother::CHEBYSHEV_4TH_KIND,
+                              PolynomialSmoother::OPT_CHEBYSHEV_4TH_KIND,
+                              PolynomialSmoother::GMRES_POLYNOMIAL);
+   CAPTURE(type);
+
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fespace(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   fespace.GetBoundaryTrueDofs(ess_tdof_list);
+
+   BilinearForm aform(&fespace);
+   aform.AddDomainIntegrator(new DiffusionIntegrator);
+   aform.Assemble();
+   SparseMatrix A;
+   aform.FormSystemMatrix(ess_tdof_list, A);
+   Vector diag;
+   A.GetDiag(diag);
+   const int n = A.Height();
+
+   SECTION("Symmetry and multiple vectors")
+   {
+      PolynomialSmoother smoother(A, diag, ess_tdof_list, 4, type);
+      Vector left(n), right(n), smooth(n);
+      left.Randomize(1);
+      right.Randomize(2);
+
+      smoother.Mult(right, smooth);
+      const real_t forward_val = left * smooth;
+      smoother.Mult(left, smooth);
+      const real_t transpose_val = right * smooth;
+      REQUIRE(fabs(forward_val - transpose_val) < 1e-10*fabs(forward_val));
+
+      Vector y1(n), y2(n);
+      Array<const Vector *> X({&left, &right});
+      Array<Vector *> Y({&y1, &y2});
+      smoother.ArrayMult(X, Y);
+      y1 -= smooth;
+      REQUIRE(y1.Normlinf() < 1e-12*smooth.Normlinf());
+   }
+
+   SECTION("Stale work vectors")
+   {
+      // The work vectors of the smoother keep the values of the previous
+      // application, here NaN, which must not leak into the next one
+      PolynomialSmoother smoother(A, diag, ess_tdof_list, 4, type);
+      Vector x(n), y(n), y_ref(n);
+      x.Randomize(4);
+      smoother.Mult(x, y_ref);
+
+      Vector x_nan(n);
+      x_nan = std::numeric_limits<real_t>::quiet_NaN();
+      smoother.Mult(x_nan, y);
+      smoother.Mult(x, y);
+      REQUIRE(y.CheckFinite() == 0);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == 0.0);
+   }
+
+   SECTION("Preconditioner")
+   {
+      Vector b(n), x(n);
+      b.Randomize(3);
+      int its[2];
+      for (int k = 0; k < 2; k++)
+      {
+         PolynomialSmoother smoother(A, diag, ess_tdof_list, 1 + 3*k, type);
+         CGSolver cg;
+         cg.SetRelTol(1e-10);
+         cg.SetMaxIter(500);
+         cg.SetOperator(A);
+         cg.SetPreconditioner(smoother);
+         x = 0.0;
+         cg.Mult(b, x);
+         REQUIRE(cg.GetConverged());
+         its[k] = cg.GetNumIterations();
+      }
+      CAPTURE(its[0], its[1]);
+      REQUIRE(2*its[1] < its[0]);
+   }
+
+   SECTION("Spectral estimate reuse")
+   {
+      PolynomialSmoother smoother(3, type);
+      smoother.SetEssentialTrueDofs(ess_tdof_list);
+      smoother.SetOperator(A, diag);
+      const real_t max_eig = smoother.GetSpectralEstimate();
+      REQUIRE(smoother.GetNumSpectralEstimates() == 1);
+
+      // A small change of the operator with a fixed diagonal scaling reuses
+      // the cached estimate
+      SparseMatrix A2(A);
+      A2 *= 1.01;
+      smoother.SetOperator(A2);
+      REQUIRE(smoother.GetNumSpectralEstimates() == 1);
+      if (type != PolynomialSmoother::GMRES_POLYNOMIAL)
+      {
+         REQUIRE(smoother.GetSpectralEstimate() ==
+                 MFEM_Approx(1.01*max_eig, 1e-2));
+      }
+
+      // A large change triggers a new estimate
+      A2 *= 2.0;
+      smoother.SetOperator(A2);
+      REQUIRE(smoother.GetNumSpectralEstimates() == 2);
+
+      // Re-estimation in every call
+      smoother.SetSpectralEstimateReuse(0);
+      smoother.SetOperator(A2);
+      REQUIRE(smoother.GetNumSpectralEstimates() == 3);
+   }
+}
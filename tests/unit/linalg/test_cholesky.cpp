@@ -0,0 +1,127 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace cholesky
+{
+
+real_t RelativeResidual(const SparseMatrix &A, const Vector &x,
+                        const Vector &b)
+{
+   Vector r(b.Size());
+   A.Mult(x, r);
+   r -= b;
+   return r.Norml2()/b.Norml2();
+}
+
+}
+
+TEST_CASE("SparseCholeskySolver", "[SparseCholeskySolver]")
+{
+   const int dim = GENERATE(2, 3);
+   const int order = GENERATE(1, 2);
+   const auto type = GENERATE(SparseCholeskySolver::CHOLESKY,
+                              SparseCholeskySolver::LDLT);
+   CAPTURE(dim, order, type);
+
+   const int ne = (dim == 2) ? 12 : 4;
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(ne, ne, Element::TRIANGLE) :
+               Mesh::MakeCartesian3D(ne, ne, ne, Element::TETRAHEDRON);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fes);
+   x = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   SECTION("Solve")
+   {
+      SparseCholeskySolver nd(type), natural(type);
+      natural.SetOrdering(SparseCholeskySolver::NATURAL);
+      nd.SetOperator(A);
+      natural.SetOperator(A);
+
+      nd.Mult(B, X);
+      REQUIRE(cholesky::RelativeResidual(A, X, B) < 1e-12);
+      Vector X2(X.Size());
+      natural.Mult(B, X2);
+      REQUIRE(cholesky::RelativeResidual(A, X2, B) < 1e-12);
+
+      REQUIRE(nd.GetNumSupernodes() < A.Height());
+      REQUIRE(nd.GetFactorNNZ() < natural.GetFactorNNZ());
+   }
+
+   SECTION("Numeric refactorization")
+   {
+      SparseCholeskySolver solver(type);
+      solver.SetOperator(A);
+      const long long nnz_L = solver.GetFactorNNZ();
+
+      // Same sparsity pattern, different values: only the numeric
+      // factorization is repeated
+      SparseMatrix A2(A);
+      A2 *= 2.0;
+      for (int i = 0; i < A2.Height(); i++) { A2(i, i) += 1.0; }
+
+      solver.SetOperator(A2);
+      REQUIRE(solver.GetFactorNNZ() == nnz_L);
+      solver.Mult(B, X);
+      REQUIRE(cholesky::RelativeResidual(A2, X, B) < 1e-12);
+   }
+}
+
+TEST_CASE("SparseCholeskySolver LDLt saddle point",
+          "[SparseCholeskySolver]")
+{
+   // Quasi-definite matrix [A, B^t; B, -C] with A and C positive definite
+   const int n = 200, m = 60;
+   SparseMatrix K(n + m);
+   for (int i = 0; i < n; i++)
+   {
+      K.Add(i, i, 2.5);
+      if (i > 0) { K.Add(i, i-1, -1.0); }
+      if (i < n-1) { K.Add(i, i+1, -1.0); }
+   }
+   for (int i = 0; i < m; i++)
+   {
+      const int j = (7*i) % n, k = (13*i + 5) % n;
+      K.Add(n+i, j, 1.0);
+      K.Add(j, n+i, 1.0);
+      K.Add(n+i, k, -0.5);
+      K.Add(k, n+i, -0.5);
+      K.Add(n+i, n+i, -0.1);
+   }
+   K.Finalize();
+
+   Vector b(n + m), x(n + m);
+   b.Randomize(1);
+
+   SparseCholeskySolver ldlt(K, SparseCholeskySolver::LDLT);
+   ldlt.Mult(b, x);
+   REQUIRE(cholesky::RelativeResidual(K, x, b) < 1e-12);
+}
@@ -160,6 +160,15 @@ TEST_CASE("Serial Direct Solvers", "[CUDA]")
          VectorFunctionCoefficient grad(dim, gradexact);
          double error = x.ComputeH1Error(&uex, &grad);
          REQUIRE(error < 1.e-12);
+
+         // Same sparsity pattern: only the numeric factorization is repeated
+         SparseMatrix A2(*A.As<SparseMatrix>());
+         A2 *= 2.0;
+         umf_solver.SetOperator(A2);
+         umf_solver.Mult(B, X);
+         A2.Mult(X, Y);
+         Y -= B;
+         REQUIRE(Y.Norml2() < 1.e-12);
       }
 #endif
 #ifdef MFEM_USE_MKL_PARDISO
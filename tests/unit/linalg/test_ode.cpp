@@ -293,6 +293,29 @@ TEST_CASE("First order ODE methods", "[ODE]")
       REQUIRE(conv_rate + tol > 4.0);
    }
 
+   SECTION("LSRK3Solver")
+   {
+      mfem::out<<"LSRK3Solver"<<std::endl;
+      real_t conv_rate = check.order(new LSRK3Solver);
+      REQUIRE(conv_rate + tol > 3.0);
+   }
+
+   SECTION("LSRK4Solver")
+   {
+      mfem::out<<"LSRK4Solver"<<std::endl;
+      real_t conv_rate = check.order(new LSRK4Solver);
+      REQUIRE(conv_rate + tol > 4.0);
+   }
+
+   SECTION("LSRK4Solver - AddMult")
+   {
+      mfem::out<<"LSRK4Solver - AddMult"<<std::endl;
+      LSRK4Solver *ode_solver = new LSRK4Solver;
+      ode_solver->SetUseAddMult(true);
+      real_t conv_rate = check.order(ode_solver);
+      REQUIRE(conv_rate + tol > 4.0);
+   }
+
    SECTION("RK6Solver")
    {
       mfem::out<<"RK6Solver"<<std::endl;
@@ -474,3 +497,541 @@ TEST_CASE("First order ODE methods", "[ODE]")
    }
 
 }
+
+TEST_CASE("Embedded RK methods", "[ODE]")
+{
+   // Harmonic oscillator, du0/dt = u1, du1/dt = -u0
+   class Oscillator : public TimeDependentOperator
+   {
+   public:
+      Oscillator() : TimeDependentOperator(2, (real_t) 0.0) { }
+
+      void Mult(const Vector &u, Vector &dudt) const override
+      {
+         dudt(0) = u(1);
+         dudt(1) = -u(0);
+      }
+   };
+
+   // A forcing pulse centered at t = 5, du/dt = exp(-((t - 5)/w)^2)
+   class Pulse : public TimeDependentOperator
+   {
+   public:
+      const real_t w = 0.2;
+
+      Pulse() : TimeDependentOperator(1, (real_t) 0.0) { }
+
+      void Mult(const Vector &u, Vector &dudt) const override
+      {
+         const real_t s = (GetTime() - 5.0)/w;
+         dudt(0) = exp(-s*s);
+      }
+   };
+
+   const int type = GENERATE(0, 1, 2);
+   std::unique_ptr<EmbeddedRKSolver> ode_solver;
+   switch (type)
+   {
+      case 0: ode_solver.reset(new BogackiShampine32Solver); break;
+      case 1: ode_solver.reset(new DormandPrince54Solver); break;
+      case 2: ode_solver.reset(new Verner65Solver); break;
+   }
+   const int stages[3] = {4, 7, 9};
+   CAPTURE(type);
+
+   SECTION("Tolerance proportionality")
+   {
+      Oscillator oper;
+      const real_t t_final = 3*M_PI;
+      int prev_steps = 0;
+      for (real_t tol : {1e-5, 1e-7, 1e-9})
+      {
+         Vector u(2);
+         u(0) = 1.0;
+         u(1) = 0.0;
+         real_t t = 0.0, dt = 1e-3;
+         ode_solver->Init(oper);
+         ode_solver->SetTolerances(tol, tol);
+         ode_solver->Run(u, t, dt, t_final);
+         REQUIRE(t == t_final);
+
+         const real_t err = std::hypot(u(0) - cos(t), u(1) + sin(t));
+         CAPTURE(tol, err);
+         REQUIRE(err < 100*tol);
+         REQUIRE(ode_solver->GetNumAcceptedSteps() > prev_steps);
+         prev_steps = ode_solver->GetNumAcceptedSteps();
+
+         // The first stage of each step reuses the last stage of the previous
+         // step (FSAL)
+         const int num_steps = ode_solver->GetNumAcceptedSteps() +
+                               ode_solver->GetNumRejectedSteps();
+         REQUIRE(ode_solver->GetNumEvaluations() ==
+                 1 + (stages[type] - 1)*num_steps);
+      }
+   }
+
+   SECTION("Continuing after Run")
+   {
+      Oscillator oper;
+      Vector u(2);
+      u(0) = 1.0;
+      u(1) = 0.0;
+      real_t t = 0.0, dt = 1e-3;
+      ode_solver->Init(oper);
+      ode_solver->SetTolerances(1e-6, 1e-6);
+      ode_solver->Run(u, t, dt, 1.0);
+      const real_t dt_prop = ode_solver->GetProposedTimeStep();
+
+      // A short last step does not reduce the step size proposed for the
+      // steps after the final time
+      const real_t t_final = t + 1e-3*dt_prop;
+      ode_solver->Run(u, t, dt, t_final);
+      REQUIRE(t == t_final);
+      REQUIRE(ode_solver->GetProposedTimeStep() == dt_prop);
+   }
+
+   SECTION("Step size adaptivity")
+   {
+      Pulse oper;
+      ode_solver->Init(oper);
+      ode_solver->SetTolerances(1e-8, 1e-8);
+      ode_solver->SetTimeStepBounds(0.0, 0.25);
+      Vector u(1);
+      u = 0.0;
+      real_t t = 0.0, dt = 1e-2, dt_min = 1.0, dt_max = 0.0;
+      while (t < 10.0)
+      {
+         ode_solver->Step(u, t, dt);
+         REQUIRE(ode_solver->GetErrorNorm() <= 1.0);
+         dt_min = std::min(dt_min, dt);
+         dt_max = std::max(dt_max, dt);
+      }
+      const real_t exact = 0.5*sqrt(M_PI)*oper.w*
+                           (std::erf((t - 5.0)/oper.w) + std::erf(5.0/oper.w));
+      CAPTURE(dt_min, dt_max, ode_solver->GetNumAcceptedSteps());
+      REQUIRE(fabs(u(0) - exact) < 1e-6);
+      REQUIRE(dt_max > 10*dt_min);
+   }
+}
+
+TEST_CASE("IMEX RK methods", "[ODE]")
+{
+   // du/dt = f_E(u,t) + f_I(u,t) with the stiff implicit term
+   // f_I = -lambda (u - cos(t)) and the explicit term f_E = -sin(t), so that
+   // u(t) = cos(t) for u(0) = 1
+   class SplitODE : public TimeDependentOperator
+   {
+   public:
+      const real_t lambda;
+      mutable int num_solves = 0;
+
+      SplitODE(real_t lambda_)
+         : TimeDependentOperator(1, (real_t) 0.0), lambda(lambda_) { }
+
+      void Mult(const Vector &u, Vector &dudt) const override
+      {
+         const real_t t = GetTime();
+         switch (GetEvalMode())
+         {
+            case ADDITIVE_TERM_1: dudt(0) = -sin(t); break;
+            case ADDITIVE_TERM_2: dudt(0) = -lambda*(u(0) - cos(t)); break;
+            default: dudt(0) = -sin(t) - lambda*(u(0) - cos(t));
+         }
+      }
+
+      void ImplicitSolve(const real_t gamma, const Vector &u,
+                         Vector &k) override
+      {
+         REQUIRE(GetEvalMode() == ADDITIVE_TERM_2);
+         num_solves++;
+         k(0) = -lambda*(u(0) - cos(GetTime()))/(1.0 + lambda*gamma);
+      }
+   };
+
+   const int type = GENERATE(0, 1, 2);
+   const int orders[3] = {2, 3, 4};
+   const int implicit_stages[3] = {2, 3, 5};
+   auto make_solver = [&]() -> ODESolver*
+   {
+      switch (type)
+      {
+         case 0: return new ARS222Solver;
+         case 1: return new ARK324Solver;
+         default: return new ARK436Solver;
+      }
+   };
+   CAPTURE(type);
+
+   auto solve = [&](real_t lambda, int steps, int &num_solves)
+   {
+      std::unique_ptr<ODESolver> ode_solver(make_solver());
+      SplitODE oper(lambda);
+      ode_solver->Init(oper);
+      Vector u(1);
+      u = 1.0;
+      const real_t t_final = 2.0;
+      real_t t = 0.0, dt = t_final/steps;
+      for (int i = 0; i < steps; i++) { ode_solver->Step(u, t, dt); }
+      num_solves = oper.num_solves;
+      return fabs(u(0) - cos(t));
+   };
+
+   SECTION("Order of convergence")
+   {
+      int num_solves;
+      const real_t err1 = solve(1.0, 20, num_solves);
+      const real_t err2 = solve(1.0, 40, num_solves);
+      const real_t rate = log(err1/err2)/log(2.0);
+      CAPTURE(err1, err2, rate);
+      REQUIRE(rate > orders[type] - 0.2);
+      // Implicit solves are only performed for the implicit stages
+      REQUIRE(num_solves == 40*implicit_stages[type]);
+   }
+
+   SECTION("Stiff implicit term")
+   {
+      // The time step is far beyond the explicit stability limit of the
+      // implicit term
+      int num_solves;
+      const real_t err = solve(1e6, 20, num_solves);
+      CAPTURE(err);
+      REQUIRE(err < 1e-3);
+   }
+}
+
+TEST_CASE("Multirate AB methods", "[ODE]")
+{
+   // Harmonic oscillator u0' = -u1, u1' = u0 with u(t) = (cos(t), sin(t)),
+   // where the two unknowns may be on different levels
+   class Oscillator : public MultirateTimeDependentOperator
+   {
+   public:
+      mutable Array<int> num_evals;
+
+      Oscillator() : MultirateTimeDependentOperator(2, (real_t) 0.0),
+         num_evals(3) { num_evals = 0; }
+
+      void Mult(const Vector &u, Vector &dudt) const override
+      {
+         dudt(0) = -u(1);
+         dudt(1) = u(0);
+      }
+
+      void MultLevels(int min_level, const Vector &u,
+                      Vector &dudt) const override
+      {
+         num_evals[min_level]++;
+         Mult(u, dudt);
+      }
+   };
+
+   const int order = GENERATE(1, 2, 3, 4);
+   CAPTURE(order);
+
+   auto solve = [&](const Array<int> &levels, int steps, Oscillator &oper,
+                    Vector &u)
+   {
+      MultirateABSolver ode_solver(order);
+      ode_solver.SetLevels(levels);
+      ode_solver.Init(oper);
+      u.SetSize(2);
+      u(0) = 1.0;
+      u(1) = 0.0;
+      const real_t t_final = 2.0;
+      real_t t = 0.0, dt = t_final/steps;
+      for (int i = 0; i < steps; i++) { ode_solver.Step(u, t, dt); }
+      REQUIRE(fabs(t - t_final) < 1e-14);
+      return std::hypot(u(0) - cos(t), u(1) - sin(t));
+   };
+
+   SECTION("Single level")
+   {
+      // Equivalent to AdamsBashforthSolver with RK4 startup
+      Oscillator oper;
+      Vector u;
+      solve(Array<int>(), 20, oper, u);
+
+      class ABRK4Solver : public AdamsBashforthSolver
+      {
+      public:
+         ABRK4Solver(int s, const real_t *a) : AdamsBashforthSolver(s, a)
+         { RKsolver.reset(new RK4Solver); }
+      };
+      const real_t a[4][4] =
+      {
+         {1.0},
+         {1.5, -0.5},
+         {23.0/12.0, -4.0/3.0, 5.0/12.0},
+         {55.0/24.0, -59.0/24.0, 37.0/24.0, -9.0/24.0}
+      };
+      ABRK4Solver ab(order, a[order-1]);
+      Oscillator oper_ab;
+      ab.Init(oper_ab);
+      Vector u_ab(2);
+      u_ab(0) = 1.0;
+      u_ab(1) = 0.0;
+      real_t t = 0.0, dt = 0.1;
+      for (int i = 0; i < 20; i++) { ab.Step(u_ab, t, dt); }
+      u_ab -= u;
+      REQUIRE(u_ab.Normlinf() < 1e-12);
+   }
+
+   SECTION("Order of convergence")
+   {
+      Array<int> levels({0, GENERATE(1, 2)});
+      CAPTURE(levels[1]);
+      Oscillator oper1, oper2;
+      Vector u;
+      const real_t err1 = solve(levels, 40, oper1, u);
+      const real_t err2 = solve(levels, 80, oper2, u);
+      const real_t rate = log(err1/err2)/log(2.0);
+      CAPTURE(err1, err2, rate);
+      REQUIRE(rate > order - 0.2);
+   }
+
+   SECTION("Level evaluations")
+   {
+      // With three levels, each macro step has four substeps, which start
+      // the steps of levels >= 0, 2, 1 and 2, respectively
+      Array<int> levels({0, 2});
+      Oscillator oper;
+      Vector u;
+      const int steps = 10;
+      solve(levels, steps, oper, u);
+      const int mr_steps = steps - (order - 1);
+      REQUIRE(oper.num_evals[0] == mr_steps);
+      REQUIRE(oper.num_evals[1] == mr_steps);
+      REQUIRE(oper.num_evals[2] == 2*mr_steps);
+   }
+}
+
+TEST_CASE("MGRIT", "[ODE]")
+{
+   // Damped oscillator u0' = u1, u1' = -u0 - 0.1 u1
+   class Oscillator : public TimeDependentOperator
+   {
+   public:
+      Oscillator() : TimeDependentOperator(2, (real_t) 0.0) { }
+
+      void Mult(const Vector &u, Vector &dudt) const override
+      {
+         dudt(0) = u(1);
+         dudt(1) = -u(0) - 0.1*u(1);
+      }
+   };
+
+   const int num_intervals = 16, cfactor = 8;
+   const real_t t_final = 8.0;
+   Oscillator oper;
+   RK4Solver fine;
+   RK2Solver coarse;
+
+   // Sequential fine time stepping, with the values at the C-points
+   std::vector<Vector> u_seq(num_intervals + 1, Vector(2));
+   {
+      Vector u(2);
+      u(0) = 1.0;
+      u(1) = 0.0;
+      u_seq[0] = u;
+      fine.Init(oper);
+      real_t t = 0.0;
+      for (int n = 0; n < num_intervals; n++)
+      {
+         for (int j = 0; j < cfactor; j++)
+         {
+            real_t dt = t_final/(num_intervals*cfactor);
+            fine.Step(u, t, dt);
+         }
+         u_seq[n+1] = u;
+      }
+   }
+
+   auto solve = [&](MGRITSolver::RelaxationType relaxation, int max_iter,
+                    real_t tol, MGRITSolver &mgrit, Vector &u)
+   {
+      mgrit.SetPropagators(oper, fine, coarse);
+      mgrit.SetNumIntervals(num_intervals);
+      mgrit.SetCoarseningFactor(cfactor);
+      mgrit.SetRelaxation(relaxation);
+      mgrit.SetMaxIter(max_iter);
+      mgrit.SetAbsTol(tol);
+      u.SetSize(2);
+      u(0) = 1.0;
+      u(1) = 0.0;
+      mgrit.Solve(u, 0.0, t_final);
+   };
+
+   SECTION("Exactness")
+   {
+      // After k iterations, the first k (F-relaxation) or 2k (FCF-relaxation)
+      // C-point values are the sequential ones
+      const int k = 3;
+      for (auto relaxation : {MGRITSolver::F_RELAXATION,
+                              MGRITSolver::FCF_RELAXATION})
+      {
+         MGRITSolver mgrit;
+         Vector u;
+         solve(relaxation, k, 0.0, mgrit, u);
+         REQUIRE(!mgrit.GetConverged());
+         REQUIRE(mgrit.GetNumIterations() == k);
+         const int exact = (relaxation == MGRITSolver::F_RELAXATION) ? k : 2*k;
+         Vector diff(2);
+         for (int n = 0; n <= num_intervals; n++)
+         {
+            subtract(mgrit.GetCPointValue(n), u_seq[n], diff);
+            CAPTURE(relaxation, n);
+            if (n <= exact) { REQUIRE(diff.Normlinf() < 1e-13); }
+            else if (n == exact + 2) { REQUIRE(diff.Normlinf() > 1e-13); }
+         }
+      }
+   }
+
+   SECTION("Convergence")
+   {
+      MGRITSolver mgrit_f, mgrit_fcf;
+      Vector u_f, u_fcf;
+      solve(MGRITSolver::F_RELAXATION, 20, 1e-10, mgrit_f, u_f);
+      solve(MGRITSolver::FCF_RELAXATION, 20, 1e-10, mgrit_fcf, u_fcf);
+      REQUIRE(mgrit_f.GetConverged());
+      REQUIRE(mgrit_fcf.GetConverged());
+      REQUIRE(mgrit_fcf.GetNumIterations() < mgrit_f.GetNumIterations());
+
+      // The solution at the final time is the sequential one
+      u_f -= u_seq[num_intervals];
+      u_fcf -= u_seq[num_intervals];
+      REQUIRE(u_f.Normlinf() < 1e-9);
+      REQUIRE(u_fcf.Normlinf() < 1e-9);
+   }
+}
+
+TEST_CASE("ODE solver checkpointing", "[ODE]")
+{
+   // Damped oscillator u0' = u1, u1' = -u0 - 0.1 u1 + sin(t)
+   class Oscillator : public TimeDependentOperator
+   {
+   public:
+      Oscillator() : TimeDependentOperator(2, (real_t) 0.0) { }
+
+      void Mult(const Vector &u, Vector &dudt) const override
+      {
+         dudt(0) = u(1);
+         dudt(1) = -u(0) - 0.1*u(1) + sin(GetTime());
+      }
+
+      void ImplicitSolve(const real_t gamma, const Vector &u,
+                         Vector &k) override
+      {
+         // Solve k = f(u + gamma k, t)
+         const real_t b0 = u(1), b1 = -u(0) - 0.1*u(1) + sin(GetTime());
+         const real_t det = 1.0 + 0.1*gamma + gamma*gamma;
+         k(0) = ((1.0 + 0.1*gamma)*b0 + gamma*b1)/det;
+         k(1) = (b1 - gamma*b0)/det;
+      }
+   };
+
+   const int type = GENERATE(0, 1, 2, 3);
+   auto make_solver = [&]() -> ODESolver*
+   {
+      switch (type)
+      {
+         case 0: return new AB3Solver;
+         case 1: return new GeneralizedAlphaSolver(0.5);
+         case 2: return new DormandPrince54Solver;
+         default:
+         {
+            auto mrab = new MultirateABSolver(3);
+            mrab->SetLevels(Array<int>({0, 1}));
+            return mrab;
+         }
+      }
+   };
+   CAPTURE(type);
+
+   Oscillator oper;
+   Vector u0(2);
+   u0(0) = 1.0;
+   u0(1) = 0.0;
+   const real_t dt0 = 0.05;
+
+   SECTION("Restart")
+   {
+      std::unique_ptr<ODESolver> solver(make_solver());
+      solver->Init(oper);
+      Vector u(u0);
+      real_t t = 0.0, dt = dt0;
+      for (int i = 0; i < 5; i++) { solver->Step(u, t, dt); }
+
+      std::stringstream state;
+      solver->SaveState(state);
+      Vector u_saved(u);
+      const real_t t_saved = t, dt_saved = dt;
+
+      for (int i = 0; i < 5; i++) { solver->Step(u, t, dt); }
+
+      // Restart a new solver from the checkpoint
+      std::unique_ptr<ODESolver> restarted(make_solver());
+      restarted->Init(oper);
+      restarted->LoadState(state);
+      real_t t2 = t_saved, dt2 = dt_saved;
+      for (int i = 0; i < 5; i++) { restarted->Step(u_saved, t2, dt2); }
+
+      REQUIRE(t2 == t);
+      u_saved -= u;
+      REQUIRE(u_saved.Normlinf() == 0.0);
+   }
+
+   SECTION("Binomial checkpointing")
+   {
+      if (type == 2) { return; } // adaptive step size
+
+      const int num_steps = GENERATE(10, 20, 50);
+      const int num_checkpoints = GENERATE(1, 3, 4);
+      CAPTURE(num_steps, num_checkpoints);
+
+      // Sequential forward solution
+      std::unique_ptr<ODESolver> solver(make_solver());
+      solver->Init(oper);
+      std::vector<Vector> u_seq;
+      Vector u(u0);
+      real_t t = 0.0, dt = dt0;
+      for (int n = 0; n < num_steps; n++)
+      {
+         u_seq.push_back(u);
+         solver->Step(u, t, dt);
+      }
+
+      solver->Init(oper);
+      BinomialCheckpointing checkpointing(num_checkpoints);
+      int next = num_steps - 1;
+      checkpointing.Run(*solver, u0, 0.0, dt0, num_steps,
+                        [&](int n, real_t tn, const Vector &un)
+      {
+         REQUIRE(n == next);
+         REQUIRE(tn == MFEM_Approx(n*dt0));
+         Vector diff(un);
+         diff -= u_seq[n];
+         REQUIRE(diff.Normlinf() == 0.0);
+         next--;
+      });
+      REQUIRE(next == -1);
+
+      // Optimal number of forward steps, and the bound given by the number
+      // of repetitions
+      const int r = BinomialCheckpointing::NumRepetitions(num_steps,
+                                                          num_checkpoints);
+      REQUIRE(checkpointing.GetNumForwardSteps() <= r*(num_steps - 1));
+      if (num_steps == 20 && num_checkpoints == 3)
+      {
+         REQUIRE(checkpointing.GetNumForwardSteps() == 45);
+      }
+      if (num_steps == 50 && num_checkpoints == 4)
+      {
+         REQUIRE(checkpointing.GetNumForwardSteps() == 144);
+      }
+      if (num_checkpoints == 1)
+      {
+         REQUIRE(checkpointing.GetNumForwardSteps() ==
+                 num_steps*(num_steps - 1)/2);
+      }
+   }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace recycled_cg
+{
+
+// 5-point finite difference Laplacian on an n x n grid with a variable
+// coefficient scaled by (1 + eps*sin(...)) plus a diagonal shift.
+SparseMatrix *Laplacian(int n, real_t eps, real_t shift)
+{
+   SparseMatrix *A = new SparseMatrix(n*n, n*n);
+   auto coeff = [&](int i, int j)
+   { return 1.0 + eps*sin(M_PI*(i+0.5)/n)*cos(M_PI*(j+0.5)/n); };
+   for (int j = 0; j < n; j++)
+   {
+      for (int i = 0; i < n; i++)
+      {
+         const int row = i + j*n;
+         const real_t c = coeff(i, j);
+         A->Add(row, row, 4.0*c + shift);
+         if (i > 0) { A->Add(row, row - 1, -c); }
+         if (i < n-1) { A->Add(row, row + 1, -c); }
+         if (j > 0) { A->Add(row, row - n, -c); }
+         if (j < n-1) { A->Add(row, row + n, -c); }
+      }
+   }
+   A->Finalize();
+   // Symmetrize the variable coefficient stencil
+   SparseMatrix *At = Transpose(*A);
+   SparseMatrix *S = Add(0.5, *A, 0.5, *At);
+   delete A;
+   delete At;
+   return S;
+}
+
+}
+
+TEST_CASE("RecycledCGSolver", "[RecycledCG]")
+{
+   const int n = 24, nsteps = 6;
+   const real_t tol = 1e-10;
+   auto precond = GENERATE(false, true);
+   CAPTURE(precond);
+
+   RecycledCGSolver rcg;
+   rcg.SetRelTol(tol);
+   rcg.SetAbsTol(0.0);
+   rcg.SetMaxIter(500);
+   rcg.SetRecycleDim(10);
+   rcg.SetNumRetainedDirections(30);
+
+   CGSolver cg;
+   cg.SetRelTol(tol);
+   cg.SetAbsTol(0.0);
+   cg.SetMaxIter(500);
+
+   // The preconditioner is updated by SetOperator() in each step
+   DSmoother jacobi;
+   if (precond)
+   {
+      rcg.SetPreconditioner(jacobi);
+      cg.SetPreconditioner(jacobi);
+   }
+
+   int rcg_its = 0, cg_its = 0;
+   for (int step = 0; step < nsteps; step++)
+   {
+      std::unique_ptr<SparseMatrix> A(
+         recycled_cg::Laplacian(n, 0.05*step, 1e-3));
+      rcg.SetOperator(*A);
+      cg.SetOperator(*A);
+
+      Vector b(A->Height()), x(A->Height()), x_cg(A->Height()), res(b.Size());
+      b.Randomize(step + 1);
+      x = 0.0;
+      x_cg = 0.0;
+
+      rcg.Mult(b, x);
+      cg.Mult(b, x_cg);
+      REQUIRE(rcg.GetConverged());
+      REQUIRE(cg.GetConverged());
+      rcg_its += rcg.GetNumIterations();
+      cg_its += cg.GetNumIterations();
+
+      // Check the true residual and compare with the plain CG solution
+      A->Mult(x, res);
+      res -= b;
+      REQUIRE(res.Norml2() <= 1e-8*b.Norml2());
+      x -= x_cg;
+      REQUIRE(x.Normlinf() <= 1e-6*x_cg.Normlinf());
+
+      REQUIRE(rcg.GetRecycleDim() == 10);
+      if (step > 0)
+      {
+         REQUIRE(rcg.GetNumIterations() < cg.GetNumIterations());
+      }
+   }
+   CAPTURE(rcg_its, cg_its);
+   REQUIRE(rcg_its < cg_its);
+
+   // Changing the operator size discards the recycle space
+   std::unique_ptr<SparseMatrix> A(recycled_cg::Laplacian(n/2, 0.0, 1e-3));
+   rcg.SetOperator(*A);
+   REQUIRE(rcg.GetRecycleDim() == 0);
+}
@@ -181,6 +181,161 @@ TEST_CASE("MakeSimplicial", "[Mesh]")
    REQUIRE(simplex_mesh.GetNE() == orig_mesh.GetNE()*factor);
 }
 
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   auto mesh_fname = GENERATE("../../data/star.mesh",
+                              "../../data/fichera-mixed.mesh",
+                              "../../data/escher-p2.mesh",
+                              "../../data/pipe-nurbs-2d.mesh");
+   CAPTURE(mesh_fname);
+
+   Mesh mesh = Mesh::LoadFromFile(mesh_fname);
+   if (mesh.NURBSext) { mesh.SetCurvature(2); } // convert to a curved mesh
+   mesh.attribute_sets.SetAttributeSet("All", mesh.attributes);
+   mesh.bdr_attribute_sets.SetAttributeSet("First", Array<int>({1}));
+
+   auto check_same = [&mesh](const Mesh &mesh2)
+   {
+      REQUIRE(mesh2.Dimension() == mesh.Dimension());
+      REQUIRE(mesh2.SpaceDimension() == mesh.SpaceDimension());
+      REQUIRE(mesh2.GetNV() == mesh.GetNV());
+      REQUIRE(mesh2.GetNE() == mesh.GetNE());
+      REQUIRE(mesh2.GetNBE() == mesh.GetNBE());
+      REQUIRE(mesh2.GetNEdges() == mesh.GetNEdges());
+      REQUIRE(mesh2.GetNFaces() == mesh.GetNFaces());
+      for (int i = 0; i < mesh.GetNV(); i++)
+      {
+         for (int d = 0; d < mesh.SpaceDimension(); d++)
+         {
+            REQUIRE(mesh2.GetVertex(i)[d] == mesh.GetVertex(i)[d]);
+         }
+      }
+      // Finalize() may reorder the vertices of tetrahedra, so compare sets
+      Array<int> v, v2;
+      auto check_same_vertices = [&v, &v2]()
+      {
+         v.Sort();
+         v2.Sort();
+         REQUIRE(v2.Size() == v.Size());
+         for (int j = 0; j < v.Size(); j++) { REQUIRE(v2[j] == v[j]); }
+      };
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         REQUIRE(mesh2.GetAttribute(i) == mesh.GetAttribute(i));
+         mesh.GetElementVertices(i, v);
+         mesh2.GetElementVertices(i, v2);
+         check_same_vertices();
+      }
+      for (int i = 0; i < mesh.GetNBE(); i++)
+      {
+         REQUIRE(mesh2.GetBdrAttribute(i) == mesh.GetBdrAttribute(i));
+         mesh.GetBdrElementVertices(i, v);
+         mesh2.GetBdrElementVertices(i, v2);
+         check_same_vertices();
+      }
+      REQUIRE(mesh2.attribute_sets.GetAttributeSetNames() ==
+              mesh.attribute_sets.GetAttributeSetNames());
+      REQUIRE(mesh2.bdr_attribute_sets.GetAttributeSetNames() ==
+              mesh.bdr_attribute_sets.GetAttributeSetNames());
+      REQUIRE((mesh2.GetNodes() == nullptr) == (mesh.GetNodes() == nullptr));
+      if (mesh.GetNodes())
+      {
+         Vector diff(*mesh2.GetNodes());
+         diff -= *mesh.GetNodes();
+         REQUIRE(diff.Normlinf() == 0.0);
+      }
+   };
+
+   SECTION("Stream")
+   {
+      std::stringstream ss;
+      mesh.PrintBinary(ss);
+      Mesh mesh2(ss);
+      check_same(mesh2);
+   }
+
+   SECTION("File")
+   {
+      const std::string fname = "binary_mesh_test.mesh";
+      mesh.SaveBinary(fname);
+      Mesh mesh2 = Mesh::LoadFromBinaryFile(fname);
+      check_same(mesh2);
+      Mesh mesh3 = Mesh::LoadFromFile(fname);
+      check_same(mesh3);
+      std::remove(fname.c_str());
+   }
+}
+
+TEST_CASE("Gmsh reader", "[Mesh]")
+{
+   // Vertex numbers with gaps, listed in reverse order, exercise both the
+   // dense and the sorted vertex number maps of the reader
+   const int stride = GENERATE(1, 2, 1000);
+   const bool binary = GENERATE(false, true);
+   CAPTURE(stride, binary);
+
+   const int n = 4, nv = (n+1)*(n+1);
+   auto id = [stride](int i, int j) { return 1 + stride*(j*(n+1) + i); };
+
+   std::stringstream ss;
+   auto write_int = [&ss](int x) { ss.write((const char*)&x, sizeof(int)); };
+   ss << "$MeshFormat\n2.2 " << binary << " " << sizeof(double) << "\n";
+   if (binary) { write_int(1); ss << "\n"; }
+   ss << "$EndMeshFormat\n$Nodes\n" << nv << "\n";
+   for (int k = nv-1; k >= 0; k--)
+   {
+      const int i = k % (n+1), j = k / (n+1);
+      const double x[3] = {double(i), double(j), 0.0};
+      if (binary)
+      {
+         write_int(id(i, j));
+         ss.write((const char*)x, sizeof(x));
+      }
+      else { ss << id(i, j) << " " << x[0] << " " << x[1] << " 0\n"; }
+   }
+   if (binary) { ss << "\n"; }
+   ss << "$EndNodes\n$Elements\n" << n*n << "\n";
+   if (binary) { write_int(3); write_int(n*n); write_int(2); }
+   for (int e = 0; e < n*n; e++)
+   {
+      const int i = e % n, j = e / n;
+      const int data[7] = {e+1, 1, 1,
+                           id(i, j), id(i+1, j), id(i+1, j+1), id(i, j+1)
+                          };
+      if (binary)
+      {
+         for (int d : data) { write_int(d); }
+      }
+      else
+      {
+         ss << data[0] << " 3 2";
+         for (int k = 1; k < 7; k++) { ss << " " << data[k]; }
+         ss << "\n";
+      }
+   }
+   if (binary) { ss << "\n"; }
+   ss << "$EndElements\n";
+
+   Mesh mesh(ss);
+   REQUIRE(mesh.Dimension() == 2);
+   REQUIRE(mesh.SpaceDimension() == 2);
+   REQUIRE(mesh.GetNV() == nv);
+   REQUIRE(mesh.GetNE() == n*n);
+   Array<int> v;
+   for (int e = 0; e < n*n; e++)
+   {
+      const int i = e % n, j = e / n;
+      const real_t x[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+      mesh.GetElementVertices(e, v);
+      REQUIRE(v.Size() == 4);
+      for (int k = 0; k < 4; k++)
+      {
+         REQUIRE(mesh.GetVertex(v[k])[0] == i + x[k][0]);
+         REQUIRE(mesh.GetVertex(v[k])[1] == j + x[k][1]);
+      }
+   }
+}
+
 TEST_CASE("MakeNurbs", "[Mesh]")
 {
    Array<real_t> intervals_array({1, 1, 1});
@@ -14,6 +14,7 @@
 #include "unit_tests.hpp"
 
 #include <array>
+#include <map>
 namespace mfem
 {
 
@@ -182,6 +183,88 @@ TEST_CASE("NCMesh 3D Derefined Volume", "[NCMesh]")
    REQUIRE(derefined_volume == MFEM_Approx(original_volume));
 } // test case
 
+TEST_CASE("NCMesh Anisotropic SFC Ordering", "[NCMesh]")
+{
+   // After an anisotropic refinement followed by isotropic refinements,
+   // consecutive leaf elements are face neighbors, as for the Hilbert curve
+   // of isotropically refined meshes
+   const int dim = GENERATE(2, 3);
+   const int aniso = (dim == 2) ? Refinement::X : GENERATE(Refinement::X,
+                                                          Refinement::XY,
+                                                          Refinement::YZ);
+   CAPTURE(dim, aniso);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(1, 1, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(1, 1, 1, Element::HEXAHEDRON);
+   mesh.EnsureNCMesh();
+   for (int ref_type : {aniso, (dim == 2) ? 3 : 7, (dim == 2) ? 3 : 7})
+   {
+      Array<Refinement> refs;
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         refs.Append(Refinement(e, ref_type));
+      }
+      mesh.GeneralRefinement(refs, 1);
+   }
+
+   const int face_verts = (dim == 2) ? 2 : 4;
+   Array<int> v1, v2;
+   for (int e = 0; e + 1 < mesh.GetNE(); e++)
+   {
+      mesh.GetElementVertices(e, v1);
+      mesh.GetElementVertices(e + 1, v2);
+      int common = 0;
+      for (int a : v1) { for (int b : v2) { common += (a == b); } }
+      CAPTURE(e);
+      REQUIRE(common == face_verts);
+   }
+} // test case
+
+TEST_CASE("NCMesh VDof Levels", "[NCMesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(2, 2, Element::QUADRILATERAL);
+   L2_FECollection l2_fec(1, 2);
+   FiniteElementSpace conforming_fes(&mesh, &l2_fec, 2);
+   Array<int> levels;
+   conforming_fes.GetVDofLevels(levels);
+   REQUIRE(levels.Size() == conforming_fes.GetVSize());
+   REQUIRE(levels.Max() == 0);
+
+   // Refine one element twice
+   mesh.EnsureNCMesh();
+   Array<int> refs({0});
+   mesh.GeneralRefinement(refs);
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      if (mesh.ncmesh->GetElementDepth(e) == 1) { refs[0] = e; }
+   }
+   mesh.GeneralRefinement(refs, 1);
+
+   for (int order : {1, 2})
+   {
+      H1_FECollection h1_fec(order, 2);
+      for (const FiniteElementCollection *fec :
+           {static_cast<const FiniteElementCollection*>(&l2_fec),
+            static_cast<const FiniteElementCollection*>(&h1_fec)})
+      {
+         FiniteElementSpace fes(&mesh, fec, 2);
+         fes.GetVDofLevels(levels);
+         REQUIRE(levels.Size() == fes.GetVSize());
+         REQUIRE(levels.Min() == 0);
+         REQUIRE(levels.Max() == 2);
+
+         Array<int> vdofs;
+         for (int e = 0; e < mesh.GetNE(); e++)
+         {
+            const int depth = mesh.ncmesh->GetElementDepth(e);
+            fes.GetElementVDofs(e, vdofs);
+            for (int vd : vdofs) { REQUIRE(levels[vd] >= depth); }
+         }
+      }
+   }
+} // test case
+
 
 #ifdef MFEM_USE_MPI
 
@@ -1693,6 +1776,63 @@ TEST_CASE("Parallel RP=I", "[Parallel], [NCMesh]")
    }
 }
 
+TEST_CASE("Weighted Rebalance", "[Parallel], [NCMesh]")
+{
+   const real_t tol = GENERATE(0.0, 0.2);
+   CAPTURE(tol);
+
+   Mesh smesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   smesh.EnsureNCMesh();
+   ParMesh pmesh(MPI_COMM_WORLD, smesh);
+
+   // refine the lower left corner, to create an imbalance
+   Vector center;
+   for (int it = 0; it < 2; it++)
+   {
+      Array<int> refs;
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         pmesh.GetElementCenter(i, center);
+         if (center(0) < 0.3 && center(1) < 0.3) { refs.Append(i); }
+      }
+      pmesh.GeneralRefinement(refs);
+   }
+
+   H1_FECollection fec(2, 2);
+   ParFiniteElementSpace fespace(&pmesh, &fec);
+   ParGridFunction x(&fespace);
+   FunctionCoefficient coeff([](const Vector &p) { return p(0)*p(0) + p(1); });
+   x.ProjectCoefficient(coeff);
+
+   // the elements in the right half are twice as expensive
+   const real_t max_weight = 2.0;
+   auto weights = [&]()
+   {
+      Array<real_t> w(pmesh.GetNE());
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         pmesh.GetElementCenter(i, center);
+         w[i] = (center(0) > 0.5) ? max_weight : 1.0;
+      }
+      return w;
+   };
+
+   const long long global_ne = pmesh.GetGlobalNE();
+   pmesh.Rebalance(weights(), tol);
+   fespace.Update();
+   x.Update();
+
+   REQUIRE(pmesh.GetGlobalNE() == global_ne);
+   REQUIRE(x.ComputeL2Error(coeff) < EPS);
+
+   real_t local_weight = weights().Sum(), total_weight;
+   MPI_Allreduce(&local_weight, &total_weight, 1, MPITypeMap<real_t>::mpi_type,
+                 MPI_SUM, MPI_COMM_WORLD);
+   const real_t avg_weight = total_weight / Mpi::WorldSize();
+   REQUIRE(local_weight <= (1.0 + tol)*avg_weight + max_weight + EPS);
+   REQUIRE(local_weight >= (1.0 - tol)*avg_weight - max_weight - EPS);
+}
+
 #endif // MFEM_USE_MPI
 
 TEST_CASE("ReferenceCubeInternalBoundaries", "[NCMesh]")
@@ -2892,4 +3032,137 @@ TEST_CASE("InternalBoundaryProjectBdrCoefficient", "[NCMesh]")
    }
 }
 
+// Exposes the NCMesh faces to enumerate the boundary faces of the leaf
+// elements directly, as a reference for the boundary of the Mesh.
+struct NCMeshBoundaryExposed : public NCMesh
+{
+   NCMeshBoundaryExposed(const NCMesh &ncmesh) : NCMesh(ncmesh) {}
+
+   /// Return the attribute and the vertices of each boundary face that is not
+   /// a master face, by face ID. The vertex order of a face is given by the
+   /// last leaf element using it.
+   std::map<int, std::vector<int>> GetBoundaryFaces() const
+   {
+      std::map<int, std::vector<int>> bdr_faces;
+      for (int leaf : leaf_elements)
+      {
+         const Element &el = elements[leaf];
+         const int *node = el.node;
+         const GeomInfo &gi = GI[el.Geom()];
+         for (int k = 0; k < gi.nf; k++)
+         {
+            const int *fv = gi.faces[k];
+            const int nfv = gi.nfv[k];
+            const int id = faces.FindId(node[fv[0]], node[fv[1]], node[fv[2]],
+                                        node[fv[3]]);
+            REQUIRE(id >= 0);
+            if (!faces[id].Boundary()) { continue; }
+
+            const bool master =
+               (nfv == 4) ? QuadFaceIsMaster(node[fv[0]], node[fv[1]],
+                                             node[fv[2]], node[fv[3]]) :
+               (nfv == 3) ? TriFaceIsMaster(node[fv[0]], node[fv[1]],
+                                            node[fv[2]]) :
+               (EdgeSplitLevel(node[fv[0]], node[fv[2]]) > 0);
+            if (master) { continue; }
+
+            // 2D faces store their second vertex in the slot 2
+            std::vector<int> &bf = bdr_faces[id];
+            bf.assign(1, faces[id].attribute);
+            for (int v = 0; v < nfv; v++)
+            {
+               bf.push_back(nodes[node[fv[(nfv == 2) ? 2*v : v]]].vert_index);
+            }
+         }
+      }
+      return bdr_faces;
+   }
+};
+
+// Total measure of the boundary elements with each attribute
+std::map<int, real_t> BdrAttributeMeasures(Mesh &mesh)
+{
+   std::map<int, real_t> measures;
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      ElementTransformation *T = mesh.GetBdrElementTransformation(i);
+      const IntegrationRule &ir = IntRules.Get(T->GetGeometryType(), 2);
+      real_t m = 0.0;
+      for (int j = 0; j < ir.GetNPoints(); j++)
+      {
+         T->SetIntPoint(&ir.IntPoint(j));
+         m += ir.IntPoint(j).weight * T->Weight();
+      }
+      measures[mesh.GetBdrAttribute(i)] += m;
+   }
+   return measures;
+}
+
+// Test case: Verify that after nonconforming refinement the boundary elements
+//            are the unsplit boundary faces of the NCMesh, in the order of the
+//            face IDs and with the vertices and attributes of the faces, and
+//            that they cover the boundary of each attribute of the coarse mesh.
+TEST_CASE("NCMesh Boundary Elements", "[NCMesh]")
+{
+   const bool tet_mesh = GENERATE(false, true);
+   const bool three_dim = GENERATE(false, true);
+   CAPTURE(tet_mesh, three_dim);
+
+   // Two elements with an internal boundary between them, whose faces become
+   // masters when only one side is refined
+   Mesh mesh = DividingPlaneMesh(tet_mesh, true, three_dim);
+   mesh.EnsureNCMesh(true);
+   const auto coarse_measures = BdrAttributeMeasures(mesh);
+
+   auto check_boundary = [&]()
+   {
+      NCMeshBoundaryExposed ncmesh(*mesh.ncmesh);
+      const auto bdr_faces = ncmesh.GetBoundaryFaces();
+      REQUIRE(mesh.GetNBE() == (int) bdr_faces.size());
+      int i = 0;
+      for (const auto &bf : bdr_faces)
+      {
+         Array<int> v;
+         mesh.GetBdrElementVertices(i, v);
+         CHECK(mesh.GetBdrAttribute(i) == bf.second[0]);
+         REQUIRE(v.Size() + 1 == (int) bf.second.size());
+         for (int j = 0; j < v.Size(); j++)
+         {
+            CHECK(v[j] == bf.second[j+1]);
+         }
+         i++;
+      }
+
+      const auto measures = BdrAttributeMeasures(mesh);
+      REQUIRE(measures.size() == coarse_measures.size());
+      for (const auto &m : coarse_measures)
+      {
+         CHECK(measures.at(m.first) == MFEM_Approx(m.second));
+      }
+   };
+
+   // Refine the first element only, the internal boundary faces become
+   // masters with slave faces on the refined side
+   mesh.GeneralRefinement(Array<int>({0}));
+   check_boundary();
+
+   // Refine a few elements on both sides, anisotropically if possible
+   const bool aniso = !tet_mesh;
+   const char types[] = { Refinement::X, Refinement::Y, Refinement::XY,
+                          Refinement::Z, Refinement::XZ, Refinement::YZ
+                        };
+   for (int r = 0; r < 3; r++)
+   {
+      Array<Refinement> refs;
+      for (int i = r % 2; i < mesh.GetNE(); i += 3)
+      {
+         char type = Refinement::XYZ;
+         if (aniso) { type = types[(i + r) % (three_dim ? 6 : 3)]; }
+         refs.Append(Refinement(i, type));
+      }
+      mesh.GeneralRefinement(refs);
+      check_boundary();
+   }
+}
+
 } // namespace mfem
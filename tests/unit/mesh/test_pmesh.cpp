@@ -11,6 +11,7 @@
 
 #include "mfem.hpp"
 #include "unit_tests.hpp"
+#include "mesh_test_utils.hpp"
 
 namespace mfem
 {
@@ -194,6 +195,136 @@ TEST_CASE("ParMeshMakeSimplicial", "[Parallel], [ParMesh]")
    REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
 }
 
+TEST_CASE("ParMeshBinaryFormat", "[Parallel], [ParMesh]")
+{
+   auto mesh_fname = GENERATE("../../data/star.mesh",
+                              "../../data/fichera.mesh",
+                              "../../data/escher-p2.mesh");
+   CAPTURE(mesh_fname);
+
+   Mesh mesh = Mesh::LoadFromFile(mesh_fname);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+
+   const std::string fname = "binary_pmesh_test.mesh";
+   pmesh.SaveBinary(fname);
+   ParMesh pmesh_file = ParMesh::LoadFromBinaryFile(MPI_COMM_WORLD, fname);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (Mpi::Root()) { std::remove(fname.c_str()); }
+
+   std::stringstream ss;
+   pmesh.ParPrintBinary(ss);
+   ParMesh pmesh_stream(MPI_COMM_WORLD, ss);
+
+   const int dim = pmesh.Dimension();
+   H1_FECollection fec(2, dim);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   for (ParMesh *pmesh2 : {&pmesh_file, &pmesh_stream})
+   {
+      REQUIRE(pmesh2->GetNE() == pmesh.GetNE());
+      REQUIRE(pmesh2->GetNV() == pmesh.GetNV());
+      REQUIRE(pmesh2->GetNBE() == pmesh.GetNBE());
+      REQUIRE(pmesh2->GetNSharedFaces() == pmesh.GetNSharedFaces());
+      REQUIRE(pmesh2->GetNGroups() == pmesh.GetNGroups());
+      REQUIRE((pmesh2->GetNodes() == nullptr) == (pmesh.GetNodes() == nullptr));
+
+      // the shared entities define the global numbering of the dofs
+      ParFiniteElementSpace fes2(pmesh2, &fec);
+      REQUIRE(fes2.GetTrueVSize() == fes.GetTrueVSize());
+      REQUIRE(fes2.GlobalTrueVSize() == fes.GlobalTrueVSize());
+   }
+}
+
+TEST_CASE("ParMeshBinaryDistribute", "[Parallel], [ParMesh]")
+{
+   // the empty name is a hexahedral mesh with interior boundary elements
+   auto mesh_fname = GENERATE("../../data/star-mixed.mesh",
+                              "../../data/fichera-mixed.mesh",
+                              "../../data/escher.mesh",
+                              "../../data/beam-wedge.mesh", "");
+   CAPTURE(mesh_fname);
+
+   // a serial binary mesh is partitioned while reading it
+   Mesh mesh = (*mesh_fname) ? Mesh::LoadFromFile(mesh_fname) :
+               DividingPlaneMesh(false, true, true);
+   mesh.UniformRefinement();
+   if (!*mesh_fname) { mesh.UniformRefinement(); }
+   const std::string fname = "binary_mesh_dist_test.mesh";
+   if (Mpi::Root()) { mesh.SaveBinary(fname); }
+   MPI_Barrier(MPI_COMM_WORLD);
+   ParMesh pmesh = ParMesh::LoadFromBinaryFile(MPI_COMM_WORLD, fname);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (Mpi::Root()) { std::remove(fname.c_str()); }
+
+   long long ne[2] = { pmesh.GetNE(), pmesh.GetNBE() };
+   MPI_Allreduce(MPI_IN_PLACE, ne, 2, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+   REQUIRE(ne[0] == mesh.GetNE());
+   REQUIRE(ne[1] == mesh.GetNBE());
+
+   int ne_min = pmesh.GetNE(), ne_max = pmesh.GetNE();
+   MPI_Allreduce(MPI_IN_PLACE, &ne_min, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+   MPI_Allreduce(MPI_IN_PLACE, &ne_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+   REQUIRE(ne_max - ne_min <= 1);
+
+   // the shared entities define the global numbering of the dofs
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   ParFiniteElementSpace pfes(&pmesh, &fec);
+   REQUIRE(pfes.GlobalTrueVSize() == fes.GetTrueVSize());
+
+   ConstantCoefficient one(1.0);
+   ParLinearForm b(&pfes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   ParGridFunction x(&pfes);
+   x = 1.0;
+   LinearForm b_serial(&fes);
+   b_serial.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b_serial.Assemble();
+   REQUIRE(b(x) == MFEM_Approx(b_serial.Sum()));
+}
+
+// Exposes the shared entity indices of ParMesh
+class ParMeshSharedIndices : public ParMesh
+{
+public:
+   using ParMesh::ParMesh;
+   using ParMesh::sedge_ledge;
+   using ParMesh::sface_lface;
+   using ParMesh::FinalizeParTopo;
+};
+
+TEST_CASE("ParMeshUniformRefinement", "[Parallel], [ParMesh]")
+{
+   auto mesh_fname = GENERATE("../../data/square-disc.mesh",
+                              "../../data/star-mixed.mesh",
+                              "../../data/beam-tet.mesh",
+                              "../../data/beam-hex.mesh",
+                              "../../data/beam-wedge.mesh",
+                              "../../data/fichera-mixed.mesh");
+   CAPTURE(mesh_fname);
+
+   Mesh mesh = Mesh::LoadFromFile(mesh_fname);
+   ParMeshSharedIndices pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(2, mesh.Dimension());
+   for (int r = 0; r < 2; r++)
+   {
+      mesh.UniformRefinement();
+      pmesh.UniformRefinement();
+
+      // the shared edges and faces are found without the tables of all local
+      // edges and faces, which FinalizeParTopo() uses
+      const Array<int> sedge_ledge(pmesh.sedge_ledge);
+      const Array<int> sface_lface(pmesh.sface_lface);
+      pmesh.FinalizeParTopo();
+      REQUIRE(sedge_ledge == pmesh.sedge_ledge);
+      REQUIRE(sface_lface == pmesh.sface_lface);
+
+      FiniteElementSpace fes(&mesh, &fec);
+      ParFiniteElementSpace pfes(&pmesh, &fec);
+      REQUIRE(pfes.GlobalTrueVSize() == fes.GetTrueVSize());
+   }
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem
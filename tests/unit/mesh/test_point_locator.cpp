@@ -0,0 +1,196 @@
+// Copyright (c) 2010-2025, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace
+{
+
+real_t RandomReal() { return rand() / real_t(RAND_MAX); }
+
+// Create 'n' points in random elements of 'mesh', at random reference
+// coordinates
+void RandomPoints(Mesh &mesh, int n, DenseMatrix &points)
+{
+   const int sdim = mesh.SpaceDimension();
+   points.SetSize(sdim, n);
+   Vector x;
+   for (int k = 0; k < n; k++)
+   {
+      const int e = rand() % mesh.GetNE();
+      IntegrationPoint ip;
+      ip.Set3(0.05 + 0.9*RandomReal(), 0.05 + 0.9*RandomReal(),
+              0.05 + 0.9*RandomReal());
+      if (mesh.GetElementBaseGeometry(e) == Geometry::TRIANGLE ||
+          mesh.GetElementBaseGeometry(e) == Geometry::TETRAHEDRON)
+      {
+         // scale into the simplex
+         const real_t s = ip.x + ip.y + (mesh.Dimension() == 3 ? ip.z : 0.0);
+         if (s > 0.95) { ip.x *= 0.9/s; ip.y *= 0.9/s; ip.z *= 0.9/s; }
+      }
+      points.GetColumnReference(k, x);
+      mesh.GetElementTransformation(e)->Transform(ip, x);
+   }
+}
+
+// Check that the points are found and that the reference coordinates map back
+// to the points
+void CheckPoints(Mesh &mesh, const DenseMatrix &points,
+                 const Array<int> &elem_ids,
+                 const Array<IntegrationPoint> &ips)
+{
+   Vector x;
+   for (int k = 0; k < points.Width(); k++)
+   {
+      REQUIRE(elem_ids[k] >= 0);
+      mesh.GetElementTransformation(elem_ids[k])->Transform(ips[k], x);
+      for (int d = 0; d < x.Size(); d++)
+      {
+         REQUIRE(x(d) == MFEM_Approx(points(d, k)));
+      }
+   }
+}
+
+void SinePerturbation(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(2*M_PI*x(1));
+   y(1) += 0.05*sin(2*M_PI*x(0));
+}
+
+}
+
+TEST_CASE("PointLocator", "[PointLocator]")
+{
+   const int dim = GENERATE(2, 3);
+   const bool simplex = GENERATE(false, true);
+   const int order = GENERATE(1, 3);
+   CAPTURE(dim, simplex, order);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(6, 5, simplex ? Element::TRIANGLE :
+                                     Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(4, 3, 3, simplex ? Element::TETRAHEDRON :
+                                     Element::HEXAHEDRON);
+   if (order > 1)
+   {
+      mesh.SetCurvature(order);
+      mesh.Transform(SinePerturbation);
+   }
+
+   PointLocator locator(mesh);
+
+   DenseMatrix points;
+   RandomPoints(mesh, 500, points);
+
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   REQUIRE(locator.FindPoints(points, elem_ids, ips) == points.Width());
+   CheckPoints(mesh, points, elem_ids, ips);
+
+   // points outside of the mesh are not found
+   Vector pt(dim);
+   IntegrationPoint ip;
+   pt = 1.5;
+   REQUIRE(locator.FindPoint(pt, ip) == -1);
+   pt = -0.5;
+   REQUIRE(locator.FindPoint(pt, ip) == -1);
+
+   // the hierarchy is rebuilt after refinement
+   mesh.UniformRefinement();
+   RandomPoints(mesh, 200, points);
+   REQUIRE(locator.FindPoints(points, elem_ids, ips) == points.Width());
+   CheckPoints(mesh, points, elem_ids, ips);
+}
+
+TEST_CASE("PointLocator agrees with Mesh::FindPoints", "[PointLocator]")
+{
+   Mesh mesh("../../data/star-q3.mesh");
+   mesh.UniformRefinement();
+
+   DenseMatrix points;
+   RandomPoints(mesh, 100, points);
+
+   Array<int> elem_ids, ref_ids;
+   Array<IntegrationPoint> ips, ref_ips;
+   PointLocator locator(mesh);
+   REQUIRE(locator.FindPoints(points, elem_ids, ips) == points.Width());
+   REQUIRE(mesh.FindPoints(points, ref_ids, ref_ips, false) == points.Width());
+   CheckPoints(mesh, points, elem_ids, ips);
+
+   // the points are inside of the elements, away from their faces, so both
+   // searches find the same elements and reference coordinates
+   for (int k = 0; k < points.Width(); k++)
+   {
+      REQUIRE(elem_ids[k] == ref_ids[k]);
+      REQUIRE(ips[k].x == MFEM_Approx(ref_ips[k].x));
+      REQUIRE(ips[k].y == MFEM_Approx(ref_ips[k].y));
+   }
+}
+
+TEST_CASE("PointLocator tracking", "[PointLocator]")
+{
+   const int dim = GENERATE(2, 3);
+   CAPTURE(dim);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(5, 5, 5, Element::TETRAHEDRON);
+
+   PointLocator locator(mesh);
+
+   DenseMatrix points;
+   RandomPoints(mesh, 200, points);
+
+   // the first call has no hints, all points require a global search
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   REQUIRE(locator.TrackPoints(points, elem_ids, ips) == points.Width());
+   CheckPoints(mesh, points, elem_ids, ips);
+   REQUIRE(locator.GetNumGlobalSearches() == points.Width());
+
+   // rotate the points about the center of the domain, by a fraction of the
+   // element size per step, and reflect the points that leave the domain
+   const real_t angle = 0.02;
+   Array<int> ref_ids;
+   Array<IntegrationPoint> ref_ips;
+   for (int step = 0; step < 10; step++)
+   {
+      for (int k = 0; k < points.Width(); k++)
+      {
+         const real_t x = points(0, k) - 0.5, y = points(1, k) - 0.5;
+         points(0, k) = 0.5 + cos(angle)*x - sin(angle)*y;
+         points(1, k) = 0.5 + sin(angle)*x + cos(angle)*y;
+         for (int d = 0; d < 2; d++)
+         {
+            if (points(d, k) < 0.01) { points(d, k) = 0.02 - points(d, k); }
+            if (points(d, k) > 0.99) { points(d, k) = 1.98 - points(d, k); }
+         }
+      }
+
+      REQUIRE(locator.TrackPoints(points, elem_ids, ips) == points.Width());
+      CheckPoints(mesh, points, elem_ids, ips);
+
+      REQUIRE(locator.FindPoints(points, ref_ids, ref_ips) == points.Width());
+      CheckPoints(mesh, points, ref_ids, ref_ips);
+   }
+
+   // the points moved to the neighbors, the walk finds (almost) all of them
+   REQUIRE(locator.GetNumGlobalSearches() <= 11*points.Width()/10);
+
+   // the hints are ignored after refinement
+   mesh.UniformRefinement();
+   REQUIRE(locator.TrackPoints(points, elem_ids, ips) == points.Width());
+   CheckPoints(mesh, points, elem_ids, ips);
+}